@@ -25,6 +25,9 @@ private:
     std::string access_log_path;
     std::ofstream access_log;
 
+    // written to by every http event loop
+    std::mutex access_log_mutex;
+
     AppMetrics() {
         current_counts = new spp::sparse_hash_map<std::string, uint64_t>();
         counts = new spp::sparse_hash_map<std::string, uint64_t>();
@@ -2,6 +2,7 @@
 
 #include <unordered_map>
 #include <deque>
+#include <functional>
 #include "store.h"
 #include "http_data.h"
 #include "threadpool.h"
@@ -20,17 +21,20 @@ private:
         uint32_t num_chunks;
         uint32_t next_chunk_index;   // index where next read must begin
         bool is_complete;           //  whether the req has been written to store fully
+        int64_t log_index;          // raft log index of the first chunk of the request
 
         req_res_t(uint64_t start_ts, const std::string& prev_req_body,
                   const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res,
-                  uint64_t last_updated, uint32_t num_chunks, uint32_t next_chunk_index, bool is_complete):
+                  uint64_t last_updated, uint32_t num_chunks, uint32_t next_chunk_index, bool is_complete,
+                  int64_t log_index = 0):
                 start_ts(start_ts), prev_req_body(prev_req_body), req(req), res(res), last_updated(last_updated),
-                num_chunks(num_chunks), next_chunk_index(next_chunk_index), is_complete(is_complete) {
+                num_chunks(num_chunks), next_chunk_index(next_chunk_index), is_complete(is_complete),
+                log_index(log_index) {
 
         }
 
         req_res_t(): req(nullptr), res(nullptr), last_updated(0), num_chunks(0),
-                     next_chunk_index(0), is_complete(false) {};
+                     next_chunk_index(0), is_complete(false), log_index(0) {};
     };
 
     struct await_t {
@@ -70,6 +74,24 @@ private:
 
     /* ------------------------------------------------------- */
 
+    // log index of the latest raft log entry handed to the indexer, guarded by `mutex`
+    int64_t last_applied_log_index = 0;
+
+    struct indexed_waiter_t {
+        std::chrono::steady_clock::time_point deadline;
+        std::function<void(bool)> callback;
+    };
+
+    // bounded staleness reads waiting on the indexed log index, keyed by the log index they wait on
+    std::mutex indexed_waiters_mutex;
+    std::multimap<int64_t, indexed_waiter_t> indexed_waiters;
+
+    // granularity at which the waits on the indexed log index are timed out
+    static const uint64_t INDEXED_WAIT_CHECK_MS = 100;
+
+    // calls back the waiters whose log index has been indexed
+    void notify_indexed();
+
     std::chrono::high_resolution_clock::time_point last_gc_run;
 
     std::atomic<bool> quit;
@@ -109,6 +131,21 @@ public:
 
     int64_t get_queued_writes();
 
+    // log index upto which all the enqueued writes have been indexed
+    int64_t get_indexed_log_index();
+
+    // Calls `callback` with true once the writes upto `log_index` have been indexed, or with false if `timeout_ms`
+    // elapses first. Does not block: the callback runs on the thread that indexes the write or times out the wait,
+    // so it must return quickly.
+    void on_indexed_log_index(int64_t log_index, uint64_t timeout_ms, const std::function<void(bool)>& callback);
+
+    // calls back the waits on the indexed log index whose timeout has elapsed
+    void expire_indexed_waits();
+
+    // raft log entries upto `log_index` have been handed to the indexer: either enqueued, loaded from a snapshot or
+    // without anything to index, like configuration entries
+    void set_applied_log_index(int64_t log_index);
+
     void run();
 
     void stop();
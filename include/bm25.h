@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <sparsepp.h>
+
+// Tracks the number of tokens indexed for a given field of every document, along with the running totals
+// needed for computing the average field length used in BM25 length normalization.
+class field_length_stats_t {
+private:
+    // seq_id => number of tokens in the field
+    spp::sparse_hash_map<uint32_t, uint32_t> doc_lengths;
+
+    uint64_t total_length = 0;
+
+public:
+    field_length_stats_t() = default;
+
+    field_length_stats_t(const field_length_stats_t& other) = delete;
+
+    void upsert(uint32_t seq_id, uint32_t length);
+
+    void remove(uint32_t seq_id);
+
+    uint32_t get_length(uint32_t seq_id) const;
+
+    size_t num_docs() const;
+
+    uint64_t get_total_length() const;
+
+    float avg_length() const;
+};
+
+struct bm25_t {
+    static constexpr float K1 = 1.2f;
+    static constexpr float B = 0.75f;
+
+    // BM25 scores are floats: they are scaled and truncated to fit into the integer text match score
+    static constexpr float SCORE_SCALE = 100000.0f;
+
+    // Robertson-Sparck Jones IDF, smoothed so that it never becomes negative for very common tokens
+    static float idf(size_t num_docs, size_t doc_freq);
+
+    // Term frequency of a token in a field, normalized by the field's length relative to the average length
+    static float normalized_tf(uint32_t tf, uint32_t field_len, float avg_field_len);
+
+    // Saturates the (weighted sum of) normalized term frequencies and multiplies it with the token's IDF
+    static float token_score(float idf, float weighted_tf);
+
+    // Integer score (56 bits) of a candidate that matched at least one field. Never 0, even when the IDF of the
+    // matched tokens is too small to survive the scaling, e.g. for tokens found in almost every document.
+    static int64_t scaled_score(float score);
+};
@@ -21,6 +21,7 @@
 #include "synonym_index.h"
 #include "vq_model_manager.h"
 #include "join.h"
+#include "reference_doc_cache.h"
 
 struct doc_seq_id_t {
     uint32_t seq_id;
@@ -83,6 +84,7 @@ struct collection_search_args_t {
     static constexpr auto FACET_STRATEGY = "facet_strategy";
 
     static constexpr auto FACET_RETURN_PARENT = "facet_return_parent";
+    static constexpr auto DISJUNCTIVE_FACETS = "disjunctive_facets";
 
     static constexpr auto VECTOR_QUERY = "vector_query";
 
@@ -243,6 +245,7 @@ struct collection_search_args_t {
     bool rerank_hybrid_matches;
     bool enable_analytics;
     bool validate_field_names;
+    std::vector<std::string> disjunctive_facets;
 
     std::vector<std::vector<KV*>> result_group_kvs{};
 
@@ -272,7 +275,8 @@ struct collection_search_args_t {
                              std::string override_tags, std::string voice_query, bool enable_typos_for_numerical_tokens,
                              bool enable_synonyms, bool synonym_prefix, size_t synonym_num_typos, bool enable_lazy_filter,
                              bool enable_typos_for_alpha_numerical_tokens, size_t max_filter_by_candidates,
-                             bool rerank_hybrid_matches, bool enable_analytics, bool validate_field_names) :
+                             bool rerank_hybrid_matches, bool enable_analytics, bool validate_field_names,
+                             std::vector<std::string> disjunctive_facets) :
             raw_query(std::move(raw_query)), search_fields(std::move(search_fields)), filter_query(std::move(filter_query)),
             facet_fields(std::move(facet_fields)), sort_fields(std::move(sort_fields)),
             num_typos(std::move(num_typos)), per_page(per_page), page(page), token_order(token_order),
@@ -299,7 +303,8 @@ struct collection_search_args_t {
             override_tags(std::move(override_tags)), voice_query(std::move(voice_query)), enable_typos_for_numerical_tokens(enable_typos_for_numerical_tokens),
             enable_synonyms(enable_synonyms), synonym_prefix(synonym_prefix), synonym_num_typos(synonym_num_typos), enable_lazy_filter(enable_lazy_filter),
             enable_typos_for_alpha_numerical_tokens(enable_typos_for_alpha_numerical_tokens), max_filter_by_candidates(max_filter_by_candidates),
-            rerank_hybrid_matches(rerank_hybrid_matches), enable_analytics(enable_analytics), validate_field_names(validate_field_names) {}
+            rerank_hybrid_matches(rerank_hybrid_matches), enable_analytics(enable_analytics), validate_field_names(validate_field_names),
+            disjunctive_facets(std::move(disjunctive_facets)) {}
 
     collection_search_args_t() = default;
 
@@ -409,6 +414,9 @@ private:
     /// "field name" -> List of <collection, field> pairs where this collection is referenced and is marked as `async`.
     spp::sparse_hash_map<std::string, std::set<reference_pair_t>> async_referenced_ins;
 
+    /// Pruned documents of this collection that were included in the hits of the collections referencing it.
+    ReferenceDocCache reference_doc_cache;
+
     /// Reference helper fields that are part of an object. The reference doc of these fields will be included in the
     /// object rather than in the document.
     tsl::htrie_set<char> object_reference_helper_fields;
@@ -432,6 +440,9 @@ private:
 
     std::string get_seq_id_key(uint32_t seq_id) const;
 
+    Option<bool> parse_stored_document(const std::string& json_doc_str, const std::string& seq_id_key,
+                                       nlohmann::json& document, bool raw_doc) const;
+
     static bool handle_highlight_text(std::string& text, const bool& normalise, const field& search_field,
                                       const bool& is_arr_obj_ele,
                                       const std::vector<char>& symbols_to_index, const std::vector<char>& token_separators,
@@ -761,6 +772,16 @@ public:
                                 const DIRTY_VALUES dirty_values,
                                 const std::string& id="");
 
+    // validates the `id` of an already parsed document and resolves its sequence ID
+    Option<doc_seq_id_t> get_doc_seq_id(nlohmann::json& document, const index_operation_t& operation,
+                                        const std::string& id="");
+
+    static Option<bool> parse_doc(const std::string& json_str, nlohmann::json& document);
+
+    // parses json_lines[begin, end) on the thread pool into `parsed_docs`, along with the outcome of each parse
+    static void parse_json_lines(const std::vector<std::string>& json_lines, size_t begin, size_t end,
+                                 std::vector<nlohmann::json>& parsed_docs, std::vector<Option<bool>>& parse_ops);
+
 
     static uint32_t get_seq_id_from_key(const std::string & key);
 
@@ -768,6 +789,15 @@ public:
 
     Option<bool> get_document_from_store(const uint32_t& seq_id, nlohmann::json & document, bool raw_doc = false) const;
 
+    // fetches the stored JSON of a document without parsing it
+    Option<bool> get_document_json_from_store(const uint32_t& seq_id, std::string& json_doc) const;
+
+    // fetches the documents in a single batch from the store, fails on the first document that can't be fetched
+    Option<bool> get_documents_from_store(const std::vector<uint32_t>& seq_ids, std::vector<nlohmann::json>& documents,
+                                          bool raw_doc = false) const;
+
+    ReferenceDocCache& get_reference_doc_cache();
+
     Option<uint32_t> index_in_memory(nlohmann::json & document, uint32_t seq_id,
                                      const index_operation_t op, const DIRTY_VALUES& dirty_values);
 
@@ -786,7 +816,8 @@ public:
                                   size_t depth = 0,
                                   const std::map<std::string, reference_filter_result_t>& reference_filter_results = {},
                                   Collection *const collection = nullptr, const uint32_t& seq_id = 0,
-                                  const std::vector<ref_include_exclude_fields>& ref_include_exclude_fields_vec = {});
+                                  const std::vector<ref_include_exclude_fields>& ref_include_exclude_fields_vec = {},
+                                  request_ref_docs_t* const request_ref_docs = nullptr);
 
     const Index* _get_index() const;
 
@@ -918,7 +949,8 @@ public:
                                   const size_t& max_filter_by_candidates = DEFAULT_FILTER_BY_CANDIDATES,
                                   bool rerank_hybrid_matches = false,
                                   bool validate_field_names = true,
-                                  bool enable_analytics = true) const;
+                                  bool enable_analytics = true,
+                                  const std::vector<std::string>& disjunctive_facets = {}) const;
 
     static Option<bool> do_union(const std::vector<uint32_t>& collection_ids,
                                  std::vector<collection_search_args_t>& searches, std::vector<long>& searchTimeMillis,
@@ -927,6 +959,8 @@ public:
     Option<bool> get_filter_ids(const std::string & filter_query, filter_result_t& filter_result,
                                 const bool& should_timeout = true, const bool& validate_field_names = true) const;
 
+    Option<bool> get_approx_filter_ids_length(const std::string& filter_query, uint32_t& approx_filter_ids_length) const;
+
     Option<bool> get_reference_filter_ids(const std::string& filter_query,
                                           filter_result_t& filter_result,
                                           const std::string& reference_field_name,
@@ -57,6 +57,9 @@ private:
     Store *store;
     ThreadPool* thread_pool;
 
+    // runs the searches of a multi search concurrently: see `run_searches_concurrently()`
+    ThreadPool* search_thread_pool = nullptr;
+
     AuthManager auth_manager;
 
     spp::sparse_hash_map<std::string, Collection*> collections;
@@ -94,6 +97,13 @@ private:
         return "";
     }
 
+    Option<bool> load_collections(Store* source_store, const StoreStatus& next_coll_id_status,
+                                  const size_t collection_batch_size, const size_t document_batch_size,
+                                  std::vector<Collection*>* built_collections);
+
+    // replaces all the in-memory collections with the given ones
+    void install_collections(std::vector<Collection*>& built_collections);
+
 public:
     static constexpr const size_t DEFAULT_NUM_MEMORY_SHARDS = 4;
 
@@ -123,7 +133,9 @@ public:
                                         const StoreStatus& next_coll_id_status,
                                         const std::atomic<bool>& quit,
                                         spp::sparse_hash_map<std::string, std::string>& referenced_in,
-                                        spp::sparse_hash_map<std::string, std::set<reference_pair_t>>& async_referenced_ins);
+                                        spp::sparse_hash_map<std::string, std::set<reference_pair_t>>& async_referenced_ins,
+                                        Store* source_store = nullptr,
+                                        Collection** built_collection = nullptr);
 
     Option<Collection*> clone_collection(const std::string& existing_name, const nlohmann::json& req_json);
 
@@ -146,7 +158,14 @@ public:
     void init(Store *store, const float max_memory_ratio, const std::string & auth_key, std::atomic<bool>& exit,
               const uint16_t& filter_by_max_operations = Config::FILTER_BY_DEFAULT_OPERATIONS);
 
-    Option<bool> load(const size_t collection_batch_size, const size_t document_batch_size);
+    Option<bool> load(const size_t collection_batch_size, const size_t document_batch_size,
+                      std::vector<Collection*>* built_collections = nullptr);
+
+    // Builds the collections found in `source_store` without making them visible, so that the current collections
+    // can continue to serve reads meanwhile. The built collections are bound to the main store: it must hold the
+    // same data as `source_store` by the time they are swapped in via `load()`.
+    Option<bool> build_collections(Store* source_store, const size_t collection_batch_size,
+                                   const size_t document_batch_size, std::vector<Collection*>& built_collections);
 
     // frees in-memory data structures when server is shutdown - helps us run a memory leak detector properly
     void dispose();
@@ -190,8 +209,19 @@ public:
 
     ThreadPool* get_thread_pool() const;
 
+    void set_search_thread_pool(ThreadPool* search_thread_pool);
+
+    // Calls `run_search` for each index in [0, num_searches) concurrently on the search thread pool, and returns once
+    // all of them are done. The calling thread runs searches too, so progress is guaranteed even when the pool is
+    // exhausted. Without a search thread pool the searches run one by one.
+    void run_searches_concurrently(size_t num_searches, const std::function<void(size_t)>& run_search) const;
+
     AuthManager& getAuthManager();
 
+    // Merges the params embedded in a scoped API key into the params of a search, overriding them.
+    static Option<bool> apply_embedded_params(nlohmann::json& embedded_params,
+                                              std::map<std::string, std::string>& req_params);
+
     static Option<bool> do_search(std::map<std::string, std::string>& req_params,
                                   nlohmann::json& embedded_params,
                                   std::string& results_json_str,
@@ -42,5 +42,13 @@ struct export_state_t: public req_state_t {
 
 Option<bool> stateful_remove_docs(deletion_state_t* deletion_state, size_t batch_size, bool& done);
 Option<bool> stateful_export_docs(export_state_t* export_state, size_t batch_size, bool& done);
+
+// Appends the stored JSON of the given documents to the body as newline terminated lines, in the same order.
+// Documents whose JSON is empty are fetched from the store, and missing ones are skipped. Large batches are
+// fetched and pruned in parallel. `references` is either null or holds the reference results of every document.
+Option<bool> append_export_docs(export_state_t* export_state, const std::vector<uint32_t>& seq_ids,
+                                std::vector<std::string>& json_docs,
+                                const std::map<std::string, reference_filter_result_t>* references,
+                                std::string& body);
 Option<bool> multi_search_validate_and_add_params(std::map<std::string, std::string>& req_params,
                                                   nlohmann::json& search_params, const bool& is_conversation);
\ No newline at end of file
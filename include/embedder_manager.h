@@ -45,6 +45,11 @@ public:
     Option<TextEmbedder*> get_text_embedder(const nlohmann::json& model_config);
     Option<ImageEmbedder*> get_image_embedder(const nlohmann::json& model_config);
 
+    // Embeds a search query with the model's query prefix. Embeddings are looked up in and added to the query
+    // embedding cache.
+    embedding_res_t embed_query(TextEmbedder* embedder, const nlohmann::json& model_config, const std::string& query,
+                                const size_t remote_embedding_timeout_ms, const size_t remote_embedding_num_tries);
+
     void delete_text_embedder(const std::string& model_path);
     void delete_all_text_embedders();
 
@@ -56,12 +61,15 @@ public:
     const std::string get_query_prefix(const nlohmann::json& model_config);
     static void set_model_dir(const std::string& dir);
     static const std::string& get_model_dir();
+    static void set_model_concurrency(size_t concurrency);
+    static size_t get_model_concurrency();
 
     ~EmbedderManager();
 
     inline static const std::string MODELS_REPO_URL = "https://models.typesense.org/public/";
     inline static const std::string MODEL_CONFIG_FILE = "config.json";
     inline static std::string model_dir = "";
+    inline static size_t model_concurrency = 1;
 
     static const std::string get_absolute_model_path(const std::string& model_name, const bool is_public);
     static const std::string get_absolute_vocab_path(const std::string& model_name, const std::string& vocab_file_name, const bool is_public);
@@ -6,7 +6,22 @@
 #include <posting_list.h>
 #include <num_tree.h>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <field.h>
+#include "lru/lru.hpp"
+
+// Number of documents having each facet value, materialized for a given `filter_by` clause
+struct facet_counts_t {
+    // facet_id => count
+    spp::sparse_hash_map<uint32_t, uint32_t> counts;
+
+    // size of the result set the counts were computed from
+    size_t num_docs = 0;
+
+    // write version of the facet index at the time the counts were computed
+    uint64_t write_version = 0;
+};
 
 struct facet_value_id_t {
     std::string facet_value;
@@ -37,6 +52,9 @@ struct facet_value_id_t {
 struct docid_count_t {
     uint32_t doc_id;
     uint32_t count;
+    // confidence interval of an estimated count
+    uint32_t count_lower = 0;
+    uint32_t count_upper = 0;
 };
 
 class facet_index_t {
@@ -70,6 +88,27 @@ public:
 
     const static size_t MAX_FACET_VAL_LEN = 255;
 
+    // number of seq ids sampled per facet value for estimating facet counts
+    static constexpr size_t SKETCH_SIZE = 256;
+
+    // upper bound on the number of facet values examined by a single estimation
+    static constexpr size_t SKETCH_MAX_VALUES = 10000;
+
+    // Bottom-k sample of the seq ids of a facet value: holds every id of the value whose hash is at most
+    // `max_hash`, and at most `SKETCH_SIZE` of them. Ids are admitted against the threshold instead of the largest
+    // hash held, so that the sample stays uniform after removals have left it with fewer than `SKETCH_SIZE` ids.
+    struct facet_sketch_t {
+        // max-heap on the hash of the ids
+        std::vector<uint32_t> ids;
+        uint32_t max_hash = UINT32_MAX;
+    };
+
+    static uint32_t sketch_hash(uint32_t seq_id);
+
+    static void add_to_sketch(facet_sketch_t& sketch, uint32_t seq_id);
+
+    static void remove_from_sketch(facet_sketch_t& sketch, uint32_t seq_id);
+
 private:
     struct facet_id_seq_ids_t {
         void* seq_ids;
@@ -95,6 +134,17 @@ private:
         bool has_value_index = true;
         bool has_hash_index = true;
 
+        // bounds of the facet ids stored in `seq_id_hashes` (never shrinks on removal)
+        uint32_t min_facet_id = UINT32_MAX;
+        uint32_t max_facet_id = 0;
+
+        // counts across all documents: materialized on first use and then maintained on insert and remove
+        std::shared_ptr<facet_counts_t> unfiltered_counts;
+
+        // facet_id => bottom-k sketch of the seq ids having the value, only for values having more than
+        // `SKETCH_SIZE` documents, since the ids of smaller values are intersected exactly
+        spp::sparse_hash_map<uint32_t, facet_sketch_t> fid_sketches;
+
         facet_doc_ids_list_t() {
             fvalue_seq_ids.clear();
             counts.clear();
@@ -122,6 +172,25 @@ private:
     // auto incrementing ID that is assigned to each unique facet value string
     std::atomic_uint32_t next_facet_id = 0;
 
+    static constexpr size_t FILTERED_FACET_COUNTS_CACHE_SIZE = 256;
+
+    // guards the materialized facet counts, since they are populated by concurrent searches
+    std::mutex facet_counts_mutex;
+
+    // field + filter_by => counts, valid only as long as no document has been written since
+    LRU::Cache<std::string, std::shared_ptr<const facet_counts_t>> filtered_facet_counts{FILTERED_FACET_COUNTS_CACHE_SIZE};
+
+    std::atomic_uint64_t write_version = 0;
+
+    static void get_facet_ids(posting_list_t* fhash_index, uint32_t seq_id, std::vector<uint32_t>& facet_ids);
+
+    static void build_sketch(void*& ids, facet_sketch_t& sketch);
+
+    static void update_sketch(facet_doc_ids_list_t& facet_index, uint32_t facet_id, void*& ids,
+                              uint32_t seq_id, bool is_insert);
+
+    static void update_facet_counts(facet_counts_t& fcounts, const std::vector<uint32_t>& facet_ids, int delta);
+
     void get_stringified_value(const nlohmann::json& value, const field& afield,
                                std::vector<std::string>& values);
 
@@ -159,6 +228,16 @@ public:
                      size_t max_facet_count, std::map<std::string, docid_count_t>& found,
                      bool is_wildcard_no_filter_query, const std::string& sort_order = "");
     
+    // Estimates the counts of the top facet values within the result ids from the sketches of the values,
+    // along with their 95% confidence intervals. Requires the value index.
+    size_t estimate(const facet& a_facet, const uint32_t* result_ids, size_t result_ids_len,
+                    size_t max_facet_count, std::map<std::string, docid_count_t>& found,
+                    bool is_wildcard_no_filter_query);
+
+    // Scales the hits of a uniform sample of `sample_size` out of `population` ids to an estimated count
+    static void estimate_count(size_t sample_hits, size_t sample_size, size_t population,
+                               uint32_t& count, uint32_t& count_lower, uint32_t& count_upper);
+
     size_t get_facet_indexes(const std::string& field, 
         std::map<uint32_t, std::vector<uint32_t>>& seqid_countIndexes);
     
@@ -175,6 +254,21 @@ public:
 
     posting_list_t* get_facet_hash_index(const std::string& field_name);
 
+    // returns false when the field has no facet ids indexed
+    bool get_facet_id_range(const std::string& field_name, uint32_t& min_facet_id, uint32_t& max_facet_id);
+
+    // Returns the materialized counts of a field for the given `filter_by` clause (empty for all documents),
+    // or nullptr when they have to be computed.
+    std::shared_ptr<const facet_counts_t> get_facet_counts(const std::string& field_name,
+                                                           const std::string& filter_query, size_t num_docs);
+
+    void set_facet_counts(const std::string& field_name, const std::string& filter_query,
+                          std::shared_ptr<facet_counts_t> fcounts);
+
+    // Counts of filtered views can't be maintained incrementally since a write can change whether a
+    // document matches the filter: they are discarded on every write instead.
+    void invalidate_filtered_facet_counts();
+
     //get fhash=>int64 map for stats
     const spp::sparse_hash_map<uint32_t, int64_t>& get_fhash_int64_map(const std::string& field_name);
 
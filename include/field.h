@@ -60,6 +60,8 @@ namespace fields {
     static const std::string nested_array = "nested_array";
     static const std::string num_dim = "num_dim";
     static const std::string vec_dist = "vec_dist";
+    static const std::string multi_vector = "multi_vector";
+    static const std::string bm25 = "bm25";
     static const std::string reference = "reference";
     static const std::string async_reference = "async_reference";
     static const std::string embed = "embed";
@@ -130,6 +132,9 @@ struct field {
     nlohmann::json embed;
     vector_distance_type_t vec_dist;
 
+    // the value of a document is an array of vectors, e.g. one per passage, and it's scored by MaxSim
+    bool multi_vector = false;
+
     static constexpr int VAL_UNKNOWN = 2;
 
     std::string reference;      // Foo.bar (reference to bar field in Foo collection).
@@ -141,6 +146,9 @@ struct field {
 
     bool stem = false;
     std::string stem_dictionary = "";
+
+    // per document token counts of the field are tracked for BM25 length normalization
+    bool bm25 = false;
     std::shared_ptr<Stemmer> stemmer;
   
     nlohmann::json hnsw_params;
@@ -712,6 +720,9 @@ struct facet_count_t {
     uint32_t array_pos = 0;
     //for sorting based on other field
     int64_t sort_field_val;
+    // confidence interval of an estimated count
+    uint32_t count_lower = 0;
+    uint32_t count_upper = 0;
 };
 
 struct facet_stats_t {
@@ -751,6 +762,9 @@ struct facet {
 
     bool sampled = false;
 
+    // counts are estimates with confidence intervals
+    bool is_sketched = false;
+
     bool is_wildcard_match = false;
     
     bool is_intersected = false;
@@ -765,6 +779,12 @@ struct facet {
 
     bool is_top_k = false;
 
+    // Number of distinct values counted, when only the top values are materialized in `result_map`.
+    size_t num_distinct_values = 0;
+
+    // counted against the results of the filter without the clauses on this field
+    bool is_disjunctive = false;
+
     bool get_range(int64_t key, std::pair<int64_t, std::string>& range_pair) {
         if(facet_range_map.empty()) {
             LOG (ERROR) << "Facet range is not defined!!!";
@@ -801,6 +821,16 @@ struct facet_info_t {
     bool use_facet_query = false;
     bool should_compute_stats = false;
     bool use_value_index = false;
+    // count into a flat array indexed by facet id instead of hashing every value
+    bool use_dense_counts = false;
+    // serve counts materialized for the `filter_by` clause of a wildcard query
+    bool use_facet_counts_cache = false;
+    std::string facet_counts_filter;
+    // estimate counts from the sketches of the value index
+    bool use_sketch = false;
+    // sorted ids of the curated hits, whose values are counted afterwards: their values must be kept even when they
+    // are not among the top values of the results
+    std::vector<uint32_t> curated_ids;
     field facet_field{"", "", false};
 };
 
@@ -815,6 +845,8 @@ struct facet_value_t {
     uint32_t count;
     int64_t sort_field_val;
     nlohmann::json parent;
+    uint32_t count_lower = 0;
+    uint32_t count_upper = 0;
 };
 
 struct facet_hash_values_t {
@@ -130,4 +130,13 @@ struct filter_node_t {
     bool is_match_all_ids_filter() const {
         return !isOperator && filter_exp.field_name == "id" && !filter_exp.values.empty() &&  filter_exp.values[0] == "*";
     }
+
+    bool has_reference_filter() const {
+        if(isOperator) {
+            return (left != nullptr && left->has_reference_filter()) ||
+                   (right != nullptr && right->has_reference_filter());
+        }
+
+        return !filter_exp.referenced_collection_name.empty();
+    }
 };
@@ -153,6 +153,14 @@ struct filter_result_t {
     // Collection name -> Reference filter result
     std::map<std::string, reference_filter_result_t>* coll_to_references = nullptr;
 
+    // References of a join to a single collection are kept flat until they are read, instead of in
+    // `coll_to_references`: the references of `docs[i]` are `reference_docs[reference_offsets[i]]` up to
+    // `reference_docs[reference_offsets[i + 1]]`.
+    std::string reference_collection_name;
+    bool is_reference_array_field = false;
+    std::vector<uint32_t> reference_offsets;
+    std::vector<uint32_t> reference_docs;
+
     filter_result_t() = default;
 
     filter_result_t(uint32_t count, uint32_t* docs) : count(count), docs(docs) {}
@@ -176,6 +184,7 @@ struct filter_result_t {
 
         delete[] docs;
         delete[] coll_to_references;
+        coll_to_references = nullptr;
 
         count = obj.count;
         docs = new uint32_t[count];
@@ -197,11 +206,17 @@ struct filter_result_t {
         count = obj.count;
         docs = obj.docs;
         coll_to_references = obj.coll_to_references;
+        reference_collection_name = std::move(obj.reference_collection_name);
+        is_reference_array_field = obj.is_reference_array_field;
+        reference_offsets = std::move(obj.reference_offsets);
+        reference_docs = std::move(obj.reference_docs);
 
         // Set default values in obj.
         obj.count = 0;
         obj.docs = nullptr;
         obj.coll_to_references = nullptr;
+        obj.reference_offsets.clear();
+        obj.reference_docs.clear();
 
         return *this;
     }
@@ -211,6 +226,20 @@ struct filter_result_t {
         delete[] coll_to_references;
     }
 
+    bool has_references() const {
+        return coll_to_references != nullptr || !reference_offsets.empty();
+    }
+
+    /// Adds the references of `docs[index]` into `references`.
+    void get_references(uint32_t index, std::map<std::string, reference_filter_result_t>& references) const;
+
+    /// Same as `get_references` but moves the references out, when they are not kept flat.
+    void move_references(uint32_t index, std::map<std::string, reference_filter_result_t>& references);
+
+    /// Appends the references that `from` keeps flat for `from.docs[index]` as the references of the next doc of
+    /// this result.
+    void append_references(const filter_result_t& from, uint32_t index);
+
     static void and_filter_results(const filter_result_t& a, const filter_result_t& b, filter_result_t& result);
 
     static void or_filter_results(const filter_result_t& a, const filter_result_t& b, filter_result_t& result);
@@ -249,6 +249,8 @@ public:
     }
 };
 
+struct http_message_dispatcher;
+
 struct http_req {
     static constexpr const char* AUTH_HEADER = "x-typesense-api-key";
     static constexpr const char* USER_HEADER = "x-typesense-user-id";
@@ -302,6 +304,9 @@ struct http_req {
 
     bool is_binary_body = false;
 
+    // dispatcher of the event loop that owns the connection, since h2o objects must only be touched from that loop
+    http_message_dispatcher* message_dispatcher = nullptr;
+
     http_req(): _req(nullptr), route_hash(1),
                 first_chunk_aggregate(true), last_chunk_aggregate(false),
                 chunk_len(0), body_index(0), data(nullptr), ready(false), log_index(0),
@@ -12,6 +12,7 @@ extern "C" {
 #include <map>
 #include <string>
 #include <cstdio>
+#include <thread>
 #include "http_data.h"
 #include "option.h"
 #include "threadpool.h"
@@ -66,9 +67,12 @@ public:
     // used to manage lifecycle of async actions
     const bool destroy_after_use;
 
+    http_message_dispatcher* const message_dispatcher;
+
     async_req_res_t(const std::shared_ptr<http_req>& h_req, const std::shared_ptr<http_res>& h_res,
                     const bool destroy_after_use) :
-            req(h_req), res(h_res), destroy_after_use(destroy_after_use) {
+            req(h_req), res(h_res), destroy_after_use(destroy_after_use),
+            message_dispatcher(h_req->message_dispatcher) {
 
         std::shared_lock lk(res->mres);
 
@@ -162,6 +166,26 @@ private:
 
     ThreadPool* meta_thread_pool;
 
+    // Event loops in addition to the primary one, each accepting connections on its own `SO_REUSEPORT` listener
+    // of the same port. Timers and the server wide message dispatcher stay on the primary loop.
+    struct event_loop_t {
+        HttpServer* server;
+        h2o_context_t ctx;
+        h2o_accept_ctx_t accept_ctx;
+        h2o_socket_t* listener_socket = nullptr;
+        http_message_dispatcher* message_dispatcher = nullptr;
+        std::thread thread;
+    };
+
+    std::vector<event_loop_t*> event_loops;
+
+    // current SSL context, since the accept contexts of other event loops can't read the primary one
+    std::atomic<SSL_CTX*> ssl_ctx;
+
+    // dispatcher and loop of the event loop running on the current thread
+    static thread_local http_message_dispatcher* loop_message_dispatcher;
+    static thread_local h2o_loop_t* current_loop;
+
     bool (*auth_handler)(std::map<std::string, std::string>& params,
                          std::vector<nlohmann::json>& embedded_params_vec,
                          const std::string& body, const route_path& rpath,
@@ -169,6 +193,14 @@ private:
 
     static void on_accept(h2o_socket_t *listener, const char *err);
 
+    static void on_event_loop_accept(h2o_socket_t *listener, const char *err);
+
+    void run_event_loop(event_loop_t* event_loop);
+
+    int bind_listener_socket();
+
+    static bool forward_to_owner_loop(const char* message_type, http_message_dispatcher* owner_dispatcher, void* data);
+
     int setup_ssl(const char *cert_file, const char *key_file);
 
     static bool initialize_ssl_ctx(const char *cert_file, const char *key_file, h2o_accept_ctx_t* accept_ctx);
@@ -208,12 +240,15 @@ public:
                const std::string & ssl_cert_key_path,
                const uint64_t ssl_refresh_interval_ms,
                bool cors_enabled, const std::set<std::string>& cors_domains,
-               ThreadPool* thread_pool);
+               ThreadPool* thread_pool, size_t num_event_loops = 1);
 
     ~HttpServer();
 
     http_message_dispatcher* get_message_dispatcher() const;
 
+    // dispatcher of the event loop that owns the connection of the request
+    http_message_dispatcher* get_message_dispatcher(const std::shared_ptr<http_req>& req) const;
+
     ReplicationState* get_replication_state() const;
 
     bool is_alive() const;
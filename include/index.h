@@ -34,6 +34,7 @@
 #include "facet_index.h"
 #include "numeric_range_trie.h"
 #include "geopolygon_index.h"
+#include "bm25.h"
 
 
 static constexpr size_t ARRAY_FACET_DIM = 4;
@@ -107,7 +108,8 @@ struct search_field_t {
 enum text_match_type_t {
     max_score,
     sum_score,
-    max_weight
+    max_weight,
+    bm25
 };
 
 enum drop_tokens_mode_t {
@@ -131,6 +133,8 @@ enum facet_index_type_t {
     exhaustive,
     top_values,
     automatic,
+    // estimate counts of the top values from per value samples of their documents
+    sketch,
 };
 
 struct search_args {
@@ -318,6 +322,10 @@ class VectorFilterFunctor: public hnswlib::BaseFilterFunctor {
     const uint32_t* excluded_ids = nullptr;
     const uint32_t excluded_ids_length = 0;
 
+    // filter ids less the excluded ids, once materialized
+    std::vector<uint64_t> filter_ids_bitmap;
+    bool use_filter_ids_bitmap = false;
+
 public:
 
     explicit VectorFilterFunctor(filter_result_iterator_t* const filter_result_iterator,
@@ -325,7 +333,16 @@ public:
                                 filter_result_iterator(filter_result_iterator),
                                 excluded_ids(excluded_ids), excluded_ids_length(excluded_ids_length) {}
 
+    /// Materializes the filter as a bitmap, so that a graph search checks each id it visits in O(1) instead of
+    /// resetting and advancing the filter iterator to it.
+    void compute_filter_ids_bitmap();
+
     bool operator()(hnswlib::labeltype id) override {
+        if (use_filter_ids_bitmap) {
+            const size_t word_index = id >> 6;
+            return word_index < filter_ids_bitmap.size() && ((filter_ids_bitmap[word_index] >> (id & 63)) & 1);
+        }
+
         if (filter_result_iterator->approx_filter_ids_length == 0 && excluded_ids_length == 0) {
             return true;
         }
@@ -349,13 +366,25 @@ struct hnsw_index_t {
     size_t num_dim;
     vector_distance_type_t distance_type;
 
+    // max number of neighbours of a node
+    size_t M;
+
+    // A multi-vector field indexes every vector of a document under its own label (see `get_label()`), and the
+    // distance of a document is computed over all its vectors.
+    bool multi_vector;
+
+    // seq_id => number of vectors of the document, for a multi-vector field
+    spp::sparse_hash_map<uint32_t, uint32_t> num_doc_vectors;
+    std::shared_mutex num_doc_vectors_m;
+
     // ensures that this index is not dropped when it's being repaired
     std::mutex repair_m;
 
-    hnsw_index_t(size_t num_dim, size_t init_size, vector_distance_type_t distance_type, size_t M = 16, size_t ef_construction = 200) :
+    hnsw_index_t(size_t num_dim, size_t init_size, vector_distance_type_t distance_type, size_t M = 16,
+                 size_t ef_construction = 200, bool multi_vector = false) :
         space(new hnswlib::InnerProductSpace(num_dim)),
         vecdex(new hnswlib::HierarchicalNSW<float>(space, init_size, M, ef_construction, 100, true)),
-        num_dim(num_dim), distance_type(distance_type) {
+        num_dim(num_dim), distance_type(distance_type), M(M), multi_vector(multi_vector) {
 
     }
 
@@ -376,6 +405,45 @@ struct hnsw_index_t {
             norm_dest[i] = src[i] * norm;
         }
     }
+
+    static size_t get_label(uint32_t seq_id, uint32_t vector_index) {
+        return (size_t(seq_id) << 32) | vector_index;
+    }
+
+    static uint32_t get_seq_id(size_t label) {
+        return label >> 32;
+    }
+
+    uint32_t get_num_doc_vectors(uint32_t seq_id) {
+        std::shared_lock lock(num_doc_vectors_m);
+        auto it = num_doc_vectors.find(seq_id);
+        return it == num_doc_vectors.end() ? 0 : it->second;
+    }
+
+    // Number of documents with vectors, which is the number of vectors unless this is a multi-vector field.
+    size_t get_num_docs() {
+        if (!multi_vector) {
+            return vecdex->getCurrentElementCount();
+        }
+
+        std::shared_lock lock(num_doc_vectors_m);
+        return num_doc_vectors.size();
+    }
+};
+
+// Token and field statistics required for scoring a candidate with BM25F
+struct bm25_stats_t {
+    // IDF of each token, in the same order as the token iterators that are scored
+    std::vector<float> token_idfs;
+
+    // field id => length statistics of that field (null when the field has no `bm25` property)
+    std::vector<const field_length_stats_t*> field_lengths;
+
+    // field id => average length of that field
+    std::vector<float> avg_field_lengths;
+
+    // field id => whether the field is an array
+    std::vector<bool> field_is_arrays;
 };
 
 struct group_by_field_it_t {
@@ -425,6 +493,9 @@ private:
 
     spp::sparse_hash_map<std::string, art_tree*> search_index;
 
+    // string field => per document token counts (used for BM25 length normalization)
+    spp::sparse_hash_map<std::string, field_length_stats_t*> field_length_index;
+
     spp::sparse_hash_map<std::string, num_tree_t*> numerical_index;
 
     // reference_helper_field => (seq_id => ref_seq_ids)
@@ -506,6 +577,27 @@ private:
                    int max_facet_count, bool is_wildcard_query,
                    const std::vector<facet_index_type_t>& facet_index_types) const;
 
+    bool use_dense_facet_counts(const facet& a_facet, const field& facet_field, size_t group_limit,
+                                size_t results_size) const;
+
+    bool count_dense_facet_ids(const field& facet_field, const uint32_t* result_ids, size_t results_size,
+                               bool estimate_facets, size_t facet_sample_mod_value,
+                               uint32_t& min_facet_id, std::vector<uint32_t>& counts,
+                               std::vector<uint32_t>& last_doc_ids) const;
+
+    void do_dense_facet_counts(facet& a_facet, const facet_info_t& facet_info,
+                               const uint32_t* result_ids, size_t results_size,
+                               bool estimate_facets, size_t facet_sample_mod_value,
+                               size_t max_facet_count) const;
+
+    bool use_facet_counts_cache(const facet& a_facet, const facet_info_t& facet_info) const;
+
+    void do_cached_facet_counts(facet& a_facet, const facet_info_t& facet_info,
+                                const uint32_t* result_ids, size_t results_size,
+                                size_t max_facet_count) const;
+
+    void compute_facet_hash_stats(facet& a_facet, const field& facet_field, uint32_t fhash, size_t count) const;
+
     bool static_filter_query_eval(const override_t* override, std::vector<std::string>& tokens,
                                   std::unique_ptr<filter_node_t>& filter_tree_root, const bool& validate_field_names) const;
 
@@ -525,6 +617,12 @@ private:
 
     static void aggregate_topster(Topster<KV>* agg_topster, Topster<KV>* index_topster);
 
+    // Aggregates the groups of per-thread topsters concurrently: each thread owns a hash partition of the group
+    // keys, so partitions need no locking and their groups are then handed over to `agg_topster` without copying.
+    void aggregate_group_topsters(Topster<KV>* agg_topster, Topster<KV>** topsters, size_t num_topsters,
+                                  spp::sparse_hash_map<uint64_t, uint64_t>* tgroups_processed,
+                                  spp::sparse_hash_map<uint64_t, uint32_t>& groups_processed) const;
+
     Option<bool> search_all_candidates(const size_t num_search_fields,
                                        const text_match_type_t match_type,
                                        const std::vector<search_field_t>& the_fields,
@@ -589,7 +687,8 @@ private:
     static void compute_facet_stats(facet &a_facet, const std::string& raw_value,
                                     const std::string & field_type, const size_t count);
 
-    static void compute_facet_stats(facet &a_facet, const int64_t raw_value, const std::string & field_type);
+    static void compute_facet_stats(facet &a_facet, const int64_t raw_value, const std::string & field_type,
+                                    const size_t count = 1);
 
     static void handle_doc_ops(const tsl::htrie_map<char, field>& search_schema,
                                nlohmann::json& update_doc, const nlohmann::json& old_doc);
@@ -666,6 +765,11 @@ public:
 
     static const size_t GROUP_LIMIT_MAX = 99;
 
+    // Dense facet counting is used only when the result set is large enough to amortize the count array
+    // and when the facet id range of the field is small enough to keep the array cache friendly.
+    static const size_t FACET_DENSE_COUNT_MIN_RESULTS = 1000;
+    static const size_t FACET_DENSE_COUNT_MAX_RANGE = 1 << 21;
+
     /// Value used when async_reference is true and a reference doc is not found.
     static constexpr int64_t reference_helper_sentinel_value = UINT32_MAX;
 
@@ -781,6 +885,10 @@ public:
     Option<uint32_t> remove(const uint32_t seq_id, nlohmann::json & document,
                             const std::vector<field>& del_fields, const bool is_update);
 
+    // Same as `remove`, but must be called with the exclusive lock held.
+    Option<uint32_t> do_remove(const uint32_t seq_id, nlohmann::json & document,
+                               const std::vector<field>& del_fields, const bool is_update);
+
     static void validate_and_preprocess(Index *index, std::vector<index_record>& iter_batch,
                                           const size_t batch_start_index, const size_t batch_size,
                                           const std::string & default_sorting_field,
@@ -830,6 +938,11 @@ public:
                                         const bool& should_timeout = true,
                                         const bool& validate_field_names = true) const;
 
+    // Upper bound of the number of documents matching the filter, without materializing the matching ids.
+    Option<bool> get_approx_filter_ids_length_with_lock(filter_node_t* const filter_tree_root,
+                                                        const std::string& collection_name,
+                                                        uint32_t& approx_filter_ids_length) const;
+
     Option<bool> do_reference_filtering_with_lock(filter_node_t* const filter_tree_root,
                                                   filter_result_t& filter_result,
                                                   const std::string& ref_collection_name,
@@ -889,6 +1002,17 @@ public:
                              const std::vector<facet_index_type_t>& facet_index_types
                              ) const;
 
+    // Copies the filter tree without the clauses that are AND-ed in and refer only to `field_name`. Returns nullptr
+    // when every clause is removed.
+    static filter_node_t* copy_filter_without_field(const filter_node_t* filter_node, const std::string& field_name,
+                                                    bool& removed);
+
+    // Result ids of a wildcard query whose filter is stripped of the clauses on the field of a disjunctive facet.
+    // Returns false when the filter has no clause on the field, in which case the facet is counted as usual.
+    Option<bool> get_disjunctive_facet_ids(const filter_node_t* filter_tree_root, const std::string& field_name,
+                                           const uint32_t* excluded_result_ids, size_t excluded_result_ids_size,
+                                           std::vector<uint32_t>& result_ids) const;
+
     void resolve_space_as_typos(std::vector<std::string>& qtokens, const std::string& field_name,
                                 std::vector<std::vector<std::string>>& resolved_queries) const;
 
@@ -1051,7 +1175,8 @@ public:
                                      const tsl::htrie_map<char, field>& search_schema,
                                      const std::vector<std::vector<art_leaf*>>& searched_queries,
                                      const int* sort_order,
-                                     int64_t& out_best_field_match_score);
+                                     int64_t& out_best_field_match_score,
+                                     const bm25_stats_t* bm25_stats = nullptr);
 
     void process_filter_overrides(const std::vector<const override_t*>& filter_overrides,
                                   std::vector<std::string>& query_tokens,
@@ -1127,7 +1252,13 @@ public:
     void get_field_token_its(const size_t num_search_fields, std::vector<art_leaf*>& query_suggestion,
                              std::vector<or_iterator_t>& token_its, std::vector<posting_list_t*>& expanded_plists,
                              const std::vector<token_t>& query_tokens,
-                             const std::vector<search_field_t>& the_fields) const;
+                             const std::vector<search_field_t>& the_fields,
+                             std::vector<size_t>* token_doc_freqs = nullptr) const;
+
+    void init_bm25_stats(const std::vector<search_field_t>& the_fields, const size_t num_search_fields,
+                         const std::vector<size_t>& token_doc_freqs, bm25_stats_t& bm25_stats) const;
+
+    const field_length_stats_t* _get_field_length_stats(const std::string& field_name) const;
 
     static void populate_result_kvs(Topster<KV>* topster, std::vector<std::vector<KV *>> &result_kvs,
                                     const spp::sparse_hash_map<uint64_t, uint32_t>& groups_processed,
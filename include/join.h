@@ -36,7 +36,13 @@ struct ref_include_collection_names_t {
     }
 };
 
+/// Pruned referenced documents of a request, keyed by the referenced collection, the include/exclude fields of the
+/// reference and the sequence id of the document, so that a document referenced by many hits is fetched only once.
+typedef std::unordered_map<std::string, nlohmann::json> request_ref_docs_t;
+
 class Join {
+    static constexpr char REF_DOC_KEY_SEPARATOR = '\x1f';
+
 public:
 
     static Option<bool> add_reference_helper_fields(nlohmann::json& document,
@@ -45,17 +51,33 @@ public:
                                                     tsl::htrie_set<char>& object_reference_helper_fields,
                                                     const bool& is_update);
 
+    /// Identifies the fields that the documents of a referenced collection are pruned to.
+    static std::string get_ref_doc_spec(const ref_include_exclude_fields& ref_include_exclude);
+
+    /// Fetches the referenced documents pruned to the included fields. The documents are looked up in the request's
+    /// documents and the cache of the referenced collection first, the rest are fetched from the store in a single
+    /// batch. `ref_docs[i]` is left null when the i-th reference is to a document that is not yet indexed.
+    static Option<bool> get_pruned_ref_docs(Collection* const ref_collection,
+                                            const reference_filter_result_t& references,
+                                            const tsl::htrie_set<char>& ref_include_fields_full,
+                                            const tsl::htrie_set<char>& ref_exclude_fields_full,
+                                            const ref_include_exclude_fields& ref_include_exclude,
+                                            request_ref_docs_t* const request_ref_docs,
+                                            std::vector<nlohmann::json>& ref_docs);
+
     static Option<bool> prune_ref_doc(nlohmann::json& doc,
                                       const reference_filter_result_t& references,
                                       const tsl::htrie_set<char>& ref_include_fields_full,
                                       const tsl::htrie_set<char>& ref_exclude_fields_full,
                                       const bool& is_reference_array,
-                                      const ref_include_exclude_fields& ref_include_exclude);
+                                      const ref_include_exclude_fields& ref_include_exclude,
+                                      request_ref_docs_t* const request_ref_docs = nullptr);
 
     static Option<bool> include_references(nlohmann::json& doc, const uint32_t& seq_id, Collection *const collection,
                                            const std::map<std::string, reference_filter_result_t>& reference_filter_results,
                                            const std::vector<ref_include_exclude_fields>& ref_include_exclude_fields_vec,
-                                           const nlohmann::json& original_doc);
+                                           const nlohmann::json& original_doc,
+                                           request_ref_docs_t* const request_ref_docs = nullptr);
 
     static Option<bool> parse_reference_filter(const std::string& filter_query, std::queue<std::string>& tokens, size_t& index,
                                                std::set<std::string>& ref_collection_names);
@@ -234,6 +234,12 @@ public:
                                            std::vector<size_t>& indices);
 
     static size_t get_last_offset(const posting_list_t::iterator_t& it, bool field_is_array);
+
+    // number of token positions present in an encoded offsets list (excludes the array index and marker values)
+    static uint32_t count_token_positions(const uint32_t* offsets, size_t num_offsets, bool field_is_array);
+
+    // term frequency of the token in the document the iterator currently points to
+    static uint32_t get_num_positions(const posting_list_t::iterator_t& it, bool field_is_array);
 };
 
 template<class T>
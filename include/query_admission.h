@@ -0,0 +1,112 @@
+#pragma once
+
+#include <map>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <condition_variable>
+#include "option.h"
+#include "json.hpp"
+
+// Admission control of searches based on their estimated cost.
+//
+// The total estimated cost of in-flight searches is capped by a budget (see the `max-inflight-query-cost` config).
+// A search that does not fit in the budget is queued, and queued searches are admitted in a max-min fair order:
+// the next one admitted belongs to the API key that has the least cost in flight, so that a single API key sending
+// expensive searches cannot starve the others. A search that is not admitted within the queue timeout is shed.
+class QueryAdmission {
+private:
+    struct waiter_t {
+        const std::string api_key;
+        const uint64_t cost;
+        bool admitted = false;
+
+        waiter_t(const std::string& api_key, uint64_t cost): api_key(api_key), cost(cost) {
+
+        }
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+
+    uint64_t max_inflight_cost = 0;
+    uint32_t queue_timeout_ms = DEFAULT_QUEUE_TIMEOUT_MS;
+
+    uint64_t inflight_cost = 0;
+    std::unordered_map<std::string, uint64_t> key_inflight_costs;
+    std::unordered_map<std::string, uint64_t> key_queued_costs;
+
+    // in arrival order
+    std::list<waiter_t*> waiters;
+
+    // searches turned away because the budget was exhausted (shed) or the API key queued too much (rejected)
+    uint64_t num_shed = 0;
+    uint64_t num_rejected = 0;
+
+    QueryAdmission() = default;
+
+    void add_inflight(const std::string& api_key, uint64_t cost);
+
+    // Admits queued searches while the budget allows. Must be called with `mutex` held.
+    void admit_waiters();
+
+public:
+
+    static constexpr uint32_t DEFAULT_QUEUE_TIMEOUT_MS = 2000;
+
+    // Cost of fetching, highlighting and serializing one hit, relative to scanning one document.
+    static constexpr uint64_t HIT_COST = 1000;
+
+    static QueryAdmission& get_instance() {
+        static QueryAdmission instance;
+        return instance;
+    }
+
+    QueryAdmission(QueryAdmission const&) = delete;
+    void operator=(QueryAdmission const&) = delete;
+
+    // A `max_inflight_cost` of 0 disables admission control.
+    void init(uint64_t max_inflight_cost, uint32_t queue_timeout_ms = DEFAULT_QUEUE_TIMEOUT_MS);
+
+    static uint64_t estimate_cost(uint64_t num_candidates, size_t num_facets, bool group_by, size_t per_page);
+
+    bool is_enabled() const;
+
+    // Estimates the cost of a search from its parameters, after the params embedded in a scoped API key are merged
+    // in. The number of candidates is bounded by the approximate number of documents matching `filter_by`. Returns 0
+    // for searches that will fail validation, and when admission control is disabled, so that no filtering work is
+    // wasted on the estimate.
+    static uint64_t estimate_search_cost(const std::map<std::string, std::string>& req_params,
+                                         const nlohmann::json& embedded_params);
+
+    // Blocks until the search can run. Returns the cost that must be released once the search completes.
+    Option<uint64_t> admit(const std::string& api_key, uint64_t cost);
+
+    void release(const std::string& api_key, uint64_t admitted_cost);
+
+    uint64_t get_inflight_cost() const;
+
+    void get_metrics(nlohmann::json& result) const;
+};
+
+class query_admission_guard_t {
+    const std::string api_key;
+    uint64_t admitted_cost = 0;
+
+public:
+    Option<bool> status = Option<bool>(true);
+
+    query_admission_guard_t(const std::string& api_key, uint64_t cost): api_key(api_key) {
+        auto admit_op = QueryAdmission::get_instance().admit(api_key, cost);
+        if(admit_op.ok()) {
+            admitted_cost = admit_op.get();
+        } else {
+            status = Option<bool>(admit_op.code(), admit_op.error());
+        }
+    }
+
+    ~query_admission_guard_t() {
+        QueryAdmission::get_instance().release(api_key, admitted_cost);
+    }
+};
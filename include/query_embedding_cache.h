@@ -0,0 +1,80 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "json.hpp"
+
+// LRU cache of the embeddings of search queries, keyed by the embedding model and the normalized query text.
+// Since embedders are shared across collections, so are the cached embeddings of a model. The cache is bounded
+// by the approximate number of bytes held by its entries (see the `query-embedding-cache-mb` config).
+class QueryEmbeddingCache {
+private:
+    struct entry_t {
+        const std::string key;
+        const std::vector<float> embedding;
+
+        entry_t(const std::string& key, const std::vector<float>& embedding): key(key), embedding(embedding) {
+
+        }
+
+        size_t size_bytes() const {
+            return ENTRY_OVERHEAD_BYTES + key.size() + embedding.size() * sizeof(float);
+        }
+    };
+
+    // book-keeping memory of an entry, in addition to its key and embedding
+    static constexpr size_t ENTRY_OVERHEAD_BYTES = 96;
+
+    static constexpr char KEY_SEPARATOR = '\x1f';
+
+    mutable std::mutex mutex;
+
+    // most recently used first
+    std::list<entry_t> entries;
+    std::unordered_map<std::string, std::list<entry_t>::iterator> entry_map;
+
+    size_t capacity_bytes = 0;
+    size_t size_bytes = 0;
+
+    uint64_t num_hits = 0;
+    uint64_t num_misses = 0;
+
+    QueryEmbeddingCache() = default;
+
+    // Evicts the least recently used entries until the cache fits its capacity. Must be called with `mutex` held.
+    void evict();
+
+public:
+
+    static QueryEmbeddingCache& get_instance() {
+        static QueryEmbeddingCache instance;
+        return instance;
+    }
+
+    QueryEmbeddingCache(QueryEmbeddingCache const&) = delete;
+    void operator=(QueryEmbeddingCache const&) = delete;
+
+    // A `capacity_bytes` of 0 disables the cache.
+    void init(size_t capacity_bytes);
+
+    bool is_enabled() const;
+
+    // Whitespace is trimmed and runs of whitespace are collapsed, since they don't change the tokens of the query.
+    static std::string get_key(const std::string& model_key, const std::string& query);
+
+    bool get(const std::string& key, std::vector<float>& embedding);
+
+    void put(const std::string& key, const std::vector<float>& embedding);
+
+    // Drops the embeddings of a model, e.g. when it is deleted.
+    void remove_model(const std::string& model_key);
+
+    void clear();
+
+    size_t get_size_bytes() const;
+
+    void get_metrics(nlohmann::json& result) const;
+};
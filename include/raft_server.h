@@ -16,6 +16,7 @@
 #include "cached_resource_stat.h"
 
 class Store;
+class Collection;
 class ReplicationState;
 
 // Implements the callback for the state machine
@@ -44,6 +45,25 @@ public:
     void Run();
 };
 
+typedef std::vector<std::pair<std::shared_ptr<http_req>, std::shared_ptr<http_res>>> req_res_batch_t;
+
+// Closure for concurrent writes that are replicated together as a single log entry
+class ReplicationBatchClosure : public braft::Closure {
+private:
+    const req_res_batch_t req_res_batch;
+
+public:
+    explicit ReplicationBatchClosure(req_res_batch_t&& req_res_batch): req_res_batch(std::move(req_res_batch)) {
+
+    }
+
+    const req_res_batch_t& get_req_res_batch() const {
+        return req_res_batch;
+    }
+
+    void Run();
+};
+
 // Closure that fires when refresh nodes operation finishes
 class RefreshNodesClosure : public braft::Closure {
 public:
@@ -130,6 +150,9 @@ private:
     std::atomic<bool> read_caught_up;
     std::atomic<bool> write_caught_up;
 
+    // false while the in-memory state is being (re)loaded from the store
+    std::atomic<bool> state_loaded;
+
     std::string raft_dir_path;
 
     std::string ext_snapshot_path;
@@ -145,6 +168,13 @@ private:
 
     std::atomic<size_t> snapshot_in_progress;
 
+    // small writes that are waiting to be replicated together, see `write_batch_window_us` config
+    std::mutex write_batch_mutex;
+    req_res_batch_t write_batch;
+
+    static const size_t MAX_WRITE_BATCH_SIZE = 256;
+    static const size_t MAX_BATCHED_WRITE_BODY_SIZE = 64 * 1024;
+
     const uint64_t snapshot_interval_s;     // frequency of actual snapshotting
     uint64_t last_snapshot_ts;              // when last snapshot ran
 
@@ -156,6 +186,15 @@ public:
     static constexpr const char* meta_dir_name = "meta";
     static constexpr const char* snapshot_dir_name = "snapshot";
 
+    // bounded staleness read parameters: a read that carries them is served even when the node is lagging,
+    // as long as writes upto the given log index / within the given lag from the committed log have been indexed
+    static constexpr const char* READ_MIN_INDEX = "read_min_index";
+    static constexpr const char* READ_MAX_LAG = "read_max_lag";
+    static constexpr const char* READ_WAIT_MS = "read_wait_ms";
+
+    static const uint64_t DEFAULT_READ_WAIT_MS = 500;
+    static const uint64_t MAX_READ_WAIT_MS = 10 * 1000;
+
     ReplicationState(HttpServer* server, BatchedIndexer* batched_indexer, Store* store, Store* analytics_store,
                      ThreadPool* thread_pool, http_message_dispatcher* message_dispatcher,
                      bool api_uses_ssl, const Config* config,
@@ -195,6 +234,26 @@ public:
         return write_caught_up;
     }
 
+    bool is_state_loaded() const {
+        return state_loaded;
+    }
+
+    static bool is_bounded_staleness_read(const std::map<std::string, std::string>& params) {
+        return params.count(READ_MIN_INDEX) != 0 || params.count(READ_MAX_LAG) != 0;
+    }
+
+    // Calls `callback` once this node has indexed the writes needed by a bounded staleness read, or with an error
+    // when the read is malformed or the node cannot catch up within the read's wait time. The calling thread is not
+    // blocked while the node catches up.
+    void on_read_index(const std::map<std::string, std::string>& params,
+                       const std::function<void(const Option<bool>&)>& callback);
+
+    static std::string serialize_write_batch(const req_res_batch_t& req_res_batch);
+
+    static bool is_write_batch(const std::string& log_data);
+
+    static std::vector<std::shared_ptr<http_req>> deserialize_write_batch(const std::string& log_data);
+
     bool is_alive() const;
 
     uint64_t node_state() const;
@@ -202,7 +261,7 @@ public:
     // Shut this node down.
     void shutdown();
 
-    int init_db();
+    int init_db(std::vector<Collection*>* built_collections = nullptr);
 
     Store* get_store();
 
@@ -256,6 +315,11 @@ private:
     // actual application of writes onto the WAL
     void on_apply(braft::Iterator& iter);
 
+    bool is_batchable_write(const std::shared_ptr<http_req>& request, const route_path* rpath) const;
+
+    // replicates the writes batched so far as a single log entry
+    void flush_write_batch();
+
     struct SnapshotArg {
         ReplicationState* replication_state;
         braft::SnapshotWriter* writer;
@@ -272,6 +336,9 @@ private:
 
     int on_snapshot_load(braft::SnapshotReader* reader);
 
+    // builds the collections of a snapshot from a copy of its db, while the current state continues to serve reads
+    bool build_snapshot_collections(const std::string& db_snapshot_path, std::vector<Collection*>& built_collections);
+
     void on_leader_start(int64_t term) {
         leader_term.store(term, butil::memory_order_release);
         LOG(INFO) << "Node becomes leader, term: " << term;
@@ -294,6 +361,12 @@ private:
         LOG(INFO) << "Configuration of this group is " << conf;
     }
 
+    void on_configuration_committed(const ::braft::Configuration& conf, int64_t index) {
+        // configuration entries never reach `on_apply`, but still move the applied log index forward
+        batched_indexer->set_applied_log_index(index);
+        on_configuration_committed(conf);
+    }
+
     void on_start_following(const ::braft::LeaderChangeContext& ctx) {
         refresh_catchup_status(true);
         LOG(INFO) << "Node starts following " << ctx;
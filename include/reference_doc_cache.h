@@ -0,0 +1,66 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "json.hpp"
+
+// LRU cache of the documents of a collection that are included in the hits of other collections through a reference,
+// already pruned to the fields included by the search. Entries are keyed by the sequence id of the document and the
+// include/exclude fields of the reference (see `Join::get_ref_doc_spec`), and are dropped when the document is
+// updated or removed. The cache is bounded by the number of entries (see the `reference-doc-cache-size` config).
+class ReferenceDocCache {
+private:
+    struct entry_t {
+        const uint32_t seq_id;
+        const std::string spec;
+        const nlohmann::json doc;
+
+        entry_t(uint32_t seq_id, const std::string& spec, const nlohmann::json& doc): seq_id(seq_id), spec(spec),
+                                                                                       doc(doc) {
+
+        }
+    };
+
+    mutable std::mutex mutex;
+
+    // most recently used first
+    std::list<entry_t> entries;
+    std::unordered_map<uint32_t, std::unordered_map<std::string, std::list<entry_t>::iterator>> entry_map;
+
+    size_t capacity = 0;
+
+    // Incremented on every invalidation, so that a document read from the store before an invalidation is not cached
+    // after it.
+    uint64_t generation = 0;
+
+    uint64_t num_hits = 0;
+    uint64_t num_misses = 0;
+
+    // Must be called with `mutex` held.
+    void erase(std::list<entry_t>::iterator entry_it);
+
+public:
+
+    // A `capacity` of 0 disables the cache.
+    void init(size_t capacity);
+
+    bool is_enabled() const;
+
+    // Must be read before the document is fetched from the store, and passed on to `put`.
+    uint64_t get_generation() const;
+
+    bool get(uint32_t seq_id, const std::string& spec, nlohmann::json& doc);
+
+    void put(uint32_t seq_id, const std::string& spec, const nlohmann::json& doc, uint64_t fetch_generation);
+
+    // Drops the entries of a document, e.g. when it is updated or removed.
+    void remove(uint32_t seq_id);
+
+    void clear();
+
+    size_t size() const;
+
+    void get_stats(uint64_t& hits, uint64_t& misses) const;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "filter_result_iterator.h"
+
+// Builds the result of a reference filter (`$ref_coll(...)`) from the `(doc id, reference doc id)` pairs of the join.
+//
+// The pairs are collected in a flat column, packed into 64 bit integers with the doc id in the upper half, and are
+// grouped by the doc id once all of them are known: with a counting sort when the doc ids are dense compared to the
+// number of pairs, and by sorting the packed values otherwise. The grouped column is then turned into the filter
+// result in a single pass. The references stay in a flat column of the filter result, and are attached to a doc
+// only when the doc is read.
+class ReferenceJoin {
+private:
+    std::vector<uint64_t> pairs;
+    uint32_t max_doc_id = 0;
+
+    bool is_grouped = true;
+
+    static uint32_t get_doc_id(uint64_t pair) {
+        return pair >> 32;
+    }
+
+    static uint32_t get_reference_doc_id(uint64_t pair) {
+        return pair & UINT32_MAX;
+    }
+
+public:
+    enum group_strategy_t {
+        automatic,
+        counting_sort,
+        comparison_sort
+    };
+
+    // A counting sort is used when the doc ids are spread over at most this many times the number of pairs.
+    static constexpr size_t COUNTING_SORT_MAX_SPREAD = 4;
+
+    void reserve(size_t num_pairs) {
+        pairs.reserve(num_pairs);
+    }
+
+    // The references of a doc must be added in the ascending order of their ids.
+    void add(uint32_t doc_id, uint32_t reference_doc_id) {
+        if (!pairs.empty() && doc_id < get_doc_id(pairs.back())) {
+            is_grouped = false;
+        }
+
+        pairs.push_back((uint64_t(doc_id) << 32) | reference_doc_id);
+        max_doc_id = std::max(max_doc_id, doc_id);
+    }
+
+    bool empty() const {
+        return pairs.empty();
+    }
+
+    size_t size() const {
+        return pairs.size();
+    }
+
+    // Orders the pairs by the doc id, the references of a doc stay in the order they were added in.
+    void group_by_doc(group_strategy_t strategy = automatic);
+
+    // Sorted ids of the joined docs.
+    void get_doc_ids(std::vector<uint32_t>& doc_ids);
+
+    // Every doc of the result gets the references to `ref_collection_name` that it was joined with, kept flat in
+    // `filter_result.reference_docs`.
+    void to_filter_result(const std::string& ref_collection_name, bool is_reference_array_field,
+                          filter_result_t& filter_result);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "option.h"
+#include "json.hpp"
+#include "field.h"
+
+class ThreadPool;
+
+// Search over a collection whose documents are partitioned across independent clusters (shards). Each shard holds
+// the same collection schema but a different subset of the documents. The node that receives a search acts as
+// the coordinator: it forwards the search to the other shards (see the `shard-nodes` config), runs it locally
+// and merges the results.
+//
+// Only searches are coordinated: documents are not placed or routed across shards, so every write must be sent to
+// the cluster of the shard that holds the document.
+class ShardSearch {
+private:
+    // Requests to the other shards are made on a pool of their own, since they wait on the network.
+    static ThreadPool* thread_pool;
+
+    static Option<bool> get_merge_sort_fields(const std::map<std::string, std::string>& req_params,
+                                              std::vector<sort_by>& sort_fields);
+
+    static Option<bool> search_shard(const std::string& node_url, const std::string& api_key,
+                                     const std::map<std::string, std::string>& req_params,
+                                     nlohmann::json& result);
+
+public:
+    typedef std::function<Option<bool>(std::map<std::string, std::string>& page_params,
+                                       nlohmann::json& page_result)> search_page_t;
+
+    static void set_thread_pool(ThreadPool* pool);
+
+    // Number of hits that every shard is asked for: all the hits up to the requested page, but no more than
+    // `limit_hits`. Deeper pages than the `shard-search-max-hits` config are rejected, since they cost every shard
+    // that many hits.
+    static Option<size_t> get_fetch_depth(size_t offset, size_t per_page, size_t limit_hits);
+
+    static std::vector<std::string> get_shard_nodes();
+
+    // Fetches the top `depth` hits of a shard through `search_page`. A shard serves at most `max-per-page` hits
+    // per request, so deeper hits are fetched over several pages and appended to the hits of the first page, whose
+    // `found`, `out_of` and facet counts are kept.
+    static Option<bool> fetch_shard_hits(const std::map<std::string, std::string>& shard_params, size_t depth,
+                                         const search_page_t& search_page, nlohmann::json& result);
+
+    // Runs the search on all shards and merges the results. Shards are asked for every hit up to the requested
+    // page, which is then cut out of the merged hits.
+    static Option<bool> search(std::map<std::string, std::string>& req_params, nlohmann::json& embedded_params,
+                               const std::string& api_key, std::string& results_json_str, uint64_t start_ts);
+
+    // Merges the results of the same search on each shard. Hits are ordered by `sort_fields` and `limit` hits are
+    // returned from `offset`, while `found`, `out_of` and facet counts are summed. Since a shard returns only its
+    // top facet values, merged counts of values that fall outside the top values of some shard are lower bounds.
+    static void merge_results(const std::vector<nlohmann::json>& shard_results,
+                              const std::vector<sort_by>& sort_fields,
+                              size_t offset, size_t limit, size_t max_facet_values,
+                              nlohmann::json& merged);
+};
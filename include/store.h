@@ -85,6 +85,10 @@ public:
 
     StoreStatus get(const std::string& key, std::string& value) const;
 
+    // Looks up all the keys in a single batch: `values[i]` and `statuses[i]` hold the result of `keys[i]`.
+    void multi_get(const std::vector<std::string>& keys, std::vector<std::string>& values,
+                   std::vector<StoreStatus>& statuses) const;
+
     bool remove(const std::string& key);
 
     rocksdb::Iterator* scan(const std::string & prefix, const rocksdb::Slice* iterate_upper_bound);
@@ -4,6 +4,8 @@
 #include <core/session/onnxruntime_cxx_api.h>
 #include <tokenizer/bert_tokenizer.hpp>
 #include <vector>
+#include <deque>
+#include <condition_variable>
 #include "option.h"
 #include "text_embedder_tokenizer.h"
 #include "text_embedder_remote.h"
@@ -42,11 +44,56 @@ class TextEmbedder {
             return remote_embedder_->update_api_key(api_key);
         }
 
+        // Maximum number of inputs run through the model at once.
+        static constexpr size_t MAX_BATCH_SIZE = 8;
+
     private:
+        // A query that is waiting to be embedded as part of a batch.
+        struct pending_embed_t {
+            const std::string& text;
+            embedding_res_t result;
+            bool taken = false;
+            bool done = false;
+
+            explicit pending_embed_t(const std::string& text): text(text) {
+
+            }
+        };
+
+        // `Session::Run` is thread-safe, so the model is loaded once and its session is shared by concurrent runs.
         std::shared_ptr<Ort::Session> session_;
+
+        // Number of further runs that may start on the session, bounded by the configured model concurrency.
+        size_t num_free_runs_ = 1;
+        std::mutex run_mutex_;
+        std::condition_variable run_cv_;
+
+        // Holds one of the concurrent runs of the session for the duration of its scope.
+        class run_guard_t {
+            TextEmbedder& embedder;
+        public:
+            explicit run_guard_t(TextEmbedder& embedder): embedder(embedder) {
+                embedder.acquire_run();
+            }
+
+            ~run_guard_t() {
+                embedder.release_run();
+            }
+        };
+
+        // Concurrent `Embed` calls queue up here, and are run together as one batch when a run becomes free.
+        std::deque<pending_embed_t*> pending_embeds_;
+        bool batch_leader_active_ = false;
+        std::mutex batch_mutex_;
+        std::condition_variable batch_cv_;
+
         std::shared_ptr<Ort::Env> env_;
         encoded_input_t Encode(const std::string& text);
         batch_encoded_input_t batch_encode(const std::vector<std::string>& inputs);
+        void acquire_run();
+        void release_run();
+        embedding_res_t batched_embed(const std::string& text);
+        std::vector<embedding_res_t> run_batch(const std::vector<std::string>& input_batch);
         std::unique_ptr<TextEmbeddingTokenizer> tokenizer_;
         std::unique_ptr<RemoteEmbedder> remote_embedder_;
         std::string vocab_file_name;
@@ -78,6 +78,12 @@ public:
 
     bool next(std::string& token, size_t& token_index);
 
+    // Moves past the next `num_tokens` tokens without extracting them, so that a token whose index is already known
+    // (e.g. from the offsets in a posting list) can be reached without tokenizing the text before it. Skipping stops
+    // early at a segment that can't be told to be a token without normalizing it, and is not supported for locales
+    // that are segmented by a break iterator. Returns the number of tokens skipped.
+    size_t skip_tokens(size_t num_tokens);
+
     void tokenize(std::vector<std::string>& tokens);
 
     bool tokenize(std::string& token);
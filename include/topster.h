@@ -378,6 +378,26 @@ struct Topster {
         return ret;
     }
 
+    // Adds a group aggregated by another topster. The group topster is taken over when this topster does not have
+    // the group yet and `true` is returned, otherwise its kvs are copied and it remains owned by the caller.
+    bool add_group(const uint64_t distinct_key, Topster<T, get_key, get_distinct_key, is_greater, is_smaller>* g_topster) {
+        for(const auto& map_kv: g_topster->map) {
+            group_doc_seq_ids.emplace(map_kv.second->key);
+        }
+
+        auto kvs_it = group_kv_map.find(distinct_key);
+        if(kvs_it == group_kv_map.end()) {
+            group_kv_map.emplace(distinct_key, g_topster);
+            return true;
+        }
+
+        for(const auto& map_kv: g_topster->map) {
+            kvs_it->second->add(map_kv.second);
+        }
+
+        return false;
+    }
+
     // topster must be sorted before iterated upon to remove dead array entries
     void sort() {
         if(!distinct) {
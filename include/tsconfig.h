@@ -46,6 +46,20 @@ private:
     std::atomic<size_t> healthy_read_lag;
     std::atomic<size_t> healthy_write_lag;
 
+    uint32_t write_batch_window_us;
+
+    std::string shard_nodes;
+
+    uint32_t shard_search_max_hits;
+
+    uint64_t max_inflight_query_cost;
+
+    uint32_t embedding_model_concurrency;
+
+    uint32_t query_embedding_cache_mb;
+
+    uint32_t reference_doc_cache_size;
+
     std::string config_file;
     int config_file_validity;
 
@@ -56,6 +70,8 @@ private:
 
     uint32_t thread_pool_size;
 
+    uint32_t num_http_event_loops;
+
     bool enable_access_logging;
 
     int disk_used_max_percentage;
@@ -97,11 +113,13 @@ protected:
         this->snapshot_max_byte_count_per_rpc = 4194304;
         this->healthy_read_lag = 1000;
         this->healthy_write_lag = 500;
+        this->write_batch_window_us = 0;
         this->log_slow_requests_time_ms = -1;
         this->num_collections_parallel_load = 0;  // will be set dynamically if not overridden
         this->num_documents_parallel_load = 1000;
         this->cache_num_entries = 1000;
         this->thread_pool_size = 0; // will be set dynamically if not overridden
+        this->num_http_event_loops = 1;
         this->ssl_refresh_interval_seconds = 8 * 60 * 60;
         this->enable_access_logging = false;
         this->disk_used_max_percentage = 100;
@@ -122,6 +140,16 @@ protected:
         this->max_per_page = 250;
 
         this->filter_by_max_ops = FILTER_BY_DEFAULT_OPERATIONS;
+
+        this->max_inflight_query_cost = 0;    // disabled
+
+        this->shard_search_max_hits = 10000;
+
+        this->embedding_model_concurrency = 1;
+
+        this->query_embedding_cache_mb = 64;
+
+        this->reference_doc_cache_size = 0;
     }
 
     Config(Config const&) {
@@ -226,6 +254,10 @@ public:
         this->reset_peers_on_error = reset_peers_on_error;
     }
 
+    void set_reference_doc_cache_size(uint32_t reference_doc_cache_size) {
+        this->reference_doc_cache_size = reference_doc_cache_size;
+    }
+
     void set_max_per_page(int max_per_page) {
         this->max_per_page = max_per_page;
     }
@@ -332,6 +364,34 @@ public:
         return this->healthy_write_lag;
     }
 
+    size_t get_write_batch_window_us() const {
+        return this->write_batch_window_us;
+    }
+
+    std::string get_shard_nodes() const {
+        return this->shard_nodes;
+    }
+
+    uint32_t get_shard_search_max_hits() const {
+        return this->shard_search_max_hits;
+    }
+
+    uint64_t get_max_inflight_query_cost() const {
+        return this->max_inflight_query_cost;
+    }
+
+    uint32_t get_embedding_model_concurrency() const {
+        return this->embedding_model_concurrency;
+    }
+
+    uint32_t get_query_embedding_cache_mb() const {
+        return this->query_embedding_cache_mb;
+    }
+
+    uint32_t get_reference_doc_cache_size() const {
+        return this->reference_doc_cache_size;
+    }
+
     int get_log_slow_requests_time_ms() const {
         return this->log_slow_requests_time_ms;
     }
@@ -372,6 +432,10 @@ public:
         return this->thread_pool_size;
     }
 
+    size_t get_num_http_event_loops() const {
+        return this->num_http_event_loops;
+    }
+
     size_t get_ssl_refresh_interval_seconds() const {
         return this->ssl_refresh_interval_seconds;
     }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Computes the inner product distances (1 - <q, v>) of a query to a block of vectors at once, for scans over
+// the vectors of a (filtered) subset of documents.
+//
+// The vectors of a block are stored transposed: the i-th value of the j-th vector is at `block[i * BLOCK_SIZE + j]`,
+// so that each SIMD lane accumulates the products of a different vector. Every lane repeats the order of additions
+// of hnswlib's distance function for the same dimension, which makes the distances of a scan bit-identical to the
+// distances computed during a graph search, so that results don't change with the search strategy.
+class VectorDistance {
+public:
+    static constexpr size_t BLOCK_SIZE = 16;
+
+    enum kernel_t {
+        scalar = 0,
+        sse = 1,
+        avx2 = 2,
+        avx512 = 3,
+    };
+
+    // Widest kernel supported by the CPU.
+    static kernel_t get_supported_kernel();
+
+    static void set_block_vector(float* block, size_t dim, size_t lane, const float* values) {
+        for(size_t i = 0; i < dim; i++) {
+            block[i * BLOCK_SIZE + lane] = values[i];
+        }
+    }
+
+    // Writes the distances of all `BLOCK_SIZE` vectors of the block to `distances`.
+    static void inner_product_distances(const float* query, const float* block, size_t dim, float* distances);
+
+    static void inner_product_distances(kernel_t kernel, const float* query, const float* block, size_t dim,
+                                        float* distances);
+
+private:
+    // Number of leading dimensions that hnswlib sums in 4 interleaved partial sums, the rest are added one by one.
+    static size_t get_num_simd_dims(size_t dim);
+};
@@ -11,6 +11,7 @@ struct vector_query_t {
     std::string field_name;
     size_t k = 0;
     size_t flat_search_cutoff = 0;
+    bool flat_search_cutoff_given = false;
     float distance_threshold = std::numeric_limits<float>::max();
     std::vector<float> values;
 
@@ -121,12 +121,14 @@ void AppMetrics::window_reset() {
 
 void AppMetrics::write_access_log(const uint64_t epoch_millis, const char* remote_ip, const std::string& path) {
     if(!access_log_path.empty()) {
+        std::unique_lock lock(access_log_mutex);
         access_log << epoch_millis << "\t" << remote_ip << "\t" << path << "\n";
     }
 }
 
 void AppMetrics::flush_access_log() {
     if(!access_log_path.empty()) {
+        std::unique_lock lock(access_log_mutex);
         access_log << std::flush;
     }
 }
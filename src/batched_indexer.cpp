@@ -53,13 +53,15 @@ void BatchedIndexer::enqueue(const std::shared_ptr<http_req>& req, const std::sh
 
         if(req_res_map_it == req_res_map.end()) {
             // first chunk
-            req_res_t req_res(req->start_ts, "", req, res, now, 1, 0, false);
+            req_res_t req_res(req->start_ts, "", req, res, now, 1, 0, false, req->log_index);
             req_res_map.emplace(req->start_ts, req_res);
         } else {
             chunk_sequence = req_res_map_it->second.num_chunks;
             req_res_map_it->second.num_chunks += 1;
             req_res_map_it->second.last_updated = now;
         }
+
+        last_applied_log_index = std::max(last_applied_log_index, req->log_index);
     }
 
     const std::string& req_key_prefix = get_req_prefix_key(req->start_ts);
@@ -337,6 +339,7 @@ void BatchedIndexer::run() {
                 req_res_map.erase(req_id);
                 lk.unlock();
                 refq_wait.cv.notify_one();
+                notify_indexed();
             }
         });
     }
@@ -410,7 +413,10 @@ void BatchedIndexer::run() {
     uint64_t prev_count = 0;
 
     while(!quit) {
-        std::this_thread::sleep_for(std::chrono::milliseconds (1000));
+        for(size_t i = 0; i < 1000 / INDEXED_WAIT_CHECK_MS && !quit; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(INDEXED_WAIT_CHECK_MS));
+            expire_indexed_waits();
+        }
 
         // do gc, if we are due for one
         uint64_t seconds_elapsed = std::chrono::duration_cast<std::chrono::seconds>(
@@ -468,6 +474,9 @@ void BatchedIndexer::run() {
                 }
             }
 
+            lk.unlock();
+            notify_indexed();
+
             last_gc_run = std::chrono::high_resolution_clock::now();
         }
     }
@@ -478,6 +487,8 @@ void BatchedIndexer::run() {
         queue_mutex.cv.notify_one();
     }
 
+    notify_indexed();
+
     LOG(INFO) << "Notifying reference sequence thread about shutdown...";
     refq_wait.cv.notify_one();
     ref_sequence_thread.join();
@@ -511,6 +522,87 @@ int64_t BatchedIndexer::get_queued_writes() {
     return queued_writes;
 }
 
+int64_t BatchedIndexer::get_indexed_log_index() {
+    std::unique_lock lk(mutex);
+
+    // requests are removed only after all their chunks have been indexed
+    int64_t min_pending_log_index = last_applied_log_index + 1;
+    for(const auto& kv: req_res_map) {
+        min_pending_log_index = std::min(min_pending_log_index, kv.second.log_index);
+    }
+
+    return min_pending_log_index - 1;
+}
+
+void BatchedIndexer::on_indexed_log_index(int64_t log_index, uint64_t timeout_ms,
+                                          const std::function<void(bool)>& callback) {
+    {
+        // checked under the waiters' lock, so that a notification can't slip in between the check and the wait
+        std::unique_lock lk(indexed_waiters_mutex);
+        if(!quit && get_indexed_log_index() < log_index) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+            indexed_waiters.emplace(log_index, indexed_waiter_t{deadline, callback});
+            return ;
+        }
+    }
+
+    callback(!quit);
+}
+
+void BatchedIndexer::expire_indexed_waits() {
+    std::vector<std::function<void(bool)>> expired_callbacks;
+    const auto now = std::chrono::steady_clock::now();
+
+    {
+        std::unique_lock lk(indexed_waiters_mutex);
+        for(auto it = indexed_waiters.begin(); it != indexed_waiters.end();) {
+            if(it->second.deadline <= now) {
+                expired_callbacks.push_back(std::move(it->second.callback));
+                it = indexed_waiters.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+
+    for(const auto& callback: expired_callbacks) {
+        callback(false);
+    }
+}
+
+void BatchedIndexer::set_applied_log_index(int64_t log_index) {
+    {
+        std::unique_lock lk(mutex);
+        if(log_index <= last_applied_log_index) {
+            return ;
+        }
+
+        last_applied_log_index = log_index;
+    }
+
+    notify_indexed();
+}
+
+void BatchedIndexer::notify_indexed() {
+    const int64_t indexed_log_index = get_indexed_log_index();
+    std::vector<std::function<void(bool)>> indexed_callbacks;
+
+    {
+        // on shutdown, every pending wait is failed
+        std::unique_lock lk(indexed_waiters_mutex);
+        auto end_it = quit ? indexed_waiters.end() : indexed_waiters.upper_bound(indexed_log_index);
+        for(auto it = indexed_waiters.begin(); it != end_it; it++) {
+            indexed_callbacks.push_back(std::move(it->second.callback));
+        }
+
+        indexed_waiters.erase(indexed_waiters.begin(), end_it);
+    }
+
+    for(const auto& callback: indexed_callbacks) {
+        callback(!quit);
+    }
+}
+
 void BatchedIndexer::populate_skip_index() {
     if(skip_index_iter->Valid() && skip_index_iter->key().starts_with(SKIP_INDICES_PREFIX)) {
         const std::string& index_value = skip_index_iter->value().ToString();
@@ -547,6 +639,7 @@ void BatchedIndexer::serialize_state(nlohmann::json& state) {
         req_res["num_chunks"] = kv.second.num_chunks;
         req_res["next_chunk_index"] = kv.second.next_chunk_index;
         req_res["is_complete"] = kv.second.is_complete;
+        req_res["log_index"] = kv.second.log_index;
         req_res["req"] = kv.second.req->to_json();
         req_res["prev_req_body"] = kv.second.prev_req_body;
         num_reqs_stored++;
@@ -581,7 +674,9 @@ void BatchedIndexer::load_state(const nlohmann::json& state) {
                           kv.value()["last_updated"].get<uint64_t>(),
                           kv.value()["num_chunks"].get<uint32_t>(),
                           kv.value()["next_chunk_index"].get<uint32_t>(),
-                          kv.value()["is_complete"].get<bool>());
+                          kv.value()["is_complete"].get<bool>(),
+                          kv.value().contains("log_index") ? kv.value()["log_index"].get<int64_t>() :
+                                                             req->log_index);
 
         {
             std::unique_lock mlk(mutex);
@@ -0,0 +1,83 @@
+#include "bm25.h"
+#include <algorithm>
+
+void field_length_stats_t::upsert(uint32_t seq_id, uint32_t length) {
+    auto doc_it = doc_lengths.find(seq_id);
+    if(doc_it != doc_lengths.end()) {
+        total_length -= doc_it->second;
+        doc_it->second = length;
+    } else {
+        doc_lengths.emplace(seq_id, length);
+    }
+
+    total_length += length;
+}
+
+void field_length_stats_t::remove(uint32_t seq_id) {
+    auto doc_it = doc_lengths.find(seq_id);
+    if(doc_it == doc_lengths.end()) {
+        return;
+    }
+
+    total_length -= doc_it->second;
+    doc_lengths.erase(doc_it);
+}
+
+uint32_t field_length_stats_t::get_length(uint32_t seq_id) const {
+    auto doc_it = doc_lengths.find(seq_id);
+    if(doc_it == doc_lengths.end()) {
+        return 0;
+    }
+
+    return doc_it->second;
+}
+
+size_t field_length_stats_t::num_docs() const {
+    return doc_lengths.size();
+}
+
+uint64_t field_length_stats_t::get_total_length() const {
+    return total_length;
+}
+
+float field_length_stats_t::avg_length() const {
+    if(doc_lengths.empty()) {
+        return 0;
+    }
+
+    return float(total_length) / doc_lengths.size();
+}
+
+float bm25_t::idf(size_t num_docs, size_t doc_freq) {
+    if(doc_freq > num_docs) {
+        // can happen when stats of a field are being refreshed concurrently
+        num_docs = doc_freq;
+    }
+
+    return std::log(1.0f + (float(num_docs - doc_freq) + 0.5f) / (float(doc_freq) + 0.5f));
+}
+
+float bm25_t::normalized_tf(uint32_t tf, uint32_t field_len, float avg_field_len) {
+    if(tf == 0) {
+        return 0;
+    }
+
+    if(avg_field_len <= 0) {
+        return tf;
+    }
+
+    return tf / (1.0f - B + B * (float(field_len) / avg_field_len));
+}
+
+float bm25_t::token_score(float idf, float weighted_tf) {
+    if(weighted_tf <= 0) {
+        return 0;
+    }
+
+    return idf * (weighted_tf * (K1 + 1.0f)) / (weighted_tf + K1);
+}
+
+int64_t bm25_t::scaled_score(float score) {
+    const int64_t max_score = (int64_t(1) << 56) - 1;
+    return std::max<int64_t>(1, std::min<int64_t>(max_score, int64_t(score * SCORE_SCALE)));
+}
@@ -73,6 +73,7 @@ Collection::Collection(const std::string& name, const uint32_t collection_id, co
         vq_model->inc_collection_ref_count();
     }
     this->num_documents = 0;
+    reference_doc_cache.init(Config::get_instance().get_reference_doc_cache_size());
 }
 
 Collection::~Collection() {
@@ -238,13 +239,75 @@ Option<doc_seq_id_t> Collection::to_doc(const std::string & json_str, nlohmann::
                                         const index_operation_t& operation,
                                         const DIRTY_VALUES dirty_values,
                                         const std::string& id) {
+    auto parse_op = parse_doc(json_str, document);
+    if(!parse_op.ok()) {
+        return Option<doc_seq_id_t>(parse_op.code(), parse_op.error());
+    }
+
+    return get_doc_seq_id(document, operation, id);
+}
+
+Option<bool> Collection::parse_doc(const std::string& json_str, nlohmann::json& document) {
     try {
         document = nlohmann::json::parse(json_str);
     } catch(const std::exception& e) {
         LOG(ERROR) << "JSON error: " << e.what();
-        return Option<doc_seq_id_t>(400, std::string("Bad JSON: ") + e.what());
+        return Option<bool>(400, std::string("Bad JSON: ") + e.what());
+    }
+
+    return Option<bool>(true);
+}
+
+void Collection::parse_json_lines(const std::vector<std::string>& json_lines, const size_t begin, const size_t end,
+                                  std::vector<nlohmann::json>& parsed_docs, std::vector<Option<bool>>& parse_ops) {
+    const size_t num_lines = end - begin;
+    parsed_docs.clear();
+    parsed_docs.resize(num_lines);
+    parse_ops.clear();
+    parse_ops.resize(num_lines, Option<bool>(true));
+
+    // below this, handing the lines over to the thread pool costs more than parsing them
+    const size_t min_lines_per_thread = 64;
+    const size_t concurrency = 4;
+    const size_t num_threads = std::min(concurrency, (num_lines + min_lines_per_thread - 1) / min_lines_per_thread);
+
+    auto thread_pool = CollectionManager::get_instance().get_thread_pool();
+
+    if(num_threads <= 1 || thread_pool == nullptr) {
+        for(size_t i = 0; i < num_lines; i++) {
+            parse_ops[i] = parse_doc(json_lines[begin + i], parsed_docs[i]);
+        }
+        return ;
+    }
+
+    const size_t window_size = (num_lines + num_threads - 1) / num_threads;  // rounds up
+
+    size_t num_processed = 0;
+    size_t num_queued = 0;
+    std::mutex m_process;
+    std::condition_variable cv_process;
+
+    for(size_t window_start = 0; window_start < num_lines; window_start += window_size) {
+        const size_t window_end = std::min(num_lines, window_start + window_size);
+        num_queued++;
+
+        thread_pool->enqueue([&, window_start, window_end]() {
+            for(size_t i = window_start; i < window_end; i++) {
+                parse_ops[i] = parse_doc(json_lines[begin + i], parsed_docs[i]);
+            }
+
+            std::unique_lock<std::mutex> lock(m_process);
+            num_processed++;
+            cv_process.notify_one();
+        });
     }
 
+    std::unique_lock<std::mutex> lock_process(m_process);
+    cv_process.wait(lock_process, [&](){ return num_processed == num_queued; });
+}
+
+Option<doc_seq_id_t> Collection::get_doc_seq_id(nlohmann::json& document, const index_operation_t& operation,
+                                                const std::string& id) {
     if(!document.is_object()) {
         return Option<doc_seq_id_t>(400, "Bad JSON: not a properly formed document.");
     }
@@ -358,6 +421,10 @@ nlohmann::json Collection::get_summary_json() const {
             field_json[fields::range_index] = coll_field.range_index;
         }
 
+        if(coll_field.bm25) {
+            field_json[fields::bm25] = true;
+        }
+
         // no need to sned hnsw_params for text fields
         if(coll_field.num_dim > 0) {
             field_json[fields::hnsw_params] = coll_field.hnsw_params;
@@ -378,6 +445,10 @@ nlohmann::json Collection::get_summary_json() const {
         if(coll_field.num_dim > 0) {
             field_json[fields::num_dim] = coll_field.num_dim;
             field_json[fields::vec_dist] = magic_enum::enum_name(coll_field.vec_dist);
+
+            if(coll_field.multi_vector) {
+                field_json[fields::multi_vector] = true;
+            }
         }
 
         if (!coll_field.reference.empty()) {
@@ -510,9 +581,25 @@ nlohmann::json Collection::add_many(std::vector<std::string>& json_lines, nlohma
     std::set<std::string> batch_doc_ids;
     bool found_batch_new_field = false;
 
+    // lines are parsed ahead in parallel, one index batch at a time, while sequence IDs are still assigned in order
+    std::vector<nlohmann::json> parsed_docs;
+    std::vector<Option<bool>> parse_ops;
+    size_t parsed_offset = 0;
+
     for(size_t i=0; i < json_lines.size(); i++) {
-        const std::string & json_line = json_lines[i];
-        Option<doc_seq_id_t> doc_seq_id_op = to_doc(json_line, document, operation, dirty_values, id);
+        if(i >= parsed_offset + parsed_docs.size()) {
+            parsed_offset = i;
+            parse_json_lines(json_lines, i, std::min(json_lines.size(), i + index_batch_size), parsed_docs, parse_ops);
+        }
+
+        const size_t parsed_index = i - parsed_offset;
+        const auto& parse_op = parse_ops[parsed_index];
+        if(parse_op.ok()) {
+            document = std::move(parsed_docs[parsed_index]);
+        }
+
+        Option<doc_seq_id_t> doc_seq_id_op = parse_op.ok() ? get_doc_seq_id(document, operation, id) :
+                                             Option<doc_seq_id_t>(parse_op.code(), parse_op.error());
 
         const uint32_t seq_id = doc_seq_id_op.ok() ? doc_seq_id_op.get().seq_id : 0;
         index_record record(i, seq_id, document, operation, dirty_values);
@@ -531,6 +618,7 @@ nlohmann::json Collection::add_many(std::vector<std::string>& json_lines, nlohma
 
             if(repeated_doc) {
                 // when a document repeats, we send the batch until this document so that we can deal with conflicts
+                parsed_docs[parsed_index] = std::move(record.doc);
                 i--;
                 goto do_batched_index;
             }
@@ -729,6 +817,7 @@ void Collection::batch_index(std::vector<index_record>& index_records, std::vect
                 const std::string& serialized_json = index_record.new_doc.dump(-1, ' ', false, nlohmann::detail::error_handler_t::ignore);
 
                 bool write_ok = store->insert(get_seq_id_key(index_record.seq_id), serialized_json);
+                reference_doc_cache.remove(index_record.seq_id);
 
                 if(!write_ok) {
                     // we will attempt to reindex the old doc on a best-effort basis
@@ -1314,8 +1403,8 @@ Option<bool> Collection::validate_and_standardize_sort_fields(const std::vector<
                             }
                         }
 
-                        std::string embed_query = embedder_manager.get_query_prefix(vector_field_it.value().embed[fields::model_config]) + q;
-                        auto embedding_op = embedder->Embed(embed_query, remote_embedding_timeout_ms, remote_embedding_num_tries);
+                        auto embedding_op = embedder_manager.embed_query(embedder, vector_field_it.value().embed[fields::model_config], q,
+                                                                         remote_embedding_timeout_ms, remote_embedding_num_tries);
 
                         if(!embedding_op.success) {
                             if(embedding_op.error.contains("error")) {
@@ -1369,8 +1458,8 @@ Option<bool> Collection::validate_and_standardize_sort_fields(const std::vector<
                         return Option<bool>(400, error);
                     }
 
-                    std::string embed_query = embedder_manager.get_query_prefix(vector_field_it.value().embed[fields::model_config]) + query;
-                    auto embedding_op = embedder->Embed(embed_query, remote_embedding_timeout_ms, remote_embedding_num_tries);
+                    auto embedding_op = embedder_manager.embed_query(embedder, vector_field_it.value().embed[fields::model_config], query,
+                                                                     remote_embedding_timeout_ms, remote_embedding_num_tries);
 
                     if(!embedding_op.success) {
                         if(embedding_op.error.contains("error")) {
@@ -2157,8 +2246,8 @@ Option<bool> Collection::init_index_search_args(collection_search_args_t& coll_a
                     }
                 }
 
-                std::string embed_query = embedder_manager.get_query_prefix(search_field.embed[fields::model_config]) + query;
-                auto embedding_op = embedder->Embed(embed_query, remote_embedding_timeout_ms, remote_embedding_num_tries);
+                auto embedding_op = embedder_manager.embed_query(embedder, search_field.embed[fields::model_config], query,
+                                                                 remote_embedding_timeout_ms, remote_embedding_num_tries);
                 if(!embedding_op.success) {
                     if(embedding_op.error.contains("error")) {
                         return Option<bool>(400, embedding_op.error["error"].get<std::string>());
@@ -2279,6 +2368,23 @@ Option<bool> Collection::init_index_search_args(collection_search_args_t& coll_a
         }
     }
 
+    // disjunctive facets are counted against the results of the filter without the facet's own clauses
+    for(const std::string& disjunctive_facet: coll_args.disjunctive_facets) {
+        auto facet_it = std::find_if(facets.begin(), facets.end(), [&](const facet& a_facet) {
+            return a_facet.field_name == disjunctive_facet;
+        });
+
+        if(facet_it == facets.end()) {
+            return Option<bool>(400, "Disjunctive facet `" + disjunctive_facet + "` must also be present in `facet_by`.");
+        }
+
+        if(raw_query != "*" || !vector_query_str.empty()) {
+            return Option<bool>(400, "Disjunctive facets are supported only for wildcard queries.");
+        }
+
+        facet_it->is_disjunctive = true;
+    }
+
     std::vector<facet_index_type_t> facet_index_types;
     std::vector<std::string> facet_index_str_types;
     StringUtils::split(facet_index_type, facet_index_str_types, ",");
@@ -2653,7 +2759,8 @@ Option<nlohmann::json> Collection::search(std::string query, const std::vector<s
                                           const size_t& max_filter_by_candidates,
                                           bool rerank_hybrid_matches,
                                           bool validate_field_names,
-                                          bool enable_analytics) const {
+                                          bool enable_analytics,
+                                          const std::vector<std::string>& disjunctive_facets) const {
     std::shared_lock lock(mutex);
 
     auto args = collection_search_args_t(query, search_fields, filter_query,
@@ -2682,7 +2789,8 @@ Option<nlohmann::json> Collection::search(std::string query, const std::vector<s
                                          override_tags_str, voice_query, enable_typos_for_numerical_tokens,
                                          enable_synonyms, synonym_prefix, synonym_num_typos, enable_lazy_filter,
                                          enable_typos_for_alpha_numerical_tokens, max_filter_by_candidates,
-                                         rerank_hybrid_matches, enable_analytics, validate_field_names);
+                                         rerank_hybrid_matches, enable_analytics, validate_field_names,
+                                         disjunctive_facets);
     return search(args);
 }
 
@@ -2913,6 +3021,7 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
     }
 
     nlohmann::json docs_array = nlohmann::json::array();
+    request_ref_docs_t request_ref_docs;
 
     // construct results array
     for(long result_kvs_index = start_result_index; result_kvs_index <= end_result_index; result_kvs_index++) {
@@ -2963,7 +3072,7 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
                                       0,
                                       field_order_kv->reference_filter_results,
                                       const_cast<Collection *>(this), get_seq_id_from_key(seq_id_key),
-                                      ref_include_exclude_fields_vec);
+                                      ref_include_exclude_fields_vec, &request_ref_docs);
             if (!prune_op.ok()) {
                 return Option<nlohmann::json>(prune_op.code(), prune_op.error());
             }
@@ -3263,7 +3372,8 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
 
                 const auto& highlighted_text = highlight.snippets.empty() ? value : highlight.snippets[0];
                 facet_value_t facet_value = {value, highlighted_text, facet_count.count,
-                                             facet_count.sort_field_val, parent};
+                                             facet_count.sort_field_val, parent,
+                                             facet_count.count_lower, facet_count.count_upper};
                 facet_values.emplace_back(facet_value);
             }
         }
@@ -3300,6 +3410,11 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
             facet_value_count["highlighted"] = facet_count.highlighted;
             facet_value_count["count"] = facet_count.count;
 
+            if(a_facet.is_sketched) {
+                facet_value_count["count_lower"] = facet_count.count_lower;
+                facet_value_count["count_upper"] = facet_count.count_upper;
+            }
+
             if(!facet_count.parent.empty()) {
                 facet_value_count["parent"] = facet_count.parent;
             }
@@ -3315,7 +3430,7 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
             facet_result["stats"]["avg"] = (a_facet.stats.fvsum / a_facet.stats.fvcount);
         }
 
-        facet_result["stats"]["total_values"] = facet_counts.size();
+        facet_result["stats"]["total_values"] = std::max(facet_counts.size(), a_facet.num_distinct_values);
         result["facet_counts"].push_back(facet_result);
     }
 
@@ -3513,7 +3628,13 @@ Option<bool> Collection::do_union(const std::vector<uint32_t>& collection_ids,
     spp::sparse_hash_set<uint32_t> unique_collection_ids;
     long totalSearchTime = 0;
 
-    for (size_t search_index = 0; search_index < searches.size(); search_index++) {
+    auto search_ops = std::vector<Option<bool>>(size, Option<bool>(true));
+    auto search_time_millis = std::vector<long>(size);
+    auto search_cutoffs = std::vector<uint8_t>(size);
+    uint64_t last_search_begin_us = search_begin_us, last_search_stop_us = search_stop_us;
+
+    // the searches are independent of each other, so they are run concurrently
+    CollectionManager::get_instance().run_searches_concurrently(size, [&](size_t search_index) {
         auto begin = std::chrono::high_resolution_clock::now();
         auto& coll_args = searches[search_index];
         const auto& coll_id = collection_ids[search_index];
@@ -3521,44 +3642,72 @@ Option<bool> Collection::do_union(const std::vector<uint32_t>& collection_ids,
         auto& cm = CollectionManager::get_instance();
         auto coll = cm.get_collection_with_id(coll_id);
         if (coll == nullptr) {
-            return Option<bool>(400, "Collection having `coll_id: " + std::to_string(coll_id) + "` not found.");
+            search_ops[search_index] = Option<bool>(400, "Collection having `coll_id: " + std::to_string(coll_id) +
+                                                         "` not found.");
+            return;
         }
 
-        auto& search_params_guard = search_params_guards[search_index];
-        auto& query = queries[search_index];
-        auto& included_ids = included_ids_list[search_index];
-        auto& include_fields_full = include_fields_full_list[search_index];
-        auto& exclude_fields_full = exclude_fields_full_list[search_index];
-        auto& q_tokens = q_tokens_list[search_index];
-        auto& conversation_standalone_query = conversation_standalone_queries[search_index];
-        auto& vector_query = vector_queries[search_index];
-        auto& facets = facets_list[search_index];
-        auto& per_page = per_pages[search_index];
-        auto& transcribed_query = transcribed_queries[search_index];
-        auto& override_metadata = override_metadata_list[search_index];
-        const auto default_sorting_field_used = coll_args.sort_fields.empty() &&
-                                                !coll->default_sorting_field.empty();
-
-        const auto init_index_search_args_op = coll->init_index_search_args_with_lock(coll_args, search_params_guard, query, included_ids,
-                                                                                      include_fields_full, exclude_fields_full,
-                                                                                      q_tokens, conversation_standalone_query,
-                                                                                      vector_query, facets, per_page,
-                                                                                      transcribed_query, override_metadata,
-                                                                                      true, search_index);
+        const auto init_index_search_args_op = coll->init_index_search_args_with_lock(coll_args,
+                                                                  search_params_guards[search_index],
+                                                                  queries[search_index],
+                                                                  included_ids_list[search_index],
+                                                                  include_fields_full_list[search_index],
+                                                                  exclude_fields_full_list[search_index],
+                                                                  q_tokens_list[search_index],
+                                                                  conversation_standalone_queries[search_index],
+                                                                  vector_queries[search_index],
+                                                                  facets_list[search_index],
+                                                                  per_pages[search_index],
+                                                                  transcribed_queries[search_index],
+                                                                  override_metadata_list[search_index],
+                                                                  true, search_index);
         if (!init_index_search_args_op.ok()) {
-            return init_index_search_args_op;
+            search_ops[search_index] = Option<bool>(init_index_search_args_op.code(), init_index_search_args_op.error());
+            return;
         }
 
-        const auto search_op = coll->run_search_with_lock(search_params_guard.get());
+        search_ops[search_index] = coll->run_search_with_lock(search_params_guards[search_index].get());
+
+        search_time_millis[search_index] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                std::chrono::high_resolution_clock::now() - begin).count();
+        search_cutoffs[search_index] = search_cutoff;
+
+        if (search_index == size - 1) {
+            last_search_begin_us = search_begin_us;
+            last_search_stop_us = search_stop_us;
+        }
+    });
+
+    // the thread local search state is carried over from the threads the searches ran on
+    search_begin_us = last_search_begin_us;
+    search_stop_us = last_search_stop_us;
+    search_cutoff = std::find(search_cutoffs.begin(), search_cutoffs.end(), 1) != search_cutoffs.end();
+
+    for (size_t search_index = 0; search_index < searches.size(); search_index++) {
+        auto& coll_args = searches[search_index];
+        const auto& coll_id = collection_ids[search_index];
+
+        if (!search_ops[search_index].ok()) {
+            return search_ops[search_index];
+        }
 
-        searchTimeMillis.emplace_back(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                            std::chrono::high_resolution_clock::now() - begin).count());
+        searchTimeMillis.emplace_back(search_time_millis[search_index]);
         totalSearchTime += searchTimeMillis.back();
 
-        if (!search_op.ok()) {
-            return search_op;
+        auto& cm = CollectionManager::get_instance();
+        auto coll = cm.get_collection_with_id(coll_id);
+        if (coll == nullptr) {
+            return Option<bool>(400, "Collection having `coll_id: " + std::to_string(coll_id) + "` not found.");
         }
 
+        auto& query = queries[search_index];
+        auto& include_fields_full = include_fields_full_list[search_index];
+        auto& exclude_fields_full = exclude_fields_full_list[search_index];
+        auto& q_tokens = q_tokens_list[search_index];
+        const auto default_sorting_field_used = coll_args.sort_fields.empty() &&
+                                                !coll->default_sorting_field.empty();
+        const auto& search_params_guard = search_params_guards[search_index];
+
         const auto& search_params = search_params_guard;
         const auto& found = search_params->all_result_ids_len;
         total += found;
@@ -3701,6 +3850,7 @@ Option<bool> Collection::do_union(const std::vector<uint32_t>& collection_ids,
     result[hits_key] = nlohmann::json::array();
 
     nlohmann::json docs_array = nlohmann::json::array();
+    request_ref_docs_t request_ref_docs;
 
     for (long kv_index = start_result_index; kv_index <= end_result_index; kv_index++) {
         const auto& kv = union_topster->getKV(kv_index);
@@ -3762,7 +3912,7 @@ Option<bool> Collection::do_union(const std::vector<uint32_t>& collection_ids,
                                   0,
                                   kv->reference_filter_results,
                                   const_cast<Collection *>(coll.get()), get_seq_id_from_key(seq_id_key),
-                                  ref_include_exclude_fields_vec);
+                                  ref_include_exclude_fields_vec, &request_ref_docs);
         if (!prune_op.ok()) {
             return prune_op;
         }
@@ -4029,6 +4179,10 @@ void Collection::populate_text_match_info(nlohmann::json& info, uint64_t match_s
     // [ sign | tokens_matched | max_field_weight | max_field_score  | num_matching_fields ]
     // [   1  |        4       |        8         |      48          |         3           ]  (64 bits)
 
+    // BM25
+    // [ sign | tokens_matched | bm25_score  | num_matching_fields ]
+    // [   1  |        4       |     56      |         3           ]  (64 bits)
+
     auto tokens_matched = extract_bits(match_score, 59, 4);
 
     info["score"] = std::to_string(match_score);
@@ -4040,6 +4194,9 @@ void Collection::populate_text_match_info(nlohmann::json& info, uint64_t match_s
         info["best_field_weight"] = extract_bits(match_score, 3, 8);
         info["num_tokens_dropped"] = total_tokens - tokens_matched;
         info["typo_prefix_score"] = 255 - extract_bits(match_score, 35, 8);
+    } else if(match_type == bm25) {
+        info["bm25_score"] = extract_bits(match_score, 3, 56) / bm25_t::SCORE_SCALE;
+        info["num_tokens_dropped"] = total_tokens - tokens_matched;
     } else {
         info["best_field_weight"] = extract_bits(match_score, 51, 8);
         info["best_field_score"] = std::to_string(extract_bits(match_score, 3, 48));
@@ -4404,6 +4561,23 @@ Option<bool> Collection::get_filter_ids(const std::string& filter_query, filter_
     return index->do_filtering_with_lock(filter_tree_root, filter_result, name, should_timeout, validate_field_names);
 }
 
+Option<bool> Collection::get_approx_filter_ids_length(const std::string& filter_query,
+                                                      uint32_t& approx_filter_ids_length) const {
+    std::shared_lock lock(mutex);
+
+    const std::string doc_id_prefix = std::to_string(collection_id) + "_" + DOC_ID_PREFIX + "_";
+    filter_node_t* filter_tree_root = nullptr;
+    Option<bool> filter_op = filter::parse_filter_query(filter_query, search_schema,
+                                                        store, doc_id_prefix, filter_tree_root);
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    if(!filter_op.ok()) {
+        return filter_op;
+    }
+
+    return index->get_approx_filter_ids_length_with_lock(filter_tree_root, name, approx_filter_ids_length);
+}
+
 Option<bool> Collection::get_related_ids(const std::string& ref_field_name, const uint32_t& seq_id,
                                          std::vector<uint32_t>& result) const {
     return index->get_related_ids(ref_field_name, seq_id, result);
@@ -4930,6 +5104,16 @@ bool Collection::handle_highlight_text(std::string& text, const bool& normalise,
 
     size_t text_len = Tokenizer::is_ascii_char(text[0]) ? text.size() : StringUtils::get_num_chars(text);
 
+    // The position of the first matched token is known from the posting lists, so on long texts that are only
+    // snippeted, the tokens before the snippet can be skipped instead of being tokenized.
+    if(!highlight_fully && !is_arr_obj_ele && !is_infix_search && !use_word_tokenizer &&
+       last_valid_offset_index != -1 && text_len >= snippet_threshold * 6 && text_len/4 <= 64000) {
+        const size_t first_match_offset = match.offsets[0].offset;
+        if(first_match_offset > highlight_affix_num_tokens) {
+            tokenizer.skip_tokens(first_match_offset - highlight_affix_num_tokens);
+        }
+    }
+
     while(tokenizer.next(raw_token, raw_token_index, tok_start, tok_end)) {
         if(use_word_tokenizer) {
             bool found_token = word_tokenizer.tokenize(raw_token);
@@ -5229,6 +5413,7 @@ void Collection::remove_document(nlohmann::json & document, const uint32_t seq_i
 
         store->remove(get_doc_id_key(id));
         store->remove(get_seq_id_key(seq_id));
+        reference_doc_cache.remove(seq_id);
     }
 }
 
@@ -5692,6 +5877,20 @@ Option<bool> Collection::get_document_from_store(const uint32_t& seq_id,
     return get_document_from_store(get_seq_id_key(seq_id), document, raw_doc);
 }
 
+Option<bool> Collection::get_document_json_from_store(const uint32_t& seq_id, std::string& json_doc) const {
+    StoreStatus json_doc_status = store->get(get_seq_id_key(seq_id), json_doc);
+
+    if(json_doc_status != StoreStatus::FOUND) {
+        if(json_doc_status == StoreStatus::NOT_FOUND) {
+            return Option<bool>(404, "Could not locate the JSON document for sequence ID: " + std::to_string(seq_id));
+        }
+
+        return Option<bool>(500, "Error while fetching JSON document for sequence ID: " + std::to_string(seq_id));
+    }
+
+    return Option<bool>(true);
+}
+
 Option<bool> Collection::get_document_from_store(const std::string &seq_id_key,
                                                  nlohmann::json& document, bool raw_doc) const {
     std::string json_doc_str;
@@ -5706,6 +5905,45 @@ Option<bool> Collection::get_document_from_store(const std::string &seq_id_key,
         return Option<bool>(500, "Error while fetching JSON document for sequence ID: " + seq_id);
     }
 
+    return parse_stored_document(json_doc_str, seq_id_key, document, raw_doc);
+}
+
+Option<bool> Collection::get_documents_from_store(const std::vector<uint32_t>& seq_ids,
+                                                  std::vector<nlohmann::json>& documents, bool raw_doc) const {
+    std::vector<std::string> seq_id_keys;
+    seq_id_keys.reserve(seq_ids.size());
+    for(const auto& seq_id: seq_ids) {
+        seq_id_keys.push_back(get_seq_id_key(seq_id));
+    }
+
+    std::vector<std::string> json_doc_strs;
+    std::vector<StoreStatus> json_doc_statuses;
+    store->multi_get(seq_id_keys, json_doc_strs, json_doc_statuses);
+
+    documents.clear();
+    documents.resize(seq_ids.size());
+
+    for(size_t i = 0; i < seq_ids.size(); i++) {
+        if(json_doc_statuses[i] != StoreStatus::FOUND) {
+            const std::string& seq_id = std::to_string(seq_ids[i]);
+            if(json_doc_statuses[i] == StoreStatus::NOT_FOUND) {
+                return Option<bool>(404, "Could not locate the JSON document for sequence ID: " + seq_id);
+            }
+
+            return Option<bool>(500, "Error while fetching JSON document for sequence ID: " + seq_id);
+        }
+
+        auto parse_op = parse_stored_document(json_doc_strs[i], seq_id_keys[i], documents[i], raw_doc);
+        if(!parse_op.ok()) {
+            return parse_op;
+        }
+    }
+
+    return Option<bool>(true);
+}
+
+Option<bool> Collection::parse_stored_document(const std::string& json_doc_str, const std::string& seq_id_key,
+                                               nlohmann::json& document, bool raw_doc) const {
     try {
         document = nlohmann::json::parse(json_doc_str);
     } catch(...) {
@@ -5720,6 +5958,10 @@ Option<bool> Collection::get_document_from_store(const std::string &seq_id_key,
     return Option<bool>(true);
 }
 
+ReferenceDocCache& Collection::get_reference_doc_cache() {
+    return reference_doc_cache;
+}
+
 const Index* Collection::_get_index() const {
     return index;
 }
@@ -6092,6 +6334,9 @@ Option<bool> Collection::batch_alter_data(const std::vector<field>& alter_fields
     index->refresh_schemas({}, del_fields);
     index->refresh_schemas({}, garbage_embedding_fields_vec);
 
+    // stored documents and the fields they are pruned to might have changed
+    reference_doc_cache.clear();
+
     auto persist_op = persist_collection_meta();
     if(!persist_op.ok()) {
         return persist_op;
@@ -6232,7 +6477,8 @@ Option<bool> Collection::prune_doc(nlohmann::json& doc,
                                    const std::string& parent_name, size_t depth,
                                    const std::map<std::string, reference_filter_result_t>& reference_filter_results,
                                    Collection *const collection, const uint32_t& seq_id,
-                                   const std::vector<ref_include_exclude_fields>& ref_include_exclude_fields_vec) {
+                                   const std::vector<ref_include_exclude_fields>& ref_include_exclude_fields_vec,
+                                   request_ref_docs_t* const request_ref_docs) {
     nlohmann::json original_doc;
     if (!ref_include_exclude_fields_vec.empty()) {
         original_doc = doc;
@@ -6314,7 +6560,7 @@ Option<bool> Collection::prune_doc(nlohmann::json& doc,
     }
 
     return Join::include_references(doc, seq_id, collection, reference_filter_results, ref_include_exclude_fields_vec,
-                                    original_doc);
+                                    original_doc, request_ref_docs);
 }
 
 Option<bool> Collection::validate_alter_payload(nlohmann::json& schema_changes,
@@ -7528,8 +7774,8 @@ Option<bool> Collection::parse_and_validate_vector_query(const std::string& vect
                 }
             }
 
-            std::string embed_query = embedder_manager.get_query_prefix(vector_field_it.value().embed[fields::model_config]) + q;
-            auto embedding_op = embedder->Embed(embed_query, remote_embedding_timeout_ms, remote_embedding_num_tries);
+            auto embedding_op = embedder_manager.embed_query(embedder, vector_field_it.value().embed[fields::model_config], q,
+                                                             remote_embedding_timeout_ms, remote_embedding_num_tries);
 
             if(!embedding_op.success) {
                 if(embedding_op.error.contains("error")) {
@@ -7576,6 +7822,14 @@ Option<bool> Collection::parse_and_validate_vector_query(const std::string& vect
             }
         }
 
+        else if(vector_field_it.value().multi_vector) {
+            // the query of a multi-vector field can hold several vectors
+            if(vector_query.values.empty() || vector_query.values.size() % vector_field_it.value().num_dim != 0) {
+                return Option<bool>(400, "Query field `" + vector_query.field_name + "` must have a multiple of " +
+                                         std::to_string(vector_field_it.value().num_dim) + " dimensions.");
+            }
+        }
+
         else if(vector_field_it.value().num_dim != vector_query.values.size()) {
             return Option<bool>(400, "Query field `" + vector_query.field_name + "` must have " +
                                                 std::to_string(vector_field_it.value().num_dim) + " dimensions.");
@@ -7733,6 +7987,7 @@ Option<bool> collection_search_args_t::init(std::map<std::string, std::string>&
     token_ordering token_order = NOT_SET;
 
     std::vector<std::string> facet_return_parent;
+    std::vector<std::string> disjunctive_facets;
 
     std::string vector_query;
 
@@ -7875,6 +8130,7 @@ Option<bool> collection_search_args_t::init(std::map<std::string, std::string>&
             {INCLUDE_FIELDS, &include_fields_vec},
             {EXCLUDE_FIELDS, &exclude_fields_vec},
             {FACET_RETURN_PARENT, &facet_return_parent},
+            {DISJUNCTIVE_FACETS, &disjunctive_facets},
     };
 
     std::unordered_map<std::string, std::vector<uint32_t>*> int_list_values = {
@@ -8048,7 +8304,8 @@ Option<bool> collection_search_args_t::init(std::map<std::string, std::string>&
                                     override_tags, voice_query, enable_typos_for_numerical_tokens,
                                     enable_synonyms, synonym_prefix, synonym_num_typos, enable_lazy_filter,
                                     enable_typos_for_alpha_numerical_tokens, max_filter_by_candidates,
-                                    rerank_hybrid_matches, enable_analytics, validate_field_names);
+                                    rerank_hybrid_matches, enable_analytics, validate_field_names,
+                                    disjunctive_facets);
     return Option<bool>(true);
 }
 
@@ -149,6 +149,9 @@ Collection* CollectionManager::init_collection(const nlohmann::json & collection
             f.sort = field_obj[fields::sort];
         }
 
+        f.multi_vector = field_obj.count(fields::multi_vector) != 0 && field_obj[fields::multi_vector].get<bool>();
+        f.bm25 = field_obj.count(fields::bm25) != 0 && field_obj[fields::bm25].get<bool>();
+
         fields.push_back(f);
     }
 
@@ -305,7 +308,8 @@ void CollectionManager::_populate_referenced_ins(const std::string& collection_m
     }
 }
 
-Option<bool> CollectionManager::load(const size_t collection_batch_size, const size_t document_batch_size) {
+Option<bool> CollectionManager::load(const size_t collection_batch_size, const size_t document_batch_size,
+                                     std::vector<Collection*>* built_collections) {
     // This function must be idempotent, i.e. when called multiple times, must produce the same state without leaks
     LOG(INFO) << "CollectionManager::load()";
 
@@ -343,13 +347,102 @@ Option<bool> CollectionManager::load(const size_t collection_batch_size, const s
     }
     delete iter;
 
+    if(built_collections != nullptr) {
+        install_collections(*built_collections);
+    } else {
+        auto load_op = load_collections(store, next_coll_id_status, collection_batch_size, document_batch_size,
+                                        nullptr);
+        if(!load_op.ok()) {
+            return load_op;
+        }
+    }
+
+    // load presets
+
+    std::string preset_prefix_key = std::string(PRESET_PREFIX) + "_";
+    std::string preset_upper_bound_key = std::string(PRESET_PREFIX) + "`"; // cannot inline this
+    rocksdb::Slice preset_upper_bound(preset_upper_bound_key);
+
+    iter = store->scan(preset_prefix_key, &preset_upper_bound);
+    while(iter->Valid() && iter->key().starts_with(preset_prefix_key)) {
+        std::string preset_name = iter->key().ToString().substr(preset_prefix_key.size());
+        nlohmann::json preset_obj = nlohmann::json::parse(iter->value().ToString(), nullptr, false);
+
+        if(!preset_obj.is_discarded() && preset_obj.is_object()) {
+            preset_configs[preset_name] = preset_obj;
+        } else {
+            LOG(INFO) << "Invalid value for preset " << preset_name;
+        }
+
+        iter->Next();
+    }
+    delete iter;
+
+    //load stopwords
+    std::string stopword_prefix_key = std::string(StopwordsManager::STOPWORD_PREFIX) + "_";
+    std::string stopword_upper_bound_key = std::string(StopwordsManager::STOPWORD_PREFIX) + "`"; // cannot inline this
+    rocksdb::Slice stopword_upper_bound(stopword_upper_bound_key);
+
+    iter = store->scan(stopword_prefix_key, &stopword_upper_bound);
+    while(iter->Valid() && iter->key().starts_with(stopword_prefix_key)) {
+        std::string stopword_name = iter->key().ToString().substr(stopword_prefix_key.size());
+        nlohmann::json stopword_obj = nlohmann::json::parse(iter->value().ToString(), nullptr, false);
+
+        if(!stopword_obj.is_discarded() && stopword_obj.is_object()) {
+            StopwordsManager::get_instance().upsert_stopword(stopword_name, stopword_obj);
+        } else {
+            LOG(INFO) << "Invalid object for stopword " << stopword_name;
+        }
+
+        iter->Next();
+    }
+    delete iter;
+
+    // load stemming dictionaries
+    std::string stemming_dictionary_prefix_key = std::string(StemmerManager::STEMMING_DICTIONARY_PREFIX) + "_";
+    std::string stemming_dictionary_upper_bound_key = std::string(StemmerManager::STEMMING_DICTIONARY_PREFIX) + "`";
+    rocksdb::Slice stemming_dictionary_upper_bound(stemming_dictionary_upper_bound_key);
+
+    iter = store->scan(stemming_dictionary_prefix_key, &stemming_dictionary_upper_bound);
+    while(iter->Valid() && iter->key().starts_with(stemming_dictionary_prefix_key)) {
+        std::string stemming_dictionary_name = iter->key().ToString().substr(stemming_dictionary_prefix_key.size());
+        nlohmann::json stemming_dictionary_obj = nlohmann::json::parse(iter->value().ToString(), nullptr, false);
+
+        if(!stemming_dictionary_obj.is_discarded() && stemming_dictionary_obj.is_object()) {
+            StemmerManager::get_instance().load_stemming_dictioary(stemming_dictionary_obj);
+        } else {
+            LOG(INFO) << "Invalid object for stemming dictionary " << stemming_dictionary_name;
+        }
+
+        iter->Next();
+    }
+    delete iter;
+
+    // restore query suggestions configs
+    std::vector<std::string> analytics_config_jsons;
+    store->scan_fill(AnalyticsManager::ANALYTICS_RULE_PREFIX,
+                     std::string(AnalyticsManager::ANALYTICS_RULE_PREFIX) + "`",
+                     analytics_config_jsons);
+
+    for(const auto& analytics_config_json: analytics_config_jsons) {
+        nlohmann::json analytics_config = nlohmann::json::parse(analytics_config_json);
+        AnalyticsManager::get_instance().create_rule(analytics_config, false, false);
+    }
+
+    return Option<bool>(true);
+}
+
+Option<bool> CollectionManager::load_collections(Store* source_store, const StoreStatus& next_coll_id_status,
+                                                 const size_t collection_batch_size,
+                                                 const size_t document_batch_size,
+                                                 std::vector<Collection*>* built_collections) {
     LOG(INFO) << "Loading upto " << collection_batch_size << " collections in parallel, "
               << document_batch_size << " documents at a time.";
 
     std::vector<std::string> collection_meta_jsons;
-    store->scan_fill(std::string(Collection::COLLECTION_META_PREFIX) + "_",
-                     std::string(Collection::COLLECTION_META_PREFIX) + "`",
-                     collection_meta_jsons);
+    source_store->scan_fill(std::string(Collection::COLLECTION_META_PREFIX) + "_",
+                            std::string(Collection::COLLECTION_META_PREFIX) + "`",
+                            collection_meta_jsons);
 
     const size_t num_collections = collection_meta_jsons.size();
     LOG(INFO) << "Found " << num_collections << " collection(s) on disk.";
@@ -369,6 +462,10 @@ Option<bool> CollectionManager::load(const size_t collection_batch_size, const s
     std::condition_variable cv_process;
     std::string collection_name;
 
+    // each collection is built into its own slot, so that no locking is needed while building
+    std::vector<Collection*> staged_collections(built_collections != nullptr ? num_collections : 0, nullptr);
+    std::atomic<bool> build_failed = false;
+
     for(size_t coll_index = 0; coll_index < num_collections; coll_index++) {
         const auto& collection_meta_json = collection_meta_jsons[coll_index];
         nlohmann::json collection_meta = nlohmann::json::parse(collection_meta_json, nullptr, false);
@@ -384,9 +481,11 @@ Option<bool> CollectionManager::load(const size_t collection_batch_size, const s
         }
 
         auto captured_store = store;
-        loading_pool.enqueue([captured_store, num_collections, collection_meta, document_batch_size,
+        Collection** built_collection = built_collections != nullptr ? &staged_collections[coll_index] : nullptr;
+        loading_pool.enqueue([captured_store, source_store, num_collections, collection_meta, document_batch_size,
                               &m_process, &cv_process, &num_processed, &next_coll_id_status, quit = quit,
-                                     &referenced_ins, &async_referenced_ins, collection_name]() {
+                                     &referenced_ins, &async_referenced_ins, collection_name,
+                                     built_collection, &build_failed]() {
 
             spp::sparse_hash_map<std::string, std::string> referenced_in;
             auto const& it = referenced_ins.find(collection_name);
@@ -402,12 +501,16 @@ Option<bool> CollectionManager::load(const size_t collection_batch_size, const s
 
             //auto begin = std::chrono::high_resolution_clock::now();
             Option<bool> res = load_collection(collection_meta, document_batch_size, next_coll_id_status, *quit,
-                                               referenced_in, async_referenced_in);
+                                               referenced_in, async_referenced_in, source_store, built_collection);
             /*long long int timeMillis =
                     std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin).count();
             LOG(INFO) << "Time taken for indexing: " << timeMillis << "ms";*/
 
-            if(!res.ok()) {
+            if(!res.ok() && built_collection != nullptr) {
+                // the live collections are still intact, so the caller can fall back to a regular load
+                LOG(ERROR) << "Error while building collection. " << res.error();
+                build_failed = true;
+            } else if(!res.ok()) {
                 LOG(ERROR) << "Error while loading collection. " << res.error();
                 LOG(ERROR) << "Typesense is quitting.";
                 captured_store->close();
@@ -434,83 +537,87 @@ Option<bool> CollectionManager::load(const size_t collection_batch_size, const s
         // return num_processed == 1;
     });
 
-    // load presets
-
-    std::string preset_prefix_key = std::string(PRESET_PREFIX) + "_";
-    std::string preset_upper_bound_key = std::string(PRESET_PREFIX) + "`"; // cannot inline this
-    rocksdb::Slice preset_upper_bound(preset_upper_bound_key);
-
-    iter = store->scan(preset_prefix_key, &preset_upper_bound);
-    while(iter->Valid() && iter->key().starts_with(preset_prefix_key)) {
-        std::string preset_name = iter->key().ToString().substr(preset_prefix_key.size());
-        nlohmann::json preset_obj = nlohmann::json::parse(iter->value().ToString(), nullptr, false);
+    loading_pool.shutdown();
 
-        if(!preset_obj.is_discarded() && preset_obj.is_object()) {
-            preset_configs[preset_name] = preset_obj;
-        } else {
-            LOG(INFO) << "Invalid value for preset " << preset_name;
+    if(built_collections != nullptr) {
+        for(auto collection: staged_collections) {
+            if(build_failed) {
+                delete collection;
+            } else if(collection != nullptr) {
+                built_collections->push_back(collection);
+            }
         }
 
-        iter->Next();
+        if(build_failed) {
+            return Option<bool>(500, "Error while building collections.");
+        }
     }
-    delete iter;
 
-    //load stopwords
-    std::string stopword_prefix_key = std::string(StopwordsManager::STOPWORD_PREFIX) + "_";
-    std::string stopword_upper_bound_key = std::string(StopwordsManager::STOPWORD_PREFIX) + "`"; // cannot inline this
-    rocksdb::Slice stopword_upper_bound(stopword_upper_bound_key);
+    LOG(INFO) << "Loaded " << num_collections << " collection(s).";
 
-    iter = store->scan(stopword_prefix_key, &stopword_upper_bound);
-    while(iter->Valid() && iter->key().starts_with(stopword_prefix_key)) {
-        std::string stopword_name = iter->key().ToString().substr(stopword_prefix_key.size());
-        nlohmann::json stopword_obj = nlohmann::json::parse(iter->value().ToString(), nullptr, false);
+    return Option<bool>(true);
+}
 
-        if(!stopword_obj.is_discarded() && stopword_obj.is_object()) {
-            StopwordsManager::get_instance().upsert_stopword(stopword_name, stopword_obj);
-        } else {
-            LOG(INFO) << "Invalid object for stopword " << stopword_name;
-        }
+Option<bool> CollectionManager::build_collections(Store* source_store, const size_t collection_batch_size,
+                                                  const size_t document_batch_size,
+                                                  std::vector<Collection*>& built_collections) {
+    std::string next_collection_id_str;
+    StoreStatus next_coll_id_status = source_store->get(NEXT_COLLECTION_ID_KEY, next_collection_id_str);
 
-        iter->Next();
+    if(next_coll_id_status == StoreStatus::ERROR) {
+        return Option<bool>(500, "Error while fetching the next collection id from the disk.");
     }
-    delete iter;
 
-    // load stemming dictionaries
-    std::string stemming_dictionary_prefix_key = std::string(StemmerManager::STEMMING_DICTIONARY_PREFIX) + "_";
-    std::string stemming_dictionary_upper_bound_key = std::string(StemmerManager::STEMMING_DICTIONARY_PREFIX) + "`";
-    rocksdb::Slice stemming_dictionary_upper_bound(stemming_dictionary_upper_bound_key);
+    // references are resolved against the live collections while indexing, so such collections can't be built aside
+    std::vector<std::string> collection_meta_jsons;
+    source_store->scan_fill(std::string(Collection::COLLECTION_META_PREFIX) + "_",
+                            std::string(Collection::COLLECTION_META_PREFIX) + "`",
+                            collection_meta_jsons);
 
-    iter = store->scan(stemming_dictionary_prefix_key, &stemming_dictionary_upper_bound);
-    while(iter->Valid() && iter->key().starts_with(stemming_dictionary_prefix_key)) {
-        std::string stemming_dictionary_name = iter->key().ToString().substr(stemming_dictionary_prefix_key.size());
-        nlohmann::json stemming_dictionary_obj = nlohmann::json::parse(iter->value().ToString(), nullptr, false);
+    std::map<std::string, spp::sparse_hash_map<std::string, std::string>> referenced_ins;
+    std::map<std::string, spp::sparse_hash_map<std::string, std::set<reference_pair_t>>> async_referenced_ins;
+    for(const auto& collection_meta_json: collection_meta_jsons) {
+        _populate_referenced_ins(collection_meta_json, referenced_ins, async_referenced_ins);
+    }
 
-        if(!stemming_dictionary_obj.is_discarded() && stemming_dictionary_obj.is_object()) {
-            StemmerManager::get_instance().load_stemming_dictioary(stemming_dictionary_obj);
-        } else {
-            LOG(INFO) << "Invalid object for stemming dictionary " << stemming_dictionary_name;
-        }
+    if(!referenced_ins.empty() || !async_referenced_ins.empty()) {
+        return Option<bool>(400, "Collections with references cannot be built in the background.");
+    }
 
-        iter->Next();
+    return load_collections(source_store, next_coll_id_status, collection_batch_size, document_batch_size,
+                            &built_collections);
+}
+
+void CollectionManager::install_collections(std::vector<Collection*>& built_collections) {
+    std::vector<Collection*> old_collections;
+
+    std::unique_lock lock(mutex);
+
+    for(auto& name_collection: collections) {
+        old_collections.push_back(name_collection.second);
     }
-    delete iter;
 
-    // restore query suggestions configs
-    std::vector<std::string> analytics_config_jsons;
-    store->scan_fill(AnalyticsManager::ANALYTICS_RULE_PREFIX,
-                     std::string(AnalyticsManager::ANALYTICS_RULE_PREFIX) + "`",
-                     analytics_config_jsons);
+    collections.clear();
+    collection_id_names.clear();
 
-    for(const auto& analytics_config_json: analytics_config_jsons) {
-        nlohmann::json analytics_config = nlohmann::json::parse(analytics_config_json);
-        AnalyticsManager::get_instance().create_rule(analytics_config, false, false);
+    for(auto collection: built_collections) {
+        collections.emplace(collection->get_name(), collection);
+        collection_id_names.emplace(collection->get_collection_id(), collection->get_name());
     }
 
-    LOG(INFO) << "Loaded " << num_collections << " collection(s).";
+    lock.unlock();
 
-    loading_pool.shutdown();
+    LOG(INFO) << "Swapped in " << built_collections.size() << " collection(s).";
+    built_collections.clear();
 
-    return Option<bool>(true);
+    for(auto collection: old_collections) {
+        for(const auto& embedding_field : collection->get_embedding_fields()) {
+            const auto& model_name = embedding_field.embed[fields::model_config]["model_name"].get<std::string>();
+            process_embedding_field_delete(model_name);
+        }
+
+        delete collection;
+    }
 }
 
 
@@ -1179,7 +1286,8 @@ bool CollectionManager::parse_sort_by_str(std::string sort_by_str, std::vector<s
     return true;
 }
 
-Option<bool> apply_embedded_params(nlohmann::json& embedded_params, std::map<std::string, std::string>& req_params) {
+Option<bool> CollectionManager::apply_embedded_params(nlohmann::json& embedded_params,
+                                                      std::map<std::string, std::string>& req_params) {
     // enrich params with values from embedded params
     for(auto& item: embedded_params.items()) {
         if(item.key() == "expires_at") {
@@ -1458,6 +1566,57 @@ ThreadPool* CollectionManager::get_thread_pool() const {
     return thread_pool;
 }
 
+void CollectionManager::set_search_thread_pool(ThreadPool* search_thread_pool) {
+    std::unique_lock lock(mutex);
+    this->search_thread_pool = search_thread_pool;
+}
+
+void CollectionManager::run_searches_concurrently(size_t num_searches,
+                                                  const std::function<void(size_t)>& run_search) const {
+    ThreadPool* pool;
+
+    {
+        std::shared_lock lock(mutex);
+        pool = search_thread_pool;
+    }
+
+    if(pool == nullptr || num_searches < 2) {
+        for(size_t i = 0; i < num_searches; i++) {
+            run_search(i);
+        }
+        return ;
+    }
+
+    struct searches_state_t {
+        std::atomic<size_t> next_index = 0;
+        std::mutex m_process;
+        std::condition_variable cv_process;
+        size_t num_processed = 0;
+    };
+
+    // helpers that get to run only after all searches are claimed return without touching `run_search`
+    auto state = std::make_shared<searches_state_t>();
+    auto process_searches = [state, num_searches, &run_search]() {
+        size_t index;
+        while((index = state->next_index++) < num_searches) {
+            run_search(index);
+
+            std::unique_lock<std::mutex> lock(state->m_process);
+            state->num_processed++;
+            state->cv_process.notify_one();
+        }
+    };
+
+    for(size_t i = 0; i + 1 < num_searches; i++) {
+        pool->enqueue(process_searches);
+    }
+
+    process_searches();
+
+    std::unique_lock<std::mutex> lock_process(state->m_process);
+    state->cv_process.wait(lock_process, [&](){ return state->num_processed == num_searches; });
+}
+
 Option<nlohmann::json> CollectionManager::get_collection_summaries(uint32_t limit, uint32_t offset,
                                                                    const std::vector<std::string>& exclude_fields,
                                                                    const std::vector<std::string>& api_key_collections) const {
@@ -1637,10 +1796,15 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
                                                 const StoreStatus& next_coll_id_status,
                                                 const std::atomic<bool>& quit,
                                                 spp::sparse_hash_map<std::string, std::string>& referenced_in,
-                                                spp::sparse_hash_map<std::string, std::set<reference_pair_t>>& async_referenced_ins) {
+                                                spp::sparse_hash_map<std::string, std::set<reference_pair_t>>& async_referenced_ins,
+                                                Store* source_store,
+                                                Collection** built_collection) {
 
     auto& cm = CollectionManager::get_instance();
 
+    // a collection that is being built aside is read from `source_store`, but is bound to the main store
+    Store* const from_store = (source_store != nullptr) ? source_store : cm.store;
+
     if(!collection_meta.contains(Collection::COLLECTION_NAME_KEY)) {
         return Option<bool>(500, "No collection name in collection meta: " + collection_meta.dump());
     }
@@ -1653,7 +1817,7 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
     const std::string & this_collection_name = collection_meta[Collection::COLLECTION_NAME_KEY].get<std::string>();
 
     std::string collection_next_seq_id_str;
-    StoreStatus next_seq_id_status = cm.store->get(Collection::get_next_seq_id_key(this_collection_name),
+    StoreStatus next_seq_id_status = from_store->get(Collection::get_next_seq_id_key(this_collection_name),
                                                 collection_next_seq_id_str);
 
     if(next_seq_id_status == StoreStatus::ERROR) {
@@ -1671,7 +1835,7 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
     uint32_t collection_next_seq_id = next_seq_id_status == StoreStatus::NOT_FOUND ? 0 :
                                       StringUtils::deserialize_uint32_t(collection_next_seq_id_str);
 
-    {
+    if(built_collection == nullptr) {
         std::shared_lock lock(cm.mutex);
         Collection *existing_collection = cm.get_collection_unsafe(this_collection_name);
 
@@ -1690,9 +1854,9 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
 
     // initialize overrides
     std::vector<std::string> collection_override_jsons;
-    cm.store->scan_fill(Collection::get_override_key(this_collection_name, ""),
-                        std::string(Collection::COLLECTION_OVERRIDE_PREFIX) + "_" + this_collection_name + "`",
-                        collection_override_jsons);
+    from_store->scan_fill(Collection::get_override_key(this_collection_name, ""),
+                          std::string(Collection::COLLECTION_OVERRIDE_PREFIX) + "_" + this_collection_name + "`",
+                          collection_override_jsons);
 
     for(const auto & collection_override_json: collection_override_jsons) {
         nlohmann::json collection_override = nlohmann::json::parse(collection_override_json);
@@ -1708,9 +1872,9 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
 
     // initialize synonyms
     std::vector<std::string> collection_synonym_jsons;
-    cm.store->scan_fill(SynonymIndex::get_synonym_key(this_collection_name, ""),
-                        std::string(SynonymIndex::COLLECTION_SYNONYM_PREFIX) + "_" + this_collection_name + "`",
-                        collection_synonym_jsons);
+    from_store->scan_fill(SynonymIndex::get_synonym_key(this_collection_name, ""),
+                          std::string(SynonymIndex::COLLECTION_SYNONYM_PREFIX) + "_" + this_collection_name + "`",
+                          collection_synonym_jsons);
 
     for(const auto & collection_synonym_json: collection_synonym_jsons) {
         nlohmann::json collection_synonym = nlohmann::json::parse(collection_synonym_json);
@@ -1722,7 +1886,7 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
     std::string upper_bound_key = collection->get_seq_id_collection_prefix() + "`";  // cannot inline this
     rocksdb::Slice upper_bound(upper_bound_key);
 
-    rocksdb::Iterator* iter = cm.store->scan(seq_id_prefix, &upper_bound);
+    rocksdb::Iterator* iter = from_store->scan(seq_id_prefix, &upper_bound);
     std::unique_ptr<rocksdb::Iterator> iter_guard(iter);
 
     std::vector<index_record> index_records;
@@ -1745,6 +1909,9 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
             document = nlohmann::json::parse(doc_string);
         } catch(const std::exception& e) {
             LOG(ERROR) << "JSON error: " << e.what();
+            if(built_collection != nullptr) {
+                delete collection;
+            }
             return Option<bool>(400, "Bad JSON.");
         }
 
@@ -1803,7 +1970,11 @@ Option<bool> CollectionManager::load_collection(const nlohmann::json &collection
         }
     }
 
-    cm.add_to_collections(collection);
+    if(built_collection != nullptr) {
+        *built_collection = collection;
+    } else {
+        cm.add_to_collections(collection);
+    }
 
     LOG(INFO) << "Indexed " << num_indexed_docs << "/" << num_found_docs
               << " documents into collection " << collection->get_name();
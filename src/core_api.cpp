@@ -12,6 +12,9 @@
 #include "system_metrics.h"
 #include "logger.h"
 #include "core_api_utils.h"
+#include "shard_search.h"
+#include "query_admission.h"
+#include "query_embedding_cache.h"
 #include "lru/lru.hpp"
 #include "ratelimit_manager.h"
 #include "event_manager.h"
@@ -112,13 +115,13 @@ void stream_response(const std::shared_ptr<http_req>& req, const std::shared_ptr
     res->wait();
 
     auto req_res = new async_req_res_t(req, res, true);
-    server->get_message_dispatcher()->send_message(HttpServer::STREAM_RESPONSE_MESSAGE, req_res);
+    server->get_message_dispatcher(req)->send_message(HttpServer::STREAM_RESPONSE_MESSAGE, req_res);
 }
 
 void defer_processing(const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res, size_t timeout_ms) {
     defer_processing_t* defer = new defer_processing_t(req, res, timeout_ms, server);
     //LOG(INFO) << "core_api req " << req.get() << ", use count: " << req.use_count();
-    server->get_message_dispatcher()->send_message(HttpServer::DEFER_PROCESSING_MESSAGE, defer);
+    server->get_message_dispatcher(req)->send_message(HttpServer::DEFER_PROCESSING_MESSAGE, defer);
 }
 
 // we cannot return errors here because that will end up as auth failure and won't convey
@@ -480,6 +483,8 @@ bool get_metrics_json(const std::shared_ptr<http_req>& req, const std::shared_pt
     const std::string & data_dir_path = collectionManager.get_store()->get_state_dir_path();
 
     SystemMetrics::get_instance().get(data_dir_path, result);
+    QueryEmbeddingCache::get_instance().get_metrics(result);
+    QueryAdmission::get_instance().get_metrics(result);
 
     res->set_body(200, result.dump(2));
     return true;
@@ -553,9 +558,20 @@ bool get_search(const std::shared_ptr<http_req>& req, const std::shared_ptr<http
         return false;
     }
 
+    const uint64_t search_cost = QueryAdmission::estimate_search_cost(req->params, req->embedded_params_vec[0]);
+    query_admission_guard_t admission_guard(req->api_auth_key, search_cost);
+    if(!admission_guard.status.ok()) {
+        res->set(admission_guard.status.code(), admission_guard.status.error());
+        req->overloaded = true;
+        return false;
+    }
+
     std::string results_json_str;
-    Option<bool> search_op = CollectionManager::do_search(req->params, req->embedded_params_vec[0],
-                                                          results_json_str, req->conn_ts);
+    Option<bool> search_op = ShardSearch::get_shard_nodes().empty() ?
+                             CollectionManager::do_search(req->params, req->embedded_params_vec[0],
+                                                          results_json_str, req->conn_ts) :
+                             ShardSearch::search(req->params, req->embedded_params_vec[0], req->api_auth_key,
+                                                 results_json_str, req->conn_ts);
 
     if(!search_op.ok()) {
         res->set(search_op.code(), search_op.error());
@@ -764,6 +780,24 @@ bool post_multi_search(const std::shared_ptr<http_req>& req, const std::shared_p
         }
     }
 
+    uint64_t searches_cost = 0;
+    if(QueryAdmission::get_instance().is_enabled()) {
+        for(size_t i = 0; i < searches.size(); i++) {
+            auto search_req_params = orig_req_params;
+            if(multi_search_validate_and_add_params(search_req_params, searches[i], conversation).ok()) {
+                searches_cost += QueryAdmission::estimate_search_cost(search_req_params,
+                                                                      req->embedded_params_vec[i]);
+            }
+        }
+    }
+
+    query_admission_guard_t admission_guard(req->api_auth_key, searches_cost);
+    if(!admission_guard.status.ok()) {
+        res->set(admission_guard.status.code(), admission_guard.status.error());
+        req->overloaded = true;
+        return false;
+    }
+
     if (searches.size() > 1 && is_union) {
         Option<bool> union_op = CollectionManager::do_union(req->params, req->embedded_params_vec, searches,
                                                             response, req->conn_ts);
@@ -775,19 +809,49 @@ bool post_multi_search(const std::shared_ptr<http_req>& req, const std::shared_p
     } else {
         response["results"] = nlohmann::json::array();
 
-        for(size_t i = 0; i < searches.size(); i++) {
-            auto& search_params = searches[i];
-            req->params = orig_req_params;
+        std::vector<std::map<std::string, std::string>> search_req_params_list(searches.size(), orig_req_params);
+
+        // a search identical to an earlier one in the request is not run again but reuses its results
+        std::vector<size_t> search_indices(searches.size());
+        std::vector<size_t> unique_search_indices;
+        std::unordered_map<std::string, size_t> search_keys;
 
-            auto validate_op = multi_search_validate_and_add_params(req->params, search_params, conversation);
+        for(size_t i = 0; i < searches.size(); i++) {
+            auto validate_op = multi_search_validate_and_add_params(search_req_params_list[i], searches[i],
+                                                                    conversation);
             if (!validate_op.ok()) {
                 res->set_400(validate_op.error());
                 return false;
             }
 
-            std::string results_json_str;
-            Option<bool> search_op = CollectionManager::do_search(req->params, req->embedded_params_vec[i],
-                                                                  results_json_str, req->conn_ts);
+            const std::string search_key = nlohmann::json(search_req_params_list[i]).dump() +
+                                           req->embedded_params_vec[i].dump();
+
+            auto search_key_it = search_keys.emplace(search_key, unique_search_indices.size()).first;
+            if(search_key_it->second == unique_search_indices.size()) {
+                unique_search_indices.push_back(i);
+            }
+
+            search_indices[i] = search_key_it->second;
+        }
+
+        std::vector<std::string> results_json_strs(unique_search_indices.size());
+        std::vector<Option<bool>> search_ops(unique_search_indices.size(), Option<bool>(true));
+
+        // all searches share the deadline of the request, since their search time is measured from `conn_ts`
+        CollectionManager::get_instance().run_searches_concurrently(unique_search_indices.size(), [&](size_t u) {
+            const size_t i = unique_search_indices[u];
+            search_ops[u] = CollectionManager::do_search(search_req_params_list[i], req->embedded_params_vec[i],
+                                                         results_json_strs[u], req->conn_ts);
+        });
+
+        if(!searches.empty()) {
+            req->params = search_req_params_list[unique_search_indices[search_indices.back()]];
+        }
+
+        for(size_t i = 0; i < searches.size(); i++) {
+            const auto& search_op = search_ops[search_indices[i]];
+            const auto& results_json_str = results_json_strs[search_indices[i]];
 
             if(search_op.ok()) {
                 auto results_json = nlohmann::json::parse(results_json_str);
@@ -1051,7 +1115,8 @@ bool get_export_documents(const std::shared_ptr<http_req>& req, const std::share
         collection->populate_include_exclude_fields_lk(include_fields, exclude_fields,
                                                       export_state->include_fields, export_state->exclude_fields);
 
-        if(req->params.count(BATCH_SIZE) != 0 && StringUtils::is_uint32_t(req->params[BATCH_SIZE])) {
+        if(req->params.count(BATCH_SIZE) != 0 && StringUtils::is_uint32_t(req->params[BATCH_SIZE]) &&
+           std::stoul(req->params[BATCH_SIZE]) != 0) {
             export_state->export_batch_size = std::stoul(req->params[BATCH_SIZE]);
         }
 
@@ -1084,57 +1149,39 @@ bool get_export_documents(const std::shared_ptr<http_req>& req, const std::share
 
     if(export_state->it != nullptr) {
         rocksdb::Iterator* it = export_state->it;
-        size_t batch_counter = 0;
         std::string().swap(res->body);
 
-        while(it->Valid() && it->key().ToString().compare(0, seq_id_prefix.size(), seq_id_prefix) == 0) {
-            nlohmann::json doc = nlohmann::json::parse(it->value().ToString());
-            Collection::remove_flat_fields(doc);
-            Collection::remove_reference_helper_fields(doc);
-
-            if(export_state->include_fields.empty() && export_state->exclude_fields.empty()) {
-                res->body += doc.dump();
-            } else {
-                if (doc.count("id") == 0 || !doc.at("id").is_string()) {
-                    res->set(500, "Could not find `id` field in the document: " + doc.dump());
-                    req->last_chunk_aggregate = true;
-                    res->final = true;
-                    stream_response(req, res);
-                    return false;
-                }
-
-                auto const& coll = export_state->collection;
-                auto const seq_id_op = coll->doc_id_to_seq_id_with_lock(doc.at("id"));
-                if (!seq_id_op.ok()) {
-                    res->set(seq_id_op.code(), seq_id_op.error());
-                    req->last_chunk_aggregate = true;
-                    res->final = true;
-                    stream_response(req, res);
-                    return false;
-                }
-
-                std::map<std::string, reference_filter_result_t> references = {};
-                coll->prune_doc_with_lock(doc, export_state->include_fields, export_state->exclude_fields,
-                                          references, seq_id_op.get(), export_state->ref_include_exclude_fields_vec);
-                res->body += doc.dump();
-            }
+        // the store is read sequentially, while the documents of the batch are serialized in parallel
+        std::vector<uint32_t> seq_ids;
+        std::vector<std::string> json_docs;
 
+        while(seq_ids.size() < export_state->export_batch_size && it->Valid() &&
+              it->key().starts_with(seq_id_prefix)) {
+            seq_ids.push_back(Collection::get_seq_id_from_key(it->key().ToString()));
+            json_docs.push_back(it->value().ToString());
             it->Next();
+        }
 
-            // append a new line character if there is going to be one more record to send
-            if(it->Valid() && it->key().ToString().compare(0, seq_id_prefix.size(), seq_id_prefix) == 0) {
-                res->body += "\n";
-                req->last_chunk_aggregate = false;
-                res->final = false;
-            } else {
-                req->last_chunk_aggregate = true;
-                res->final = true;
-            }
+        auto export_op = append_export_docs(export_state, seq_ids, json_docs, nullptr, res->body);
+        if(!export_op.ok()) {
+            res->set(export_op.code(), export_op.error());
+            req->last_chunk_aggregate = true;
+            res->final = true;
+            stream_response(req, res);
+            return false;
+        }
 
-            batch_counter++;
-            if(batch_counter == export_state->export_batch_size) {
-                break;
+        if(it->Valid() && it->key().starts_with(seq_id_prefix)) {
+            req->last_chunk_aggregate = false;
+            res->final = false;
+        } else {
+            // should not have a trailing newline character for the last line
+            if(!res->body.empty()) {
+                res->body.pop_back();
             }
+
+            req->last_chunk_aggregate = true;
+            res->final = true;
         }
     } else {
         bool done;
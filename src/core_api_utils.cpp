@@ -1,5 +1,6 @@
 #include "core_api_utils.h"
 #include "auth_manager.h"
+#include "collection_manager.h"
 
 Option<bool> stateful_remove_docs(deletion_state_t* deletion_state, size_t batch_size, bool& done) {
     bool removed = true;
@@ -46,8 +47,6 @@ Option<bool> stateful_remove_docs(deletion_state_t* deletion_state, size_t batch
 }
 
 Option<bool> stateful_export_docs(export_state_t* export_state, size_t batch_size, bool& done) {
-    size_t batch_count = 0;
-
     export_state->res_body->clear();
 
     auto const& filter_result = export_state->filter_result;
@@ -57,33 +56,25 @@ Option<bool> stateful_export_docs(export_state_t* export_state, size_t batch_siz
     size_t start_index = export_state->offset;
     size_t batched_len = std::min(ids_len, (start_index+batch_size));
 
-    for(size_t j = start_index; j < batched_len; j++) {
-        uint32_t seq_id = ids[j];
-        nlohmann::json doc;
-
-        auto const& coll = export_state->collection;
-        Option<bool> get_op = coll->get_document_from_store(seq_id, doc);
-        Collection::remove_flat_fields(doc);
-        Collection::remove_reference_helper_fields(doc);
-
-        if(get_op.ok()) {
-            coll->prune_doc_with_lock(doc, export_state->include_fields, export_state->exclude_fields,
-                                      filter_result.coll_to_references[j], seq_id,
-                                      export_state->ref_include_exclude_fields_vec);
-            export_state->res_body->append(doc.dump());
-
-            export_state->res_body->append("\n");
-        }
+    const std::vector<uint32_t> seq_ids(ids + start_index, ids + batched_len);
+    std::vector<std::string> json_docs(seq_ids.size());
 
-        export_state->offset++;
-        batch_count++;
+    const std::map<std::string, reference_filter_result_t>* references = nullptr;
+    std::unique_ptr<std::map<std::string, reference_filter_result_t>[]> batch_references;
 
-        if(batch_count == batch_size) {
-            goto END;
+    if (filter_result.coll_to_references != nullptr) {
+        references = filter_result.coll_to_references + start_index;
+    } else if (filter_result.has_references()) {
+        // references kept flat by a join are attached only to the docs of this batch
+        batch_references.reset(new std::map<std::string, reference_filter_result_t>[seq_ids.size()] {});
+        for (size_t i = 0; i < seq_ids.size(); i++) {
+            filter_result.get_references(start_index + i, batch_references[i]);
         }
+        references = batch_references.get();
     }
 
-    END:
+    auto export_op = append_export_docs(export_state, seq_ids, json_docs, references, *export_state->res_body);
+    export_state->offset = batched_len;
 
     done = export_state->offset == export_state->filter_result.count;
 
@@ -91,9 +82,149 @@ Option<bool> stateful_export_docs(export_state_t* export_state, size_t batch_siz
         export_state->res_body->pop_back();
     }
 
+    return export_op;
+}
+
+static Option<bool> export_doc(export_state_t* export_state, const uint32_t seq_id, const std::string& json_doc,
+                               const std::map<std::string, reference_filter_result_t>& references,
+                               std::string& serialized_doc) {
+    const auto& include_names = export_state->include_fields;
+    const auto& exclude_names = export_state->exclude_fields;
+    const bool prune = !include_names.empty() || !exclude_names.empty() ||
+                       !export_state->ref_include_exclude_fields_vec.empty();
+
+    if(!prune && json_doc.find("\".flat\"") == std::string::npos &&
+       json_doc.find("\"" + fields::reference_helper_fields + "\"") == std::string::npos) {
+        // documents are stored in the same compact form that they are exported in
+        serialized_doc = json_doc;
+        return Option<bool>(true);
+    }
+
+    // without reference includes, top level fields that pruning would remove are dropped while parsing
+    const bool project_while_parsing = prune && export_state->ref_include_exclude_fields_vec.empty();
+
+    nlohmann::json doc;
+
+    try {
+        if(project_while_parsing) {
+            doc = nlohmann::json::parse(json_doc, [&](int depth, nlohmann::json::parse_event_t event,
+                                                      nlohmann::json& parsed) {
+                if(depth != 1 || event != nlohmann::json::parse_event_t::key) {
+                    return true;
+                }
+
+                const std::string& key = parsed.get_ref<const std::string&>();
+                if(key == ".flat" || key == fields::reference_helper_fields) {
+                    return true;
+                }
+
+                if(!include_names.empty()) {
+                    auto prefix_it = include_names.equal_prefix_range(key);
+                    if(prefix_it.first == prefix_it.second) {
+                        return false;
+                    }
+                }
+
+                return exclude_names.count(key) == 0;
+            });
+        } else {
+            doc = nlohmann::json::parse(json_doc);
+        }
+    } catch(...) {
+        return Option<bool>(500, "Error while parsing stored document with sequence ID: " + std::to_string(seq_id));
+    }
+
+    Collection::remove_flat_fields(doc);
+    Collection::remove_reference_helper_fields(doc);
+
+    if(prune) {
+        export_state->collection->prune_doc_with_lock(doc, include_names, exclude_names, references, seq_id,
+                                                      export_state->ref_include_exclude_fields_vec);
+    }
+
+    serialized_doc = doc.dump();
     return Option<bool>(true);
 }
 
+Option<bool> append_export_docs(export_state_t* export_state, const std::vector<uint32_t>& seq_ids,
+                                std::vector<std::string>& json_docs,
+                                const std::map<std::string, reference_filter_result_t>* references,
+                                std::string& body) {
+    const size_t num_docs = seq_ids.size();
+    const std::map<std::string, reference_filter_result_t> no_references;
+
+    std::vector<std::string> serialized_docs(num_docs);
+    std::vector<Option<bool>> export_ops(num_docs, Option<bool>(true));
+
+    auto export_docs = [&](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++) {
+            if(json_docs[i].empty() &&
+               !export_state->collection->get_document_json_from_store(seq_ids[i], json_docs[i]).ok()) {
+                // document could have been deleted after the export began
+                continue;
+            }
+
+            export_ops[i] = export_doc(export_state, seq_ids[i], json_docs[i],
+                                       references == nullptr ? no_references : references[i],
+                                       serialized_docs[i]);
+        }
+    };
+
+    // below this, handing the documents over to the thread pool costs more than exporting them
+    const size_t min_docs_per_thread = 32;
+    const size_t concurrency = 4;
+    const size_t num_threads = std::min(concurrency, (num_docs + min_docs_per_thread - 1) / min_docs_per_thread);
+
+    auto thread_pool = CollectionManager::get_instance().get_thread_pool();
+
+    if(num_threads <= 1 || thread_pool == nullptr) {
+        export_docs(0, num_docs);
+    } else {
+        const size_t window_size = (num_docs + num_threads - 1) / num_threads;  // rounds up
+
+        size_t num_processed = 0;
+        size_t num_queued = 0;
+        std::mutex m_process;
+        std::condition_variable cv_process;
+
+        for(size_t window_start = 0; window_start < num_docs; window_start += window_size) {
+            const size_t window_end = std::min(num_docs, window_start + window_size);
+            num_queued++;
+
+            thread_pool->enqueue([&, window_start, window_end]() {
+                export_docs(window_start, window_end);
+
+                std::unique_lock<std::mutex> lock(m_process);
+                num_processed++;
+                cv_process.notify_one();
+            });
+        }
+
+        std::unique_lock<std::mutex> lock_process(m_process);
+        cv_process.wait(lock_process, [&](){ return num_processed == num_queued; });
+    }
+
+    Option<bool> export_op(true);
+
+    for(size_t i = 0; i < num_docs; i++) {
+        if(!export_ops[i].ok()) {
+            if(export_op.ok()) {
+                export_op = Option<bool>(export_ops[i].code(), export_ops[i].error());
+            }
+            continue;
+        }
+
+        if(serialized_docs[i].empty()) {
+            continue;
+        }
+
+        body += serialized_docs[i];
+        body += "\n";
+    }
+
+    return export_op;
+}
+
 Option<bool> multi_search_validate_and_add_params(std::map<std::string, std::string>& req_params,
                                                   nlohmann::json& search_params, const bool& is_conversation) {
     if(!search_params.is_object()) {
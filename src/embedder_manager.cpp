@@ -1,5 +1,6 @@
 #include "embedder_manager.h"
 #include "system_metrics.h"
+#include "query_embedding_cache.h"
 
 
 EmbedderManager& EmbedderManager::get_instance() {
@@ -199,17 +200,46 @@ Option<ImageEmbedder*> EmbedderManager::get_image_embedder(const nlohmann::json&
     return Option<ImageEmbedder*>(image_embedder_it->second.get());
 }
 
+embedding_res_t EmbedderManager::embed_query(TextEmbedder* embedder, const nlohmann::json& model_config,
+                                             const std::string& query, const size_t remote_embedding_timeout_ms,
+                                             const size_t remote_embedding_num_tries) {
+    std::string embed_query = get_query_prefix(model_config) + query;
+
+    auto& query_embedding_cache = QueryEmbeddingCache::get_instance();
+    if(!query_embedding_cache.is_enabled()) {
+        return embedder->Embed(embed_query, remote_embedding_timeout_ms, remote_embedding_num_tries);
+    }
+
+    const std::string& model_name = model_config.at("model_name");
+    std::string model_key = is_remote_model(model_name) ? RemoteEmbedder::get_model_key(model_config) : model_name;
+    std::string cache_key = QueryEmbeddingCache::get_key(model_key, embed_query);
+
+    std::vector<float> embedding;
+    if(query_embedding_cache.get(cache_key, embedding)) {
+        return embedding_res_t(embedding);
+    }
+
+    auto embedding_res = embedder->Embed(embed_query, remote_embedding_timeout_ms, remote_embedding_num_tries);
+    if(embedding_res.success) {
+        query_embedding_cache.put(cache_key, embedding_res.embedding);
+    }
+
+    return embedding_res;
+}
+
 void EmbedderManager::delete_text_embedder(const std::string& model_path) {
     std::unique_lock<std::mutex> lock(text_embedders_mutex);
 
     text_embedders.erase(model_path);
     public_models.erase(model_path);
+    QueryEmbeddingCache::get_instance().remove_model(model_path);
 }
 
 void EmbedderManager::delete_all_text_embedders() {
     std::unique_lock<std::mutex> lock(text_embedders_mutex);
     text_embedders.clear();
     public_models.clear();
+    QueryEmbeddingCache::get_instance().clear();
 }
 
 void EmbedderManager::delete_image_embedder(const std::string& model_path) {
@@ -281,6 +311,14 @@ const std::string& EmbedderManager::get_model_dir() {
     return model_dir;
 }
 
+void EmbedderManager::set_model_concurrency(size_t concurrency) {
+    model_concurrency = std::max<size_t>(1, concurrency);
+}
+
+size_t EmbedderManager::get_model_concurrency() {
+    return model_concurrency;
+}
+
 EmbedderManager::~EmbedderManager() {
 }
 
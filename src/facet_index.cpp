@@ -2,6 +2,8 @@
 #include <tokenizer.h>
 #include "string_utils.h"
 #include "array_utils.h"
+#include <cmath>
+#include <queue>
 
 void facet_index_t::initialize(const std::string& field) {
     const auto facet_field_map_it = facet_field_map.find(field);
@@ -47,6 +49,9 @@ void facet_index_t::insert(const std::string& field_name,
 
             real_facet_ids.push_back(facet_id);
 
+            facet_index.min_facet_id = std::min(facet_index.min_facet_id, facet_id);
+            facet_index.max_facet_id = std::max(facet_index.max_facet_id, facet_id);
+
             auto seq_ids_it = fvalue_to_seq_ids.find(fvalue);
             if(seq_ids_it == fvalue_to_seq_ids.end()) {
                 continue;
@@ -62,6 +67,10 @@ void facet_index_t::insert(const std::string& field_name,
                     fis.seq_ids = ids_t::create(seq_ids);
                     auto new_count = ids_t::num_ids(fis.seq_ids);
                     fis.facet_count_it = facet_index.counts.emplace(fvalue.facet_value, new_count, facet_id);
+
+                    if(new_count > SKETCH_SIZE) {
+                        build_sketch(fis.seq_ids, facet_index.fid_sketches[facet_id]);
+                    }
                 }
 
                 fvalue_index.emplace(fvalue.facet_value, fis);
@@ -69,6 +78,7 @@ void facet_index_t::insert(const std::string& field_name,
             } else if(facet_index.has_value_index) {
                 for(const auto id : seq_ids) {
                     ids_t::upsert(fvalue_index_it->second.seq_ids, id);
+                    update_sketch(facet_index, facet_id, fvalue_index_it->second.seq_ids, id, true);
                 }
 
                 auto facet_count_it = fvalue_index_it->second.facet_count_it;
@@ -86,7 +96,17 @@ void facet_index_t::insert(const std::string& field_name,
         }
 
         if(facet_index.has_hash_index && fhash_index != nullptr) {
+            if(facet_index.unfiltered_counts != nullptr) {
+                // facet ids of a document that is being re-indexed are replaced
+                std::vector<uint32_t> old_facet_ids;
+                get_facet_ids(fhash_index, seq_id, old_facet_ids);
+                update_facet_counts(*facet_index.unfiltered_counts, old_facet_ids, -1);
+                update_facet_counts(*facet_index.unfiltered_counts, real_facet_ids, 1);
+            }
+
             fhash_index->upsert(seq_id, real_facet_ids);
+        } else {
+            facet_index.unfiltered_counts = nullptr;
         }
     }
 }
@@ -102,6 +122,7 @@ bool facet_index_t::contains(const std::string& field_name) {
 
 void facet_index_t::erase(const std::string& field_name) {
     facet_field_map.erase(field_name);
+    invalidate_filtered_facet_counts();
 }
 
 void facet_index_t::get_stringified_value(const nlohmann::json& value, const field& afield,
@@ -172,6 +193,7 @@ void facet_index_t::remove(const nlohmann::json& doc, const field& afield, const
                 ids_t::destroy_list(ids);
                 dead_fvalues.push_back(fvalue_it->first);
                 dead_fids.push_back(fvalue_it->second.facet_id);
+                facet_field_it->second.fid_sketches.erase(fvalue_it->second.facet_id);
 
                 // remove from int64 lookup map first
                 auto& fhash_int64_map = facet_field_it->second.fhash_to_int64_map;
@@ -184,6 +206,8 @@ void facet_index_t::remove(const nlohmann::json& doc, const field& afield, const
                 auto count_node = counts.extract(fvalue_it->second.facet_count_it);
                 count_node.value().count = ids_t::num_ids(ids);
                 counts.insert(std::move(count_node));
+
+                update_sketch(facet_field_it->second, fvalue_it->second.facet_id, ids, seq_id, false);
             }
         }
     }
@@ -197,6 +221,13 @@ void facet_index_t::remove(const nlohmann::json& doc, const field& afield, const
     }
 
     auto& seq_id_hashes = facet_field_it->second.seq_id_hashes;
+
+    if(facet_field_it->second.unfiltered_counts != nullptr) {
+        std::vector<uint32_t> facet_ids;
+        get_facet_ids(seq_id_hashes, seq_id, facet_ids);
+        update_facet_counts(*facet_field_it->second.unfiltered_counts, facet_ids, -1);
+    }
+
     seq_id_hashes->erase(seq_id);
 }
 
@@ -424,6 +455,7 @@ void facet_index_t::handle_index_change(const std::string& field_name, size_t to
             }
             fvalue_seq_ids.clear();
             facet_index.counts.clear();
+            facet_index.fid_sketches.clear();
             facet_index.has_value_index = false;
         }
     }
@@ -447,6 +479,305 @@ posting_list_t* facet_index_t::get_facet_hash_index(const std::string &field_nam
     return nullptr;
 }
 
+bool facet_index_t::get_facet_id_range(const std::string& field_name, uint32_t& min_facet_id,
+                                       uint32_t& max_facet_id) {
+    const auto facet_field_map_it = facet_field_map.find(field_name);
+    if(facet_field_map_it == facet_field_map.end() ||
+       facet_field_map_it->second.min_facet_id > facet_field_map_it->second.max_facet_id) {
+        return false;
+    }
+
+    min_facet_id = facet_field_map_it->second.min_facet_id;
+    max_facet_id = facet_field_map_it->second.max_facet_id;
+    return true;
+}
+
+size_t facet_index_t::estimate(const facet& a_facet, const uint32_t* result_ids, size_t result_ids_len,
+                               size_t max_facet_count, std::map<std::string, docid_count_t>& found,
+                               bool is_wildcard_no_filter_query) {
+    const auto facet_field_it = facet_field_map.find(a_facet.field_name);
+    if(facet_field_it == facet_field_map.end() || !facet_field_it->second.has_value_index || max_facet_count == 0) {
+        return 0;
+    }
+
+    const auto& facet_index = facet_field_it->second;
+    std::vector<std::pair<std::string, docid_count_t>> estimates;
+
+    // estimated counts of the top values found so far, smallest first
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<>> top_counts;
+    size_t num_values = 0;
+
+    // values are visited in the descending order of their total count, which bounds their count in the results
+    for(auto facet_count_it = facet_index.counts.begin(); facet_count_it != facet_index.counts.end() &&
+                                                          num_values < SKETCH_MAX_VALUES; ++facet_count_it) {
+        if(top_counts.size() == max_facet_count && facet_count_it->count <= top_counts.top()) {
+            break;
+        }
+
+        num_values++;
+
+        const auto fvalue_it = facet_index.fvalue_seq_ids.find(facet_count_it->facet_value);
+        if(fvalue_it == facet_index.fvalue_seq_ids.end() || fvalue_it->second.seq_ids == nullptr) {
+            continue;
+        }
+
+        void* ids = fvalue_it->second.seq_ids;
+        docid_count_t doc_count{ids_t::first_id(ids), 0};
+
+        const auto sketch_it = facet_index.fid_sketches.find(facet_count_it->facet_id);
+
+        if(is_wildcard_no_filter_query) {
+            doc_count.count = doc_count.count_lower = doc_count.count_upper = facet_count_it->count;
+        } else if(sketch_it == facet_index.fid_sketches.end()) {
+            doc_count.count = ids_t::intersect_count(ids, result_ids, result_ids_len, false, 1);
+            doc_count.count_lower = doc_count.count_upper = doc_count.count;
+        } else {
+            size_t sample_hits = 0;
+            for(const auto seq_id: sketch_it->second.ids) {
+                sample_hits += std::binary_search(result_ids, result_ids + result_ids_len, seq_id);
+            }
+
+            estimate_count(sample_hits, sketch_it->second.ids.size(), ids_t::num_ids(ids),
+                           doc_count.count, doc_count.count_lower, doc_count.count_upper);
+            doc_count.count_upper = std::min<uint32_t>(doc_count.count_upper, result_ids_len);
+            doc_count.count = std::min(doc_count.count, doc_count.count_upper);
+        }
+
+        if(doc_count.count == 0) {
+            continue;
+        }
+
+        top_counts.push(doc_count.count);
+        if(top_counts.size() > max_facet_count) {
+            top_counts.pop();
+        }
+
+        estimates.emplace_back(facet_count_it->facet_value, doc_count);
+    }
+
+    const size_t num_top_values = std::min(max_facet_count, estimates.size());
+    std::partial_sort(estimates.begin(), estimates.begin() + num_top_values, estimates.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second.count > b.second.count;
+                      });
+
+    for(size_t i = 0; i < num_top_values; i++) {
+        found.emplace(std::move(estimates[i].first), estimates[i].second);
+    }
+
+    return found.size();
+}
+
+void facet_index_t::estimate_count(const size_t sample_hits, const size_t sample_size, const size_t population,
+                                   uint32_t& count, uint32_t& count_lower, uint32_t& count_upper) {
+    if(sample_size == 0 || sample_size >= population) {
+        count = count_lower = count_upper = sample_hits;
+        return;
+    }
+
+    // 95% Wilson score interval of the hit ratio, narrowed by the finite population correction since the
+    // sample is drawn without replacement
+    const double z = 1.96;
+    const double n = sample_size;
+    const double p = sample_hits / n;
+
+    const double denom = 1 + (z * z / n);
+    const double center = (p + (z * z / (2 * n))) / denom;
+    const double fpc = std::sqrt(double(population - sample_size) / (population - 1));
+    const double half_width = (z / denom) * std::sqrt((p * (1 - p) / n) + (z * z / (4 * n * n))) * fpc;
+
+    count = std::round(p * population);
+
+    // the ids of the sample are known to be hits or misses for sure
+    const double min_count = sample_hits;
+    const double max_count = population - (sample_size - sample_hits);
+
+    count_lower = std::max(min_count, std::floor((center - half_width) * population));
+    count_upper = std::min(max_count, std::ceil((center + half_width) * population));
+
+    count_lower = std::min(count_lower, count);
+    count_upper = std::max(count_upper, count);
+}
+
+uint32_t facet_index_t::sketch_hash(uint32_t seq_id) {
+    // murmur3 finalizer: a bijection, so distinct ids never collide
+    seq_id ^= seq_id >> 16;
+    seq_id *= 0x85ebca6b;
+    seq_id ^= seq_id >> 13;
+    seq_id *= 0xc2b2ae35;
+    seq_id ^= seq_id >> 16;
+    return seq_id;
+}
+
+void facet_index_t::add_to_sketch(facet_sketch_t& sketch, const uint32_t seq_id) {
+    // max-heap on the hash of the ids, so that the id with the largest hash can be evicted
+    auto hash_compare = [](const uint32_t a, const uint32_t b) {
+        return sketch_hash(a) < sketch_hash(b);
+    };
+
+    if(sketch_hash(seq_id) > sketch.max_hash) {
+        return;
+    }
+
+    if(std::find(sketch.ids.begin(), sketch.ids.end(), seq_id) != sketch.ids.end()) {
+        return;
+    }
+
+    sketch.ids.push_back(seq_id);
+    std::push_heap(sketch.ids.begin(), sketch.ids.end(), hash_compare);
+
+    if(sketch.ids.size() > SKETCH_SIZE) {
+        std::pop_heap(sketch.ids.begin(), sketch.ids.end(), hash_compare);
+        sketch.ids.pop_back();
+        // every id of the value with a hash up to the new largest one is still held
+        sketch.max_hash = sketch_hash(sketch.ids.front());
+    }
+}
+
+void facet_index_t::remove_from_sketch(facet_sketch_t& sketch, const uint32_t seq_id) {
+    auto it = std::find(sketch.ids.begin(), sketch.ids.end(), seq_id);
+    if(it == sketch.ids.end()) {
+        return;
+    }
+
+    // `max_hash` stays as is: ids above it are still unknown, ids below it are still all held
+    *it = sketch.ids.back();
+    sketch.ids.pop_back();
+    std::make_heap(sketch.ids.begin(), sketch.ids.end(), [](const uint32_t a, const uint32_t b) {
+        return sketch_hash(a) < sketch_hash(b);
+    });
+}
+
+void facet_index_t::build_sketch(void*& ids, facet_sketch_t& sketch) {
+    std::vector<uint32_t> seq_ids;
+    ids_t::uncompress(ids, seq_ids);
+
+    sketch.ids.clear();
+    sketch.ids.reserve(SKETCH_SIZE + 1);
+    sketch.max_hash = UINT32_MAX;
+
+    for(const auto seq_id: seq_ids) {
+        add_to_sketch(sketch, seq_id);
+    }
+}
+
+void facet_index_t::update_sketch(facet_doc_ids_list_t& facet_index, const uint32_t facet_id, void*& ids,
+                                  const uint32_t seq_id, const bool is_insert) {
+    auto sketch_it = facet_index.fid_sketches.find(facet_id);
+
+    if(ids_t::num_ids(ids) <= SKETCH_SIZE) {
+        if(sketch_it != facet_index.fid_sketches.end()) {
+            facet_index.fid_sketches.erase(sketch_it);
+        }
+        return;
+    }
+
+    if(sketch_it == facet_index.fid_sketches.end()) {
+        build_sketch(ids, facet_index.fid_sketches[facet_id]);
+        return;
+    }
+
+    if(is_insert) {
+        add_to_sketch(sketch_it->second, seq_id);
+        return;
+    }
+
+    // the next smallest hash that should replace a removed id is not known without a rescan of the ids, so the
+    // sample shrinks until it is rebuilt
+    remove_from_sketch(sketch_it->second, seq_id);
+    if(sketch_it->second.ids.size() < SKETCH_SIZE / 2) {
+        build_sketch(ids, sketch_it->second);
+    }
+}
+
+std::shared_ptr<const facet_counts_t> facet_index_t::get_facet_counts(const std::string& field_name,
+                                                                      const std::string& filter_query,
+                                                                      const size_t num_docs) {
+    std::unique_lock lock(facet_counts_mutex);
+
+    if(filter_query.empty()) {
+        const auto facet_field_map_it = facet_field_map.find(field_name);
+        if(facet_field_map_it == facet_field_map.end()) {
+            return nullptr;
+        }
+
+        return facet_field_map_it->second.unfiltered_counts;
+    }
+
+    const std::string key = field_name + '\0' + filter_query;
+    const auto fcounts_it = filtered_facet_counts.find(key);
+    if(fcounts_it == filtered_facet_counts.end()) {
+        return nullptr;
+    }
+
+    const auto& fcounts = fcounts_it.value();
+    if(fcounts->write_version != write_version || fcounts->num_docs != num_docs) {
+        filtered_facet_counts.erase(key);
+        return nullptr;
+    }
+
+    return fcounts;
+}
+
+void facet_index_t::set_facet_counts(const std::string& field_name, const std::string& filter_query,
+                                     std::shared_ptr<facet_counts_t> fcounts) {
+    std::unique_lock lock(facet_counts_mutex);
+    fcounts->write_version = write_version;
+
+    if(filter_query.empty()) {
+        const auto facet_field_map_it = facet_field_map.find(field_name);
+        if(facet_field_map_it != facet_field_map.end() && facet_field_map_it->second.has_hash_index) {
+            facet_field_map_it->second.unfiltered_counts = std::move(fcounts);
+        }
+
+        return;
+    }
+
+    filtered_facet_counts.insert(field_name + '\0' + filter_query, std::move(fcounts));
+}
+
+void facet_index_t::invalidate_filtered_facet_counts() {
+    write_version++;
+}
+
+void facet_index_t::get_facet_ids(posting_list_t* fhash_index, const uint32_t seq_id,
+                                  std::vector<uint32_t>& facet_ids) {
+    if(fhash_index == nullptr) {
+        return;
+    }
+
+    auto fhash_index_it = fhash_index->new_iterator();
+    fhash_index_it.skip_to(seq_id);
+
+    if(fhash_index_it.valid() && fhash_index_it.id() == seq_id) {
+        posting_list_t::get_offsets(fhash_index_it, facet_ids);
+    }
+}
+
+void facet_index_t::update_facet_counts(facet_counts_t& fcounts, const std::vector<uint32_t>& facet_ids,
+                                        const int delta) {
+    // an array can contain the same value more than once, but the document is counted only once
+    std::set<uint32_t> unique_facet_ids(facet_ids.begin(), facet_ids.end());
+
+    for(const auto facet_id: unique_facet_ids) {
+        if(delta > 0) {
+            fcounts.counts[facet_id] += delta;
+            continue;
+        }
+
+        const auto count_it = fcounts.counts.find(facet_id);
+        if(count_it == fcounts.counts.end()) {
+            continue;
+        }
+
+        if(count_it->second <= uint32_t(-delta)) {
+            fcounts.counts.erase(count_it);
+        } else {
+            count_it->second += delta;
+        }
+    }
+}
+
 const spp::sparse_hash_map<uint32_t , int64_t >& facet_index_t::get_fhash_int64_map(const std::string& field_name) {
     static const spp::sparse_hash_map<uint32_t, int64_t> empty_map{};
     const auto facet_field_map_it = facet_field_map.find(field_name);
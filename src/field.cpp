@@ -122,6 +122,19 @@ Option<bool> field::json_field_to_field(bool enable_nested_fields, nlohmann::jso
         field_json[fields::stem_dictionary] = "";
     }
 
+    if(field_json.count(fields::bm25) != 0) {
+        if(!field_json.at(fields::bm25).is_boolean()) {
+            return Option<bool>(400, std::string("The `bm25` property of the field `") +
+                                     field_json[fields::name].get<std::string>() + std::string("` should be a boolean."));
+        }
+
+        if(field_json[fields::bm25] && field_json[fields::type] != field_types::STRING && field_json[fields::type] != field_types::STRING_ARRAY) {
+            return Option<bool>(400, std::string("The `bm25` property is only allowed for string and string[] fields."));
+        }
+    } else {
+        field_json[fields::bm25] = false;
+    }
+
     if (field_json.count(fields::range_index) != 0) {
         if (!field_json.at(fields::range_index).is_boolean()) {
             return Option<bool>(400, std::string("The `range_index` property of the field `") +
@@ -340,6 +353,24 @@ Option<bool> field::json_field_to_field(bool enable_nested_fields, nlohmann::jso
         }
     }
 
+    if(field_json.count(fields::multi_vector) == 0) {
+        field_json[fields::multi_vector] = false;
+    } else {
+        if(!field_json[fields::multi_vector].is_boolean()) {
+            return Option<bool>(400, "Property `" + fields::multi_vector + "` must be a boolean.");
+        }
+
+        if(field_json[fields::multi_vector].get<bool>()) {
+            if(field_json.count(fields::embed) != 0) {
+                return Option<bool>(400, "Property `" + fields::multi_vector + "` is not allowed on an embedding field.");
+            }
+
+            if(field_json[fields::num_dim] == 0) {
+                return Option<bool>(400, "Property `" + fields::multi_vector + "` is only allowed on a vector field.");
+            }
+        }
+    }
+
     if(field_json.count(fields::hnsw_params) != 0) {
         if(!field_json[fields::hnsw_params].is_object()) {
             return Option<bool>(400, "Property `" + fields::hnsw_params + "` must be an object.");
@@ -458,6 +489,9 @@ Option<bool> field::json_field_to_field(bool enable_nested_fields, nlohmann::jso
                   field_json[fields::symbols_to_index])
     );
 
+    the_fields.back().multi_vector = field_json[fields::multi_vector].get<bool>();
+    the_fields.back().bm25 = field_json[fields::bm25].get<bool>();
+
     if (!field_json[fields::reference].get<std::string>().empty()) {
         // Add a reference helper field in the schema. It stores the doc id of the document it references to reduce the
         // computation while searching.
@@ -841,6 +875,10 @@ Option<bool> field::fields_to_json_fields(const std::vector<field>& fields, cons
         field_val[fields::range_index] = field.range_index;
         field_val[fields::stem_dictionary] = field.stem_dictionary;
 
+        if(field.bm25) {
+            field_val[fields::bm25] = true;
+        }
+
         if(field.embed.count(fields::from) != 0) {
             field_val[fields::embed] = field.embed;
         }
@@ -853,6 +891,10 @@ Option<bool> field::fields_to_json_fields(const std::vector<field>& fields, cons
         if(field.num_dim > 0) {
             field_val[fields::num_dim] = field.num_dim;
             field_val[fields::vec_dist] = field.vec_dist == ip ? "ip" : "cosine";
+
+            if(field.multi_vector) {
+                field_val[fields::multi_vector] = true;
+            }
         }
 
         if (!field.reference.empty()) {
@@ -36,9 +36,57 @@ void reference_filter_result_t::copy_references(const reference_filter_result_t&
 }
 
 void filter_result_t::copy_references(const filter_result_t& from, filter_result_t& to) {
+    to.reference_collection_name = from.reference_collection_name;
+    to.is_reference_array_field = from.is_reference_array_field;
+    to.reference_offsets = from.reference_offsets;
+    to.reference_docs = from.reference_docs;
+
     return copy_references_helper(from.coll_to_references, to.coll_to_references, from.count);
 }
 
+void filter_result_t::get_references(const uint32_t index,
+                                     std::map<std::string, reference_filter_result_t>& references) const {
+    if (coll_to_references != nullptr) {
+        references.insert(coll_to_references[index].begin(), coll_to_references[index].end());
+        return;
+    }
+
+    if (reference_offsets.empty() || references.count(reference_collection_name) != 0) {
+        return;
+    }
+
+    auto const start = reference_offsets[index], end = reference_offsets[index + 1];
+    if (start == end) {
+        return;
+    }
+
+    auto r = reference_filter_result_t(end - start, new uint32_t[end - start], is_reference_array_field);
+    std::copy(reference_docs.begin() + start, reference_docs.begin() + end, r.docs);
+    references[reference_collection_name] = std::move(r);
+}
+
+void filter_result_t::move_references(const uint32_t index,
+                                      std::map<std::string, reference_filter_result_t>& references) {
+    if (coll_to_references != nullptr) {
+        references = std::move(coll_to_references[index]);
+        return;
+    }
+
+    get_references(index, references);
+}
+
+void filter_result_t::append_references(const filter_result_t& from, const uint32_t index) {
+    if (reference_offsets.empty()) {
+        reference_collection_name = from.reference_collection_name;
+        is_reference_array_field = from.is_reference_array_field;
+        reference_offsets.push_back(0);
+    }
+
+    reference_docs.insert(reference_docs.end(), from.reference_docs.begin() + from.reference_offsets[index],
+                          from.reference_docs.begin() + from.reference_offsets[index + 1]);
+    reference_offsets.push_back(reference_docs.size());
+}
+
 void filter_result_t::and_filter_results(const filter_result_t& a, const filter_result_t& b, filter_result_t& result) {
     auto lenA = a.count, lenB = b.count;
     if (lenA == 0 || lenB == 0) {
@@ -51,7 +99,7 @@ void filter_result_t::and_filter_results(const filter_result_t& a, const filter_
     const uint32_t *endA = A + lenA;
     const uint32_t *endB = B + lenB;
 
-    if (a.coll_to_references != nullptr || b.coll_to_references != nullptr) {
+    if (a.has_references() || b.has_references()) {
         result.coll_to_references = new std::map<std::string, reference_filter_result_t>[std::min(lenA, lenB)] {};
     }
 
@@ -75,12 +123,8 @@ void filter_result_t::and_filter_results(const filter_result_t& a, const filter_
             if (result.coll_to_references != nullptr) {
                 // Copy the references of the document from every collection into result.
                 auto& ref = result.coll_to_references[out - result.docs];
-                if (a.coll_to_references != nullptr) {
-                    ref.insert(a.coll_to_references[A - a.docs].begin(), a.coll_to_references[A - a.docs].end());
-                }
-                if (b.coll_to_references != nullptr) {
-                    ref.insert(b.coll_to_references[B - b.docs].begin(), b.coll_to_references[B - b.docs].end());
-                }
+                a.get_references(A - a.docs, ref);
+                b.get_references(B - b.docs, ref);
             }
 
             out++;
@@ -113,7 +157,7 @@ void filter_result_t::or_filter_results(const filter_result_t& a, const filter_r
     size_t indexA = 0, indexB = 0, res_index = 0, lenA = a.count, lenB = b.count;
     result.docs = new uint32_t[lenA + lenB];
 
-    if (a.coll_to_references != nullptr || b.coll_to_references != nullptr) {
+    if (a.has_references() || b.has_references()) {
         result.coll_to_references = new std::map<std::string, reference_filter_result_t>[lenA + lenB] {};
     }
 
@@ -125,10 +169,9 @@ void filter_result_t::or_filter_results(const filter_result_t& a, const filter_r
                 res_index++;
             }
 
-            if (a.coll_to_references != nullptr) {
+            if (a.has_references()) {
                 // Copy references of the last result document from every collection in a.
-                auto &ref = result.coll_to_references[res_index - 1];
-                ref.insert(a.coll_to_references[indexA].begin(), a.coll_to_references[indexA].end());
+                a.get_references(indexA, result.coll_to_references[res_index - 1]);
             }
 
             indexA++;
@@ -138,9 +181,8 @@ void filter_result_t::or_filter_results(const filter_result_t& a, const filter_r
                 res_index++;
             }
 
-            if (b.coll_to_references != nullptr) {
-                auto &ref = result.coll_to_references[res_index - 1];
-                ref.insert(b.coll_to_references[indexB].begin(), b.coll_to_references[indexB].end());
+            if (b.has_references()) {
+                b.get_references(indexB, result.coll_to_references[res_index - 1]);
             }
 
             indexB++;
@@ -153,9 +195,8 @@ void filter_result_t::or_filter_results(const filter_result_t& a, const filter_r
             res_index++;
         }
 
-        if (a.coll_to_references != nullptr) {
-            auto &ref = result.coll_to_references[res_index - 1];
-            ref.insert(a.coll_to_references[indexA].begin(), a.coll_to_references[indexA].end());
+        if (a.has_references()) {
+            a.get_references(indexA, result.coll_to_references[res_index - 1]);
         }
 
         indexA++;
@@ -167,9 +208,8 @@ void filter_result_t::or_filter_results(const filter_result_t& a, const filter_r
             res_index++;
         }
 
-        if (b.coll_to_references != nullptr) {
-            auto &ref = result.coll_to_references[res_index - 1];
-            ref.insert(b.coll_to_references[indexB].begin(), b.coll_to_references[indexB].end());
+        if (b.has_references()) {
+            b.get_references(indexB, result.coll_to_references[res_index - 1]);
         }
 
         indexB++;
@@ -655,9 +695,8 @@ void filter_result_iterator_t::next() {
 
         seq_id = filter_result.docs[result_index];
         reference.clear();
-        if (filter_result.coll_to_references != nullptr) {
-            auto& ref = filter_result.coll_to_references[result_index];
-            reference.insert(ref.begin(), ref.end());
+        if (filter_result.has_references()) {
+            filter_result.get_references(result_index, reference);
         }
 
         return;
@@ -893,9 +932,8 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
         }
 
         seq_id = filter_result.docs[result_index];
-        if (filter_result.coll_to_references != nullptr) {
-            auto& ref = filter_result.coll_to_references[result_index];
-            reference.insert(ref.begin(), ref.end());
+        if (filter_result.has_references()) {
+            filter_result.get_references(result_index, reference);
         }
 
         is_filter_result_initialized = true;
@@ -1722,9 +1760,8 @@ void filter_result_iterator_t::skip_to(uint32_t id) {
 
         seq_id = filter_result.docs[result_index];
         reference.clear();
-        if (filter_result.coll_to_references != nullptr) {
-            auto& ref = filter_result.coll_to_references[result_index];
-            reference.insert(ref.begin(), ref.end());
+        if (filter_result.has_references()) {
+            filter_result.get_references(result_index, reference);
         }
 
         return;
@@ -2124,9 +2161,8 @@ void filter_result_iterator_t::reset(const bool& override_timeout) {
         seq_id = filter_result.docs[result_index];
 
         reference.clear();
-        if (filter_result.coll_to_references != nullptr) {
-            auto& ref = filter_result.coll_to_references[result_index];
-            reference.insert(ref.begin(), ref.end());
+        if (filter_result.has_references()) {
+            filter_result.get_references(result_index, reference);
         }
 
         validity = valid;
@@ -2257,7 +2293,7 @@ void filter_result_iterator_t::and_scalar(const uint32_t* A, const uint32_t& len
         return;
     }
 
-    if (filter_result.coll_to_references == nullptr) {
+    if (!filter_result.has_references()) {
         if (is_filter_result_initialized) {
             result.count = ArrayUtils::and_scalar(A, lenA, filter_result.docs, filter_result.count, &result.docs);
             return;
@@ -2302,12 +2338,19 @@ void filter_result_iterator_t::and_scalar(const uint32_t* A, const uint32_t& len
 
     result.count = match_indexes.size();
     result.docs = new uint32_t[match_indexes.size()];
-    result.coll_to_references = new std::map<std::string, reference_filter_result_t>[match_indexes.size()] {};
+    if (filter_result.coll_to_references != nullptr) {
+        result.coll_to_references = new std::map<std::string, reference_filter_result_t>[match_indexes.size()] {};
+    }
 
     for (uint32_t i = 0; i < match_indexes.size(); i++) {
         auto const& match_index = match_indexes[i];
         result.docs[i] = filter_result.docs[match_index];
 
+        if (filter_result.coll_to_references == nullptr) {
+            result.append_references(filter_result, match_index);
+            continue;
+        }
+
         auto& result_reference = result.coll_to_references[i];
         result_reference.insert(filter_result.coll_to_references[match_index].begin(),
                                  filter_result.coll_to_references[match_index].end());
@@ -2442,6 +2485,9 @@ void filter_result_iterator_t::get_n_ids(const uint32_t& n, filter_result_t*& re
         result->docs[i] = filter_result.docs[result_index];
 
         if (filter_result.coll_to_references == nullptr) {
+            if (filter_result.has_references()) {
+                result->append_references(filter_result, result_index);
+            }
             continue;
         }
 
@@ -2498,6 +2544,9 @@ void filter_result_iterator_t::get_n_ids(const uint32_t& n,
         result->docs[i] = filter_result.docs[match_index];
 
         if (filter_result.coll_to_references == nullptr) {
+            if (filter_result.has_references()) {
+                result->append_references(filter_result, match_index);
+            }
             continue;
         }
 
@@ -2595,10 +2644,8 @@ void filter_result_iterator_t::compute_iterators() {
             seq_id = filter_result.docs[result_index];
             approx_filter_ids_length = filter_result.count;
 
-            if (filter_result.coll_to_references != nullptr) {
-                for (const auto& ref_result: filter_result.coll_to_references[result_index]) {
-                    reference.insert(ref_result);
-                }
+            if (filter_result.has_references()) {
+                filter_result.get_references(result_index, reference);
             }
         }
 
@@ -4,6 +4,7 @@
 #include <regex>
 #include <thread>
 #include <signal.h>
+#include <unistd.h>
 #include <h2o.h>
 #include <iostream>
 #include <auth_manager.h>
@@ -14,14 +15,18 @@
 #include "sole.hpp"
 #include "core_api.h"
 
+thread_local http_message_dispatcher* HttpServer::loop_message_dispatcher = nullptr;
+thread_local h2o_loop_t* HttpServer::current_loop = nullptr;
+
 HttpServer::HttpServer(const std::string & version, const std::string & listen_address,
                        uint32_t listen_port, const std::string & ssl_cert_path, const std::string & ssl_cert_key_path,
                        const uint64_t ssl_refresh_interval_ms, bool cors_enabled,
-                       const std::set<std::string>& cors_domains, ThreadPool* thread_pool):
+                       const std::set<std::string>& cors_domains, ThreadPool* thread_pool,
+                       const size_t num_event_loops):
         SSL_REFRESH_INTERVAL_MS(ssl_refresh_interval_ms),
         exit_loop(false), version(version), listen_address(listen_address), listen_port(listen_port),
         ssl_cert_path(ssl_cert_path), ssl_cert_key_path(ssl_cert_key_path),
-        cors_enabled(cors_enabled), cors_domains(cors_domains), thread_pool(thread_pool) {
+        cors_enabled(cors_enabled), cors_domains(cors_domains), thread_pool(thread_pool), ssl_ctx(nullptr) {
     accept_ctx = new h2o_accept_ctx_t();
     h2o_config_init(&config);
     hostconf = h2o_config_register_host(&config, h2o_iovec_init(H2O_STRLIT("default")), 65535);
@@ -37,6 +42,15 @@ HttpServer::HttpServer(const std::string & version, const std::string & listen_a
     message_dispatcher = new http_message_dispatcher;
     message_dispatcher->init(ctx.loop);
 
+    for(size_t i = 1; i < num_event_loops; i++) {
+        event_loop_t* event_loop = new event_loop_t();
+        event_loop->server = this;
+        h2o_context_init(&event_loop->ctx, h2o_evloop_create(), &config);
+        event_loop->message_dispatcher = new http_message_dispatcher;
+        event_loop->message_dispatcher->init(event_loop->ctx.loop);
+        event_loops.push_back(event_loop);
+    }
+
     // used during destructor
     ssl_refresh_timer.timer.expire_at = 0;
     metrics_refresh_timer.timer.expire_at = 0;
@@ -61,6 +75,23 @@ void HttpServer::on_accept(h2o_socket_t *listener, const char *err) {
     h2o_accept(http_server->accept_ctx, sock);
 }
 
+void HttpServer::on_event_loop_accept(h2o_socket_t *listener, const char *err) {
+    event_loop_t* event_loop = reinterpret_cast<event_loop_t*>(listener->data);
+    h2o_socket_t *sock;
+
+    if (err != NULL) {
+        return;
+    }
+
+    if ((sock = h2o_evloop_socket_accept(listener)) == NULL) {
+        return;
+    }
+
+    // pick up refreshed SSL certs
+    event_loop->accept_ctx.ssl_ctx = event_loop->server->ssl_ctx.load();
+    h2o_accept(&event_loop->accept_ctx, sock);
+}
+
 void HttpServer::on_metrics_refresh_timeout(h2o_timer_t *entry) {
     h2o_custom_timer_t* custom_timer = reinterpret_cast<h2o_custom_timer_t*>(entry);
 
@@ -88,6 +119,8 @@ void HttpServer::on_ssl_refresh_timeout(h2o_timer_t *entry) {
     bool refresh_success = initialize_ssl_ctx(hs->ssl_cert_path.c_str(), hs->ssl_cert_key_path.c_str(), hs->accept_ctx);
 
     if (refresh_success) {
+        hs->ssl_ctx = hs->accept_ctx->ssl_ctx;
+
         // delete the old SSL context but after some time, to allow existing connections to drain
         h2o_custom_timer_t* ssl_ctx_delete_timer = new h2o_custom_timer_t(old_ssl_ctx);
         h2o_timer_init(&ssl_ctx_delete_timer->timer, on_ssl_ctx_delete_timeout);
@@ -122,12 +155,12 @@ int HttpServer::setup_ssl(const char *cert_file, const char *key_file) {
         return -1;
     }
 
+    ssl_ctx = accept_ctx->ssl_ctx;
     return 0;
 }
 
 int HttpServer::create_listener() {
-    struct sockaddr_in addr;
-    int fd, reuseaddr_flag = 1;
+    int fd;
 
     if(!ssl_cert_path.empty() && !ssl_cert_key_path.empty()) {
         int ssl_setup_code = setup_ssl(ssl_cert_path.c_str(), ssl_cert_key_path.c_str());
@@ -147,23 +180,58 @@ int HttpServer::create_listener() {
     accept_ctx->ctx = &ctx;
     accept_ctx->hosts = config.hosts;
 
+    if ((fd = bind_listener_socket()) == -1) {
+        return -1;
+    }
+
+    listener_socket = h2o_evloop_socket_create(ctx.loop, fd, H2O_SOCKET_FLAG_DONT_READ);
+    listener_socket->data = this;
+    h2o_socket_read_start(listener_socket, on_accept);
+
+    for(event_loop_t* event_loop: event_loops) {
+        if ((fd = bind_listener_socket()) == -1) {
+            return -1;
+        }
+
+        event_loop->accept_ctx.ctx = &event_loop->ctx;
+        event_loop->accept_ctx.hosts = config.hosts;
+        event_loop->accept_ctx.ssl_ctx = ssl_ctx.load();
+
+        // the loop is not running yet, so its sockets can be created from here
+        event_loop->listener_socket = h2o_evloop_socket_create(event_loop->ctx.loop, fd, H2O_SOCKET_FLAG_DONT_READ);
+        event_loop->listener_socket->data = event_loop;
+        h2o_socket_read_start(event_loop->listener_socket, on_event_loop_accept);
+    }
+
+    return 0;
+}
+
+int HttpServer::bind_listener_socket() {
+    struct sockaddr_in addr;
+    int fd, reuseaddr_flag = 1;
+
     memset(&addr, 0, sizeof(addr));
     addr.sin_family = AF_INET;
     addr.sin_port = htons(listen_port);
     inet_pton(AF_INET, listen_address.c_str(), &(addr.sin_addr));
 
     if ((fd = socket(AF_INET, SOCK_STREAM, 0)) == -1 ||
-        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuseaddr_flag, sizeof(reuseaddr_flag)) != 0 ||
-        bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
-        listen(fd, SOMAXCONN) != 0) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuseaddr_flag, sizeof(reuseaddr_flag)) != 0) {
         return -1;
     }
 
-    listener_socket = h2o_evloop_socket_create(ctx.loop, fd, H2O_SOCKET_FLAG_DONT_READ);
-    listener_socket->data = this;
-    h2o_socket_read_start(listener_socket, on_accept);
+    // every event loop listens on its own socket: the kernel balances new connections across them
+    if (!event_loops.empty() && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuseaddr_flag, sizeof(reuseaddr_flag)) != 0) {
+        close(fd);
+        return -1;
+    }
 
-    return 0;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
 }
 
 int HttpServer::run(ReplicationState* replication_state) {
@@ -180,15 +248,40 @@ int HttpServer::run(ReplicationState* replication_state) {
         LOG(INFO) << "Typesense has started listening on port " << listen_port;
     }
 
-    message_dispatcher->on(STOP_SERVER_MESSAGE, HttpServer::on_stop_server);
+    on(STOP_SERVER_MESSAGE, HttpServer::on_stop_server);
+
+    for(event_loop_t* event_loop: event_loops) {
+        event_loop->thread = std::thread(&HttpServer::run_event_loop, this, event_loop);
+    }
+
+    LOG(INFO) << "Number of HTTP event loops: " << (event_loops.size() + 1);
+
+    loop_message_dispatcher = message_dispatcher;
+    current_loop = ctx.loop;
 
     while(!exit_loop) {
         h2o_evloop_run(ctx.loop, INT32_MAX);
     }
 
+    for(event_loop_t* event_loop: event_loops) {
+        event_loop->thread.join();
+    }
+
     return 0;
 }
 
+void HttpServer::run_event_loop(event_loop_t* event_loop) {
+    loop_message_dispatcher = event_loop->message_dispatcher;
+    current_loop = event_loop->ctx.loop;
+
+    while(!exit_loop) {
+        h2o_evloop_run(event_loop->ctx.loop, INT32_MAX);
+    }
+
+    h2o_socket_read_stop(event_loop->listener_socket);
+    h2o_socket_close(event_loop->listener_socket);
+}
+
 bool HttpServer::on_stop_server(void *data) {
     // do nothing
     return true;
@@ -215,6 +308,10 @@ void HttpServer::stop() {
 
     // send a message to activate the idle event loop to exit, just in case
     message_dispatcher->send_message(STOP_SERVER_MESSAGE, nullptr);
+
+    for(event_loop_t* event_loop: event_loops) {
+        event_loop->message_dispatcher->send_message(STOP_SERVER_MESSAGE, nullptr);
+    }
 }
 
 h2o_pathconf_t* HttpServer::register_handler(h2o_hostconf_t *hostconf, const char *path,
@@ -442,7 +539,16 @@ int HttpServer::catch_all_handler(h2o_handler_t *_h2o_handler, h2o_req_t *req) {
 
         std::string message = "{ \"message\": \"Not Ready or Lagging\"}";
 
-        if(read_op && !h2o_handler->http_server->get_replication_state()->is_read_caught_up()) {
+        auto replication_state = h2o_handler->http_server->get_replication_state();
+
+        if(read_op && ReplicationState::is_bounded_staleness_read(query_map)) {
+            // lag is checked against the read's own staleness bounds once it's picked by a worker thread
+            if(!replication_state->is_state_loaded()) {
+                return send_response(req, 503, message);
+            }
+        }
+
+        else if(read_op && !replication_state->is_read_caught_up()) {
             return send_response(req, 503, message);
         }
 
@@ -521,6 +627,7 @@ int HttpServer::catch_all_handler(h2o_handler_t *_h2o_handler, h2o_req_t *req) {
     std::shared_ptr<http_req> request = std::make_shared<http_req>(req, rpath->http_method, path_without_query,
                                                                    route_hash, query_map, embedded_params_vec,
                                                                    api_auth_key_sent, body, client_ip, is_binary_body);
+    request->message_dispatcher = loop_message_dispatcher;
 
     // add custom generator with a dispose function for cleaning up resources
     h2o_custom_generator_t* custom_gen = new h2o_custom_generator_t;
@@ -722,14 +829,14 @@ int HttpServer::process_request(const std::shared_ptr<http_req>& request, const
         return 0;
     }
 
-    auto message_dispatcher = handler->http_server->get_message_dispatcher();
+    auto message_dispatcher = handler->http_server->get_message_dispatcher(request);
 
     auto thread_pool = use_meta_thread_pool ? handler->http_server->get_meta_thread_pool() :
                        handler->http_server->get_thread_pool();
 
     // LOG(INFO) << "Before enqueue res: " << response
     thread_pool->log_exhaustion();
-    thread_pool->enqueue([rpath, message_dispatcher, request, response]() {
+    auto run_request = [rpath, message_dispatcher, request, response]() {
         // call the API handler
         //LOG(INFO) << "Wait for response " << response.get() << ", action: " << rpath->_get_action();
         (rpath->handler)(request, response);
@@ -740,7 +847,31 @@ int HttpServer::process_request(const std::shared_ptr<http_req>& request, const
             message_dispatcher->send_message(HttpServer::STREAM_RESPONSE_MESSAGE, req_res);
         }
         //LOG(INFO) << "Response done " << response.get();
-    });
+    };
+
+    auto replication_state = handler->http_server->get_replication_state();
+
+    if(replication_state != nullptr && ReplicationState::is_bounded_staleness_read(request->params)) {
+        // the read is handed to a worker only once this node has caught up, so that no worker is held up waiting
+        replication_state->on_read_index(request->params, [thread_pool, message_dispatcher, request, response,
+                                                           run_request](const Option<bool>& read_index_op) {
+            if(!read_index_op.ok()) {
+                nlohmann::json resp;
+                resp["message"] = read_index_op.error();
+                response->set_body(read_index_op.code(), resp.dump());
+                response->final = true;
+                auto req_res = new async_req_res_t(request, response, true);
+                message_dispatcher->send_message(HttpServer::STREAM_RESPONSE_MESSAGE, req_res);
+                return ;
+            }
+
+            thread_pool->enqueue(run_request);
+        });
+
+        return 0;
+    }
+
+    thread_pool->enqueue(run_request);
 
     return 0;
 }
@@ -789,7 +920,7 @@ void HttpServer::defer_processing(const std::shared_ptr<http_req>& req, const st
         h2o_timer_unlink(&req->defer_timer.timer);
     }
 
-    h2o_timer_link(ctx.loop, timeout_ms, &req->defer_timer.timer);
+    h2o_timer_link(current_loop != nullptr ? current_loop : ctx.loop, timeout_ms, &req->defer_timer.timer);
 
     if(exit_loop) {
         // otherwise, replication thread could be stuck waiting on a future
@@ -946,11 +1077,33 @@ void HttpServer::del(const std::string & path, bool (*handler)(const std::shared
 
 void HttpServer::on(const std::string & message, bool (*handler)(void*)) {
     message_dispatcher->on(message, handler);
+
+    for(event_loop_t* event_loop: event_loops) {
+        event_loop->message_dispatcher->on(message, handler);
+    }
 }
 
 HttpServer::~HttpServer() {
+    // pending messages are drained as if on the loop of the dispatcher, instead of being forwarded
+    loop_message_dispatcher = message_dispatcher;
     delete message_dispatcher;
 
+    for(event_loop_t* event_loop: event_loops) {
+        if(event_loop->thread.joinable()) {
+            event_loop->thread.join();
+        }
+
+        loop_message_dispatcher = event_loop->message_dispatcher;
+        delete event_loop->message_dispatcher;
+
+        h2o_timerwheel_run(event_loop->ctx.loop->_timeouts, 9999999999999);
+        h2o_context_dispose(&event_loop->ctx);
+        delete event_loop;
+    }
+
+    event_loops.clear();
+    loop_message_dispatcher = nullptr;
+
     if(ssl_refresh_timer.timer.expire_at != 0) {
         // avoid callback since it recreates timeout
         clear_timeouts({&ssl_refresh_timer.timer}, false);
@@ -986,6 +1139,10 @@ http_message_dispatcher* HttpServer::get_message_dispatcher() const {
     return message_dispatcher;
 }
 
+http_message_dispatcher* HttpServer::get_message_dispatcher(const std::shared_ptr<http_req>& req) const {
+    return (req->message_dispatcher != nullptr) ? req->message_dispatcher : message_dispatcher;
+}
+
 ReplicationState* HttpServer::get_replication_state() const {
     return replication_state;
 }
@@ -1013,10 +1170,25 @@ nlohmann::json HttpServer::node_status() {
     return replication_state->get_status();
 }
 
+bool HttpServer::forward_to_owner_loop(const char* message_type, http_message_dispatcher* owner_dispatcher,
+                                       void* data) {
+    if(owner_dispatcher == nullptr || owner_dispatcher == loop_message_dispatcher) {
+        return false;
+    }
+
+    // messages are sent to the primary loop by default, but only the owner loop may touch the connection
+    owner_dispatcher->send_message(message_type, data);
+    return true;
+}
+
 bool HttpServer::on_stream_response_message(void *data) {
     //LOG(INFO) << "on_stream_response_message";
     auto req_res = static_cast<async_req_res_t *>(data);
 
+    if(forward_to_owner_loop(STREAM_RESPONSE_MESSAGE, req_res->message_dispatcher, data)) {
+        return true;
+    }
+
     // NOTE: access to `req` and `res` objects must be synchronized and wrapped by `req_res`
 
     if(req_res->is_alive()) {
@@ -1039,6 +1211,11 @@ bool HttpServer::on_request_proceed_message(void *data) {
     // This callback will run concurrently to batch indexer's run() so care must be taken to protect access
     // to variables that are written to by the batch indexer, which for now is only: last_chunk_aggregate (atomic)
     deferred_req_res_t* req_res = static_cast<deferred_req_res_t *>(data);
+
+    if(forward_to_owner_loop(REQUEST_PROCEED_MESSAGE, req_res->req->message_dispatcher, data)) {
+        return true;
+    }
+
     if(req_res->res->is_alive) {
         auto stream_state = (req_res->req->last_chunk_aggregate) ? H2O_SEND_STATE_FINAL : H2O_SEND_STATE_IN_PROGRESS;
 
@@ -1060,6 +1237,11 @@ bool HttpServer::on_request_proceed_message(void *data) {
 bool HttpServer::on_deferred_processing_message(void *data) {
     //LOG(INFO) << "on_deferred_processing_message";
     defer_processing_t* defer = static_cast<defer_processing_t *>(data);
+
+    if(forward_to_owner_loop(DEFER_PROCESSING_MESSAGE, defer->req->message_dispatcher, data)) {
+        return true;
+    }
+
     //LOG(INFO) << "defer req count: " << defer->req.use_count();
     defer->server->defer_processing(defer->req, defer->res, defer->timeout_ms);
     //LOG(INFO) << "req use count: " << defer->req.use_count() << ", req " << defer->req.get();
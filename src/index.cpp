@@ -19,6 +19,8 @@
 #include "logger.h"
 #include "validator.h"
 #include <collection_manager.h>
+#include <vector_distance.h>
+#include <reference_join.h>
 
 #define RETURN_CIRCUIT_BREAKER if((std::chrono::duration_cast<std::chrono::microseconds>( \
                   std::chrono::system_clock::now().time_since_epoch()).count() - search_begin_us) > search_stop_us) { \
@@ -64,7 +66,8 @@ Index::Index(const std::string& name, const uint32_t collection_id, const Store*
         }
 
         if(a_field.num_dim > 0) {
-            auto hnsw_index = new hnsw_index_t(a_field.num_dim, 16, a_field.vec_dist, a_field.hnsw_params["M"].get<uint32_t>(), a_field.hnsw_params["ef_construction"].get<uint32_t>());
+            auto hnsw_index = new hnsw_index_t(a_field.num_dim, 16, a_field.vec_dist, a_field.hnsw_params["M"].get<uint32_t>(),
+                                               a_field.hnsw_params["ef_construction"].get<uint32_t>(), a_field.multi_vector);
             vector_index.emplace(a_field.name, hnsw_index);
             continue;
         }
@@ -73,6 +76,10 @@ Index::Index(const std::string& name, const uint32_t collection_id, const Store*
             art_tree *t = new art_tree;
             art_tree_init(t);
             search_index.emplace(a_field.name, t);
+
+            if(a_field.bm25) {
+                field_length_index.emplace(a_field.name, new field_length_stats_t());
+            }
         } else if(a_field.is_geopoint()) {
             geo_range_index.emplace(a_field.name, new NumericTrie(32));
 
@@ -155,6 +162,13 @@ Index::~Index() {
 
     search_index.clear();
 
+    for(auto& name_stats: field_length_index) {
+        delete name_stats.second;
+        name_stats.second = nullptr;
+    }
+
+    field_length_index.clear();
+
     for(auto & name_index: geo_range_index) {
         delete name_index.second;
         name_index.second = nullptr;
@@ -640,9 +654,7 @@ batch_memory_index(Index *index,
             continue;
         }
 
-        if(index_rec.is_update) {
-            index->remove(index_rec.seq_id, index_rec.del_doc, {}, index_rec.is_update);
-        } else if(index_rec.indexed.ok()) {
+        if(!index_rec.is_update) {
             num_indexed++;
         }
 
@@ -653,6 +665,15 @@ batch_memory_index(Index *index,
 
     num_queued = num_processed = 0;
     std::unique_lock ulock(index->mutex);
+    index->facet_index_v4->invalidate_filtered_facet_counts();
+
+    // The old values of updated records are removed in the same hold of the lock that indexes the new values, so
+    // searches see either none or all of the batch.
+    for(auto& index_rec: iter_batch) {
+        if(index_rec.indexed.ok() && index_rec.is_update) {
+            index->do_remove(index_rec.seq_id, index_rec.del_doc, {}, index_rec.is_update);
+        }
+    }
 
     for(const auto& field_name: found_fields) {
         //LOG(INFO) << "field name: " << field_name;
@@ -696,6 +717,72 @@ batch_memory_index(Index *index,
     return num_indexed;
 }
 
+// Indexes the vectors of a document of a multi-vector field, each under its own label.
+void add_doc_vectors(hnsw_index_t* field_vector_index, const uint32_t seq_id, const nlohmann::json& doc_vectors) {
+    const uint32_t num_vectors = doc_vectors.size();
+    std::vector<float> normalized_vals(field_vector_index->num_dim);
+
+    for (uint32_t i = 0; i < num_vectors; i++) {
+        const std::vector<float>& float_vals = doc_vectors[i].get<std::vector<float>>();
+        const size_t label = hnsw_index_t::get_label(seq_id, i);
+
+        if (field_vector_index->distance_type == cosine) {
+            hnsw_index_t::normalize_vector(float_vals, normalized_vals);
+            field_vector_index->vecdex->addPoint(normalized_vals.data(), label, true);
+        } else {
+            field_vector_index->vecdex->addPoint(float_vals.data(), label, true);
+        }
+    }
+
+    uint32_t prev_num_vectors = 0;
+
+    {
+        std::unique_lock lock(field_vector_index->num_doc_vectors_m);
+        auto it = field_vector_index->num_doc_vectors.find(seq_id);
+        if (it != field_vector_index->num_doc_vectors.end()) {
+            prev_num_vectors = it->second;
+        }
+
+        if (num_vectors == 0) {
+            field_vector_index->num_doc_vectors.erase(seq_id);
+        } else {
+            field_vector_index->num_doc_vectors[seq_id] = num_vectors;
+        }
+    }
+
+    // an update can leave a document with fewer vectors than before
+    for (uint32_t i = num_vectors; i < prev_num_vectors; i++) {
+        try {
+            field_vector_index->vecdex->markDelete(hnsw_index_t::get_label(seq_id, i));
+        } catch (...) {
+            // already deleted
+        }
+    }
+}
+
+void remove_doc_vectors(hnsw_index_t* field_vector_index, const uint32_t seq_id) {
+    uint32_t num_vectors = 0;
+
+    {
+        std::unique_lock lock(field_vector_index->num_doc_vectors_m);
+        auto it = field_vector_index->num_doc_vectors.find(seq_id);
+        if (it == field_vector_index->num_doc_vectors.end()) {
+            return;
+        }
+
+        num_vectors = it->second;
+        field_vector_index->num_doc_vectors.erase(it);
+    }
+
+    for (uint32_t i = 0; i < num_vectors; i++) {
+        try {
+            field_vector_index->vecdex->markDelete(hnsw_index_t::get_label(seq_id, i));
+        } catch (...) {
+            // already deleted
+        }
+    }
+}
+
 void Index::index_field_in_memory(const std::string& collection_name, const field& afield,
                                   std::vector<index_record>& iter_batch,
                                   const std::set<reference_pair_t>& async_referenced_ins) {
@@ -742,6 +829,10 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
             facet_index_v4->check_for_high_cardinality(afield.name, total_num_docs);
         }
 
+        auto field_length_it = field_length_index.find(afield.name);
+        field_length_stats_t* field_length_stats = (afield.is_string() && field_length_it != field_length_index.end()) ?
+                                                   field_length_it->second : nullptr;
+
         for(const auto& record: iter_batch) {
             if(!record.indexed.ok()) {
                 // some records could have been invalidated upstream
@@ -841,8 +932,13 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                 max_score = record.points;
             }
 
+            uint32_t field_length = 0;
+
             for(auto& token_offsets: field_index_it->second.offsets) {
                 token_to_doc_offsets[token_offsets.first].emplace_back(seq_id, record.points, token_offsets.second);
+                field_length += posting_list_t::count_token_positions(token_offsets.second.data(),
+                                                                      token_offsets.second.size(),
+                                                                      afield.is_array());
 
                 if(afield.infix) {
                     auto strhash = StringUtils::hash_wy(token_offsets.first.c_str(), token_offsets.first.size());
@@ -850,6 +946,10 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                     infix_sets[strhash % 4]->insert(token_offsets.first);
                 }
             }
+
+            if(field_length_stats != nullptr) {
+                field_length_stats->upsert(seq_id, field_length);
+            }
         }
 
         facet_index_v4->insert(afield.name, fvalue_to_seq_ids, seq_id_to_fvalues, afield.is_string());
@@ -995,10 +1095,22 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
         } else if(afield.is_array()) {
             // handle vector index first
             if(afield.type == field_types::FLOAT_ARRAY && afield.num_dim > 0) {
-                auto vec_index = vector_index[afield.name]->vecdex;
+                auto field_vector_index = vector_index[afield.name];
+                auto vec_index = field_vector_index->vecdex;
+
+                size_t num_batch_vectors = iter_batch.size();
+                if(afield.multi_vector) {
+                    num_batch_vectors = 0;
+                    for(const auto& record: iter_batch) {
+                        if(record.indexed.ok() && record.doc.count(afield.name) != 0) {
+                            num_batch_vectors += record.doc[afield.name].size();
+                        }
+                    }
+                }
+
                 size_t curr_ele_count = vec_index->getCurrentElementCount();
-                if(curr_ele_count + iter_batch.size() > vec_index->getMaxElements()) {
-                    vec_index->resizeIndex((curr_ele_count + iter_batch.size()) * 1.3);
+                if(curr_ele_count + num_batch_vectors > vec_index->getMaxElements()) {
+                    vec_index->resizeIndex((curr_ele_count + num_batch_vectors) * 1.3);
                 }
 
                 const size_t num_threads = std::min<size_t>(4, iter_batch.size());
@@ -1020,7 +1132,7 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
 
                     num_queued++;
 
-                    thread_pool->enqueue([thread_id, &afield, &vec_index, &records = iter_batch,
+                    thread_pool->enqueue([thread_id, &afield, &vec_index, field_vector_index, &records = iter_batch,
                                           result_index, batch_len, &num_processed, &m_process, &cv_process]() {
 
                         size_t batch_counter = 0;
@@ -1032,6 +1144,12 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                             }
 
                             try {
+                                if(afield.multi_vector) {
+                                    add_doc_vectors(field_vector_index, record.seq_id, record.doc[afield.name]);
+                                    batch_counter++;
+                                    continue;
+                                }
+
                                 const std::vector<float>& float_vals = record.doc[afield.name].get<std::vector<float>>();
                                 if(float_vals.size() != afield.num_dim) {
                                     record.index_failure(400, "Vector size mismatch.");
@@ -1423,7 +1541,8 @@ void Index::compute_facet_stats(facet &a_facet, const std::string& raw_value, co
     }
 }
 
-void Index::compute_facet_stats(facet &a_facet, int64_t raw_value, const std::string & field_type) {
+void Index::compute_facet_stats(facet &a_facet, int64_t raw_value, const std::string & field_type,
+                                const size_t count) {
     if(field_type == field_types::INT32 || field_type == field_types::INT32_ARRAY) {
         int32_t val = raw_value;
         if (val < a_facet.stats.fvmin) {
@@ -1432,8 +1551,8 @@ void Index::compute_facet_stats(facet &a_facet, int64_t raw_value, const std::st
         if (val > a_facet.stats.fvmax) {
             a_facet.stats.fvmax = val;
         }
-        a_facet.stats.fvsum += val;
-        a_facet.stats.fvcount++;
+        a_facet.stats.fvsum += (int64_t(count) * val);
+        a_facet.stats.fvcount += count;
     } else if(field_type == field_types::INT64 || field_type == field_types::INT64_ARRAY) {
         int64_t val = raw_value;
         if(val < a_facet.stats.fvmin) {
@@ -1442,8 +1561,8 @@ void Index::compute_facet_stats(facet &a_facet, int64_t raw_value, const std::st
         if(val > a_facet.stats.fvmax) {
             a_facet.stats.fvmax = val;
         }
-        a_facet.stats.fvsum += val;
-        a_facet.stats.fvcount++;
+        a_facet.stats.fvsum += (int64_t(count) * val);
+        a_facet.stats.fvcount += count;
     } else if(field_type == field_types::FLOAT || field_type == field_types::FLOAT_ARRAY) {
         float val = reinterpret_cast<float&>(raw_value);
         if(val < a_facet.stats.fvmin) {
@@ -1452,8 +1571,8 @@ void Index::compute_facet_stats(facet &a_facet, int64_t raw_value, const std::st
         if(val > a_facet.stats.fvmax) {
             a_facet.stats.fvmax = val;
         }
-        a_facet.stats.fvsum += val;
-        a_facet.stats.fvcount++;
+        a_facet.stats.fvsum += (count * val);
+        a_facet.stats.fvcount += count;
     }
 }
 
@@ -1527,6 +1646,35 @@ void Index::do_facets(std::vector<facet> & facets, facet_query_t & facet_query,
             continue;
         }
 
+        if(facet_infos[findex].use_facet_counts_cache) {
+            do_cached_facet_counts(a_facet, facet_infos[findex], result_ids, results_size, max_facet_count);
+            continue;
+        }
+
+        if(facet_infos[findex].use_sketch) {
+            a_facet.is_intersected = true;
+            a_facet.is_sketched = true;
+            a_facet.sampled = true;
+
+            std::map<std::string, docid_count_t> facet_results;
+            facet_index_v4->estimate(a_facet, result_ids, results_size, max_facet_count, facet_results,
+                                     is_wildcard_no_filter_query);
+
+            for(const auto& kv : facet_results) {
+                facet_count_t& facet_count = a_facet.value_result_map[kv.first];
+                facet_count.count += kv.second.count;
+                facet_count.count_lower += kv.second.count_lower;
+                facet_count.count_upper += kv.second.count_upper;
+                facet_count.doc_id = kv.second.doc_id;
+
+                if(should_compute_stats) {
+                    compute_facet_stats(a_facet, kv.first, facet_field.type, kv.second.count);
+                }
+            }
+
+            continue;
+        }
+
         if(use_value_index) {
             // LOG(INFO) << "Using intersection to find facets";
             a_facet.is_intersected = true;
@@ -1590,6 +1738,12 @@ void Index::do_facets(std::vector<facet> & facets, facet_query_t & facet_query,
                 continue;
             }
 
+            if(facet_infos[findex].use_dense_counts) {
+                do_dense_facet_counts(a_facet, facet_infos[findex], result_ids, results_size,
+                                      estimate_facets, facet_sample_mod_value, max_facet_count);
+                continue;
+            }
+
             const auto& fhash_int64_map = facet_index_v4->get_fhash_int64_map(a_facet.field_name);
 
             const auto facet_field_is_array = facet_field.is_array();
@@ -1706,6 +1860,252 @@ void Index::do_facets(std::vector<facet> & facets, facet_query_t & facet_query,
     }
 }
 
+bool Index::use_dense_facet_counts(const facet& a_facet, const field& facet_field, const size_t group_limit,
+                                   const size_t results_size) const {
+    if(group_limit != 0 || a_facet.is_range_query || !a_facet.sort_field.empty() ||
+       results_size < FACET_DENSE_COUNT_MIN_RESULTS || !facet_index_v4->has_hash_index(facet_field.name)) {
+        return false;
+    }
+
+    uint32_t min_facet_id, max_facet_id;
+    if(!facet_index_v4->get_facet_id_range(facet_field.name, min_facet_id, max_facet_id)) {
+        return false;
+    }
+
+    // String and int64 values get sequential facet ids, but int32 and float values use their own bits as the
+    // facet id, so their range can be too sparse for a flat array.
+    const size_t facet_id_range = size_t(max_facet_id) - min_facet_id + 1;
+    return facet_id_range <= FACET_DENSE_COUNT_MAX_RANGE &&
+           facet_id_range <= std::max<size_t>(results_size * 4, 65536);
+}
+
+bool Index::count_dense_facet_ids(const field& facet_field, const uint32_t* result_ids, const size_t results_size,
+                                  const bool estimate_facets, const size_t facet_sample_mod_value,
+                                  uint32_t& min_facet_id, std::vector<uint32_t>& counts,
+                                  std::vector<uint32_t>& last_doc_ids) const {
+    const auto facet_index = facet_index_v4->get_facet_hash_index(facet_field.name);
+
+    uint32_t max_facet_id;
+    if(facet_index == nullptr || !facet_index_v4->get_facet_id_range(facet_field.name, min_facet_id, max_facet_id)) {
+        return false;
+    }
+
+    // both arrays are indexed by `facet_id - min_facet_id`
+    const size_t facet_id_range = size_t(max_facet_id) - min_facet_id + 1;
+    counts.assign(facet_id_range, 0);
+    last_doc_ids.assign(facet_id_range, 0);
+
+    const auto facet_field_is_array = facet_field.is_array();
+    posting_list_t::iterator_t facet_index_it = facet_index->new_iterator();
+    std::vector<uint32_t> facet_ids;
+
+    for(size_t i = 0; i < results_size; i++) {
+        // if sampling is enabled, we will skip a portion of the results to speed up things
+        if(estimate_facets && (i % facet_sample_mod_value != 0)) {
+            continue;
+        }
+
+        const uint32_t doc_seq_id = result_ids[i];
+        facet_index_it.skip_to(doc_seq_id);
+
+        if(!facet_index_it.valid()) {
+            break;
+        }
+
+        if(facet_index_it.id() != doc_seq_id) {
+            continue;
+        }
+
+        if(((i + 1) % 16384) == 0) {
+            // keep the counts gathered so far instead of discarding them
+            BREAK_CIRCUIT_BREAKER
+        }
+
+        if(!facet_field_is_array) {
+            const uint32_t index = facet_index_it.offset() - min_facet_id;
+            if(index < facet_id_range) {
+                counts[index]++;
+                last_doc_ids[index] = doc_seq_id;
+            }
+            continue;
+        }
+
+        facet_ids.clear();
+        posting_list_t::get_offsets(facet_index_it, facet_ids);
+
+        for(const auto facet_id: facet_ids) {
+            const uint32_t index = facet_id - min_facet_id;
+            // a value repeated within the same array is counted only once for the document
+            if(index >= facet_id_range || (counts[index] != 0 && last_doc_ids[index] == doc_seq_id)) {
+                continue;
+            }
+
+            counts[index]++;
+            last_doc_ids[index] = doc_seq_id;
+        }
+    }
+
+    return true;
+}
+
+void Index::do_dense_facet_counts(facet& a_facet, const facet_info_t& facet_info,
+                                  const uint32_t* result_ids, const size_t results_size,
+                                  const bool estimate_facets, const size_t facet_sample_mod_value,
+                                  const size_t max_facet_count) const {
+    const auto& facet_field = facet_info.facet_field;
+
+    uint32_t min_facet_id;
+    std::vector<uint32_t> counts, last_doc_ids;
+
+    if(!count_dense_facet_ids(facet_field, result_ids, results_size, estimate_facets, facet_sample_mod_value,
+                              min_facet_id, counts, last_doc_ids)) {
+        return;
+    }
+
+    const size_t facet_id_range = counts.size();
+    std::vector<uint32_t> found_indices;
+
+    for(size_t index = 0; index < facet_id_range; index++) {
+        if(counts[index] == 0) {
+            continue;
+        }
+
+        const uint32_t fhash = index + min_facet_id;
+
+        if(facet_info.should_compute_stats) {
+            compute_facet_hash_stats(a_facet, facet_field, fhash, counts[index]);
+        }
+
+        if(!facet_info.use_facet_query || facet_info.hashes.count(fhash) != 0) {
+            found_indices.push_back(index);
+        }
+    }
+
+    // only the top values are returned, so there is no need to materialize the rest in the result map:
+    // ordering is the same as `Collection::facet_count_compare`
+    a_facet.num_distinct_values = found_indices.size();
+    const size_t num_top_values = std::min(max_facet_count, found_indices.size());
+    std::partial_sort(found_indices.begin(), found_indices.begin() + num_top_values, found_indices.end(),
+                      [&counts](const uint32_t a, const uint32_t b) {
+                          return std::tie(counts[a], a) > std::tie(counts[b], b);
+                      });
+
+    // values of the curated hits are counted afterwards and added to these counts, so they can still make it to the
+    // top values: they are kept as well
+    size_t num_kept_values = num_top_values;
+
+    if(!facet_info.curated_ids.empty() && num_top_values < found_indices.size()) {
+        uint32_t curated_min_facet_id;
+        std::vector<uint32_t> curated_counts, curated_last_doc_ids;
+
+        if(count_dense_facet_ids(facet_field, facet_info.curated_ids.data(), facet_info.curated_ids.size(), false, 1,
+                                 curated_min_facet_id, curated_counts, curated_last_doc_ids) &&
+           curated_min_facet_id == min_facet_id && curated_counts.size() == facet_id_range) {
+            auto curated_end = std::partition(found_indices.begin() + num_top_values, found_indices.end(),
+                                              [&curated_counts](const uint32_t index) {
+                                                  return curated_counts[index] != 0;
+                                              });
+            num_kept_values = curated_end - found_indices.begin();
+        }
+    }
+
+    for(size_t i = 0; i < num_kept_values; i++) {
+        const auto index = found_indices[i];
+        const uint32_t fhash = index + min_facet_id;
+
+        facet_count_t& facet_count = a_facet.result_map[fhash];
+        facet_count.count += counts[index];
+        facet_count.doc_id = last_doc_ids[index];
+
+        if(facet_info.use_facet_query) {
+            a_facet.hash_tokens[fhash] = facet_info.hashes.at(fhash);
+        }
+    }
+}
+
+bool Index::use_facet_counts_cache(const facet& a_facet, const facet_info_t& facet_info) const {
+    const auto& facet_field = facet_info.facet_field;
+
+    // counts are cached without the doc ids needed for returning parents of nested facets
+    if(a_facet.is_range_query || a_facet.is_sort_by_alpha || !a_facet.sort_field.empty() ||
+       facet_info.use_facet_query || facet_field.nested || !facet_index_v4->has_hash_index(facet_field.name)) {
+        return false;
+    }
+
+    uint32_t min_facet_id, max_facet_id;
+    if(!facet_index_v4->get_facet_id_range(facet_field.name, min_facet_id, max_facet_id)) {
+        return false;
+    }
+
+    return size_t(max_facet_id) - min_facet_id + 1 <= FACET_DENSE_COUNT_MAX_RANGE;
+}
+
+void Index::do_cached_facet_counts(facet& a_facet, const facet_info_t& facet_info,
+                                   const uint32_t* result_ids, const size_t results_size,
+                                   const size_t max_facet_count) const {
+    const auto& facet_field = facet_info.facet_field;
+    auto fcounts = facet_index_v4->get_facet_counts(facet_field.name, facet_info.facet_counts_filter, results_size);
+
+    if(fcounts == nullptr) {
+        uint32_t min_facet_id;
+        std::vector<uint32_t> counts, last_doc_ids;
+
+        if(!count_dense_facet_ids(facet_field, result_ids, results_size, false, 1,
+                                  min_facet_id, counts, last_doc_ids)) {
+            return;
+        }
+
+        auto new_fcounts = std::make_shared<facet_counts_t>();
+        new_fcounts->num_docs = results_size;
+
+        for(size_t index = 0; index < counts.size(); index++) {
+            if(counts[index] != 0) {
+                new_fcounts->counts.emplace(index + min_facet_id, counts[index]);
+            }
+        }
+
+        // counts gathered before a search cutoff are incomplete
+        if(!search_cutoff) {
+            facet_index_v4->set_facet_counts(facet_field.name, facet_info.facet_counts_filter, new_fcounts);
+        }
+
+        fcounts = new_fcounts;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> fhash_counts(fcounts->counts.begin(), fcounts->counts.end());
+
+    if(facet_info.should_compute_stats) {
+        for(const auto& fhash_count: fhash_counts) {
+            compute_facet_hash_stats(a_facet, facet_field, fhash_count.first, fhash_count.second);
+        }
+    }
+
+    a_facet.num_distinct_values = fhash_counts.size();
+    const size_t num_top_values = std::min(max_facet_count, fhash_counts.size());
+    std::partial_sort(fhash_counts.begin(), fhash_counts.begin() + num_top_values, fhash_counts.end(),
+                      [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) {
+                          return std::tie(a.second, a.first) > std::tie(b.second, b.first);
+                      });
+
+    for(size_t i = 0; i < num_top_values; i++) {
+        facet_count_t& facet_count = a_facet.result_map[fhash_counts[i].first];
+        facet_count.count += fhash_counts[i].second;
+    }
+}
+
+void Index::compute_facet_hash_stats(facet& a_facet, const field& facet_field, const uint32_t fhash,
+                                     const size_t count) const {
+    int64_t val = fhash;
+
+    if(facet_field.is_int64()) {
+        const auto& fhash_int64_map = facet_index_v4->get_fhash_int64_map(facet_field.name);
+        const auto fhash_int64_it = fhash_int64_map.find(fhash);
+        val = (fhash_int64_it != fhash_int64_map.end()) ? fhash_int64_it->second : INT64_MAX;
+    }
+
+    compute_facet_stats(a_facet, val, facet_field.type, count);
+}
+
 void Index::aggregate_topster(Topster<KV>* agg_topster, Topster<KV>* index_topster) {
     if(index_topster->distinct) {
         for(auto &group_topster_entry: index_topster->group_kv_map) {
@@ -1721,6 +2121,68 @@ void Index::aggregate_topster(Topster<KV>* agg_topster, Topster<KV>* index_topst
     }
 }
 
+void Index::aggregate_group_topsters(Topster<KV>* agg_topster, Topster<KV>** topsters, const size_t num_topsters,
+                                     spp::sparse_hash_map<uint64_t, uint64_t>* tgroups_processed,
+                                     spp::sparse_hash_map<uint64_t, uint32_t>& groups_processed) const {
+    const size_t num_partitions = num_topsters;
+    std::vector<std::unique_ptr<Topster<KV>>> partition_topsters(num_partitions);
+    std::vector<spp::sparse_hash_map<uint64_t, uint64_t>> partition_groups(num_partitions);
+
+    size_t num_processed = 0;
+    std::mutex m_process;
+    std::condition_variable cv_process;
+
+    for(size_t partition_id = 0; partition_id < num_partitions; partition_id++) {
+        partition_topsters[partition_id].reset(new Topster<KV>(agg_topster->MAX_SIZE, agg_topster->distinct));
+
+        thread_pool->enqueue([partition_id, num_partitions, num_topsters, topsters, tgroups_processed,
+                              &partition_topsters, &partition_groups,
+                              &num_processed, &m_process, &cv_process]() {
+            auto& partition_topster = partition_topsters[partition_id];
+            auto& partition_group_counts = partition_groups[partition_id];
+
+            for(size_t i = 0; i < num_topsters; i++) {
+                // only the groups of this partition are touched, so the maps are safe to share across threads
+                for(auto& group_topster_entry: topsters[i]->group_kv_map) {
+                    if(group_topster_entry.first % num_partitions != partition_id) {
+                        continue;
+                    }
+
+                    if(partition_topster->add_group(group_topster_entry.first, group_topster_entry.second)) {
+                        // now owned by the partition
+                        group_topster_entry.second = nullptr;
+                    }
+                }
+
+                for(const auto& group_count: tgroups_processed[i]) {
+                    if(group_count.first % num_partitions == partition_id) {
+                        partition_group_counts[group_count.first] += group_count.second;
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(m_process);
+            num_processed++;
+            cv_process.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock_process(m_process);
+    cv_process.wait(lock_process, [&](){ return num_processed == num_partitions; });
+
+    for(size_t partition_id = 0; partition_id < num_partitions; partition_id++) {
+        for(auto& group_topster_entry: partition_topsters[partition_id]->group_kv_map) {
+            if(agg_topster->add_group(group_topster_entry.first, group_topster_entry.second)) {
+                group_topster_entry.second = nullptr;
+            }
+        }
+
+        for(const auto& group_count: partition_groups[partition_id]) {
+            groups_processed[group_count.first] += group_count.second;
+        }
+    }
+}
+
 Option<bool> Index::search_all_candidates(const size_t num_search_fields,
                                           const text_match_type_t match_type,
                                           const std::vector<search_field_t>& the_fields,
@@ -1889,12 +2351,11 @@ void aggregate_nested_references(single_filter_result_t *const reference_result,
 
 template <typename F>
 void negate_left_join(id_list_t* const seq_ids, std::unique_ptr<uint32_t[]>& reference_docs, uint32_t& reference_docs_count,
-                      F&& get_doc_id, const bool& is_match_all_ids_filter, std::vector<std::pair<uint32_t, uint32_t>>& id_pairs,
-                      std::set<uint32_t>& unique_doc_ids,
+                      F&& get_doc_id, const bool& is_match_all_ids_filter, ReferenceJoin& join,
+                      const std::vector<uint32_t>& joined_doc_ids,
                       negate_left_join_t& negate_left_join_info) {
     uint32_t* negate_reference_docs = nullptr;
     size_t negate_index = 0;
-    std::set<uint32_t> unique_negate_doc_ids;
 
     // If the negate join is on all ids like !$CollName(id:*), we don't need to collect any references.
     if (!is_match_all_ids_filter) {
@@ -1913,13 +2374,13 @@ void negate_left_join(id_list_t* const seq_ids, std::unique_ptr<uint32_t[]>& ref
                     // user_a:  [product_a]
                     // user_b:  [product_a, product_b]
                     // We should return product_b and product_c for "Products not seen by user_a".
-                    // So rejecting doc_id's already present in unique_doc_ids (product_a in the above example).
-                    if (doc_id == Index::reference_helper_sentinel_value || unique_doc_ids.count(doc_id) != 0) {
+                    // So rejecting doc_id's already present in joined_doc_ids (product_a in the above example).
+                    if (doc_id == Index::reference_helper_sentinel_value ||
+                        std::binary_search(joined_doc_ids.begin(), joined_doc_ids.end(), doc_id)) {
                         continue;
                     }
 
-                    id_pairs.emplace_back(doc_id, reference_doc_id);
-                    unique_negate_doc_ids.insert(doc_id);
+                    join.add(doc_id, reference_doc_id);
                 }
             }
             if (!it.valid()) {
@@ -1947,13 +2408,13 @@ void negate_left_join(id_list_t* const seq_ids, std::unique_ptr<uint32_t[]>& ref
                 // user_a:  [product_a]
                 // user_b:  [product_a, product_b]
                 // We should return product_b and product_c for "Products not seen by user_a".
-                // So rejecting doc_id's already present in unique_doc_ids (product_a in the above example).
-                if (doc_id == Index::reference_helper_sentinel_value || unique_doc_ids.count(doc_id) != 0) {
+                // So rejecting doc_id's already present in joined_doc_ids (product_a in the above example).
+                if (doc_id == Index::reference_helper_sentinel_value ||
+                    std::binary_search(joined_doc_ids.begin(), joined_doc_ids.end(), doc_id)) {
                     continue;
                 }
 
-                id_pairs.emplace_back(doc_id, reference_doc_id);
-                unique_negate_doc_ids.insert(doc_id);
+                join.add(doc_id, reference_doc_id);
             }
         }
     }
@@ -1962,11 +2423,24 @@ void negate_left_join(id_list_t* const seq_ids, std::unique_ptr<uint32_t[]>& ref
     reference_docs_count = negate_index;
 
     // Main purpose of `negate_left_join_info.excluded_ids` is help identify the doc_ids that don't have any references.
-    negate_left_join_info.excluded_ids_size = unique_doc_ids.size();
-    negate_left_join_info.excluded_ids.reset(new uint32_t[unique_doc_ids.size()]);
-    std::copy(unique_doc_ids.begin(), unique_doc_ids.end(), negate_left_join_info.excluded_ids.get());
+    negate_left_join_info.excluded_ids_size = joined_doc_ids.size();
+    negate_left_join_info.excluded_ids.reset(new uint32_t[joined_doc_ids.size()]);
+    std::copy(joined_doc_ids.begin(), joined_doc_ids.end(), negate_left_join_info.excluded_ids.get());
+}
+
+Option<bool> Index::get_approx_filter_ids_length_with_lock(filter_node_t* const filter_tree_root,
+                                                           const std::string& collection_name,
+                                                           uint32_t& approx_filter_ids_length) const {
+    std::shared_lock lock(mutex);
 
-    unique_doc_ids = unique_negate_doc_ids;
+    auto filter_result_iterator = filter_result_iterator_t(collection_name, this, filter_tree_root, true);
+    auto filter_init_op = filter_result_iterator.init_status();
+    if (!filter_init_op.ok()) {
+        return filter_init_op;
+    }
+
+    approx_filter_ids_length = filter_result_iterator.approx_filter_ids_length;
+    return Option(true);
 }
 
 Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter_tree_root,
@@ -2024,7 +2498,8 @@ Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter
 
             for (uint32_t i = 0; i < count; i++) {
                 auto& reference_doc_id = reference_docs[i];
-                auto reference_doc_references = std::move(ref_filter_result->coll_to_references[i]);
+                std::map<std::string, reference_filter_result_t> reference_doc_references;
+                ref_filter_result->move_references(i, reference_doc_references);
                 if (ref_index.count(reference_doc_id) == 0) { // Reference field might be optional.
                     continue;
                 }
@@ -2083,27 +2558,35 @@ Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter
         }
 
         // Collect all the doc ids from the reference ids.
-        std::vector<std::pair<uint32_t, uint32_t>> id_pairs;
-        std::set<uint32_t> unique_doc_ids;
+        ReferenceJoin join;
+        std::vector<uint32_t> joined_doc_ids;
+        if (is_normal_join) {
+            join.reserve(count);
+        }
 
         for (uint32_t i = 0; i < count; i++) {
             auto& reference_doc_id = reference_docs[i];
-            if (ref_index.count(reference_doc_id) == 0) { // Reference field might be optional.
+            auto it = ref_index.find(reference_doc_id);
+            if (it == ref_index.end()) { // Reference field might be optional.
                 continue;
             }
-            auto doc_id = ref_index.at(reference_doc_id);
+            auto doc_id = it->second;
 
             if (doc_id == Index::reference_helper_sentinel_value) {
                 continue;
             }
 
             if (is_normal_join) {
-                id_pairs.emplace_back(doc_id, reference_doc_id);
+                join.add(doc_id, reference_doc_id);
+            } else {
+                joined_doc_ids.push_back(doc_id);
             }
-            unique_doc_ids.insert(doc_id);
         }
 
         if (negate_left_join_info.is_negate_join) {
+            gfx::timsort(joined_doc_ids.begin(), joined_doc_ids.end());
+            joined_doc_ids.erase(std::unique(joined_doc_ids.begin(), joined_doc_ids.end()), joined_doc_ids.end());
+
             negate_left_join(seq_ids, reference_docs, count,
                              [&ref_index](const uint32_t& reference_doc_id) -> std::vector<uint32_t> {
                                  auto it = ref_index.find(reference_doc_id);
@@ -2112,58 +2595,14 @@ Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter
                                  }
                                  return std::vector<uint32_t>(1, it->second);
                              },
-                             is_match_all_ids_filter, id_pairs, unique_doc_ids, negate_left_join_info);
+                             is_match_all_ids_filter, join, joined_doc_ids, negate_left_join_info);
         }
 
-        if (id_pairs.empty()) {
+        if (join.empty()) {
             return Option(true);
         }
 
-        std::sort(id_pairs.begin(), id_pairs.end(), [](auto const& left, auto const& right) {
-            return left.first < right.first;
-        });
-
-        filter_result.count = unique_doc_ids.size();
-        filter_result.docs = new uint32_t[unique_doc_ids.size()];
-        filter_result.coll_to_references = new std::map<std::string, reference_filter_result_t>[unique_doc_ids.size()] {};
-
-        std::vector<uint32_t> previous_doc_references;
-        for (uint32_t i = 0, previous_doc = id_pairs[0].first + 1, result_index = 0; i < id_pairs.size(); i++) {
-            auto const& current_doc = id_pairs[i].first;
-            auto const& reference_doc_id = id_pairs[i].second;
-
-            if (current_doc != previous_doc) {
-                filter_result.docs[result_index] = current_doc;
-                if (result_index > 0) {
-                    auto& reference_result = filter_result.coll_to_references[result_index - 1];
-
-                    auto r = reference_filter_result_t(previous_doc_references.size(),
-                                                       new uint32_t[previous_doc_references.size()],
-                                                       false);
-                    std::copy(previous_doc_references.begin(), previous_doc_references.end(), r.docs);
-                    reference_result[ref_collection_name] = std::move(r);
-
-                    previous_doc_references.clear();
-                }
-
-                result_index++;
-                previous_doc = current_doc;
-                previous_doc_references.push_back(reference_doc_id);
-            } else {
-                previous_doc_references.push_back(reference_doc_id);
-            }
-        }
-
-        if (!previous_doc_references.empty()) {
-            auto& reference_result = filter_result.coll_to_references[filter_result.count - 1];
-
-            auto r = reference_filter_result_t(previous_doc_references.size(),
-                                               new uint32_t[previous_doc_references.size()],
-                                               false);
-            std::copy(previous_doc_references.begin(), previous_doc_references.end(), r.docs);
-            reference_result[ref_collection_name] = std::move(r);
-        }
-
+        join.to_filter_result(ref_collection_name, false, filter_result);
         return Option(true);
     }
 
@@ -2180,7 +2619,8 @@ Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter
 
         for (uint32_t i = 0; i < count; i++) {
             auto& reference_doc_id = reference_docs[i];
-            auto reference_doc_references = std::move(ref_filter_result->coll_to_references[i]);
+            std::map<std::string, reference_filter_result_t> reference_doc_references;
+            ref_filter_result->move_references(i, reference_doc_references);
             size_t doc_ids_len = 0;
             uint32_t* doc_ids = nullptr;
 
@@ -2243,8 +2683,8 @@ Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter
         return Option<bool>(true);
     }
 
-    std::vector<std::pair<uint32_t, uint32_t>> id_pairs;
-    std::set<uint32_t> unique_doc_ids;
+    ReferenceJoin join;
+    std::vector<uint32_t> joined_doc_ids;
 
     for (uint32_t i = 0; i < count; i++) {
         auto& reference_doc_id = reference_docs[i];
@@ -2256,14 +2696,18 @@ Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter
         for (size_t j = 0; j < doc_ids_len; j++) {
             auto doc_id = doc_ids[j];
             if (is_normal_join) {
-                id_pairs.emplace_back(doc_id, reference_doc_id);
+                join.add(doc_id, reference_doc_id);
+            } else {
+                joined_doc_ids.push_back(doc_id);
             }
-            unique_doc_ids.insert(doc_id);
         }
         delete[] doc_ids;
     }
 
     if (negate_left_join_info.is_negate_join) {
+        gfx::timsort(joined_doc_ids.begin(), joined_doc_ids.end());
+        joined_doc_ids.erase(std::unique(joined_doc_ids.begin(), joined_doc_ids.end()), joined_doc_ids.end());
+
         negate_left_join(seq_ids, reference_docs, count,
                          [&ref_index](const uint32_t& reference_doc_id) {
                              size_t doc_ids_len = 0;
@@ -2275,54 +2719,14 @@ Option<bool> Index::do_reference_filtering_with_lock(filter_node_t* const filter
                              delete[] doc_ids;
                              return vec;
                          },
-                         is_match_all_ids_filter, id_pairs, unique_doc_ids, negate_left_join_info);
+                         is_match_all_ids_filter, join, joined_doc_ids, negate_left_join_info);
     }
 
-    if (id_pairs.empty()) {
+    if (join.empty()) {
         return Option(true);
     }
 
-    std::sort(id_pairs.begin(), id_pairs.end(), [](auto const& left, auto const& right) {
-        return left.first < right.first;
-    });
-
-    filter_result.count = unique_doc_ids.size();
-    filter_result.docs = new uint32_t[unique_doc_ids.size()];
-    filter_result.coll_to_references = new std::map<std::string, reference_filter_result_t>[unique_doc_ids.size()] {};
-
-    std::vector<uint32_t> previous_doc_references;
-    for (uint32_t i = 0, previous_doc = id_pairs[0].first + 1, result_index = 0; i < id_pairs.size(); i++) {
-        auto const& current_doc = id_pairs[i].first;
-        auto const& reference_doc_id = id_pairs[i].second;
-
-        if (current_doc != previous_doc) {
-            filter_result.docs[result_index] = current_doc;
-            if (result_index > 0) {
-                auto& reference_result = filter_result.coll_to_references[result_index - 1];
-
-                auto r = reference_filter_result_t(previous_doc_references.size(), new uint32_t[previous_doc_references.size()]);
-                std::copy(previous_doc_references.begin(), previous_doc_references.end(), r.docs);
-                reference_result[ref_collection_name] = std::move(r);
-
-                previous_doc_references.clear();
-            }
-
-            result_index++;
-            previous_doc = current_doc;
-            previous_doc_references.push_back(reference_doc_id);
-        } else {
-            previous_doc_references.push_back(reference_doc_id);
-        }
-    }
-
-    if (!previous_doc_references.empty()) {
-        auto& reference_result = filter_result.coll_to_references[filter_result.count - 1];
-
-        auto r = reference_filter_result_t(previous_doc_references.size(), new uint32_t[previous_doc_references.size()]);
-        std::copy(previous_doc_references.begin(), previous_doc_references.end(), r.docs);
-        reference_result[ref_collection_name] = std::move(r);
-    }
-
+    join.to_filter_result(ref_collection_name, true, filter_result);
     return Option(true);
 }
 
@@ -2332,7 +2736,7 @@ Option<filter_result_t> Index::do_filtering_with_reference_ids(const std::string
     filter_result_t filter_result;
     auto const& count = ref_filter_result.count;
     auto const& reference_docs = ref_filter_result.docs;
-    auto const is_nested_join = ref_filter_result.coll_to_references != nullptr;
+    auto const is_nested_join = ref_filter_result.has_references();
 
     if (count == 0) {
         return Option<filter_result_t>(filter_result);
@@ -2351,7 +2755,8 @@ Option<filter_result_t> Index::do_filtering_with_reference_ids(const std::string
 
         for (uint32_t i = 0; i < count; i++) {
             auto& reference_doc_id = reference_docs[i];
-            auto reference_doc_references = std::move(ref_filter_result.coll_to_references[i]);
+            std::map<std::string, reference_filter_result_t> reference_doc_references;
+            ref_filter_result.move_references(i, reference_doc_references);
             size_t doc_ids_len = 0;
             uint32_t* doc_ids = nullptr;
 
@@ -2416,8 +2821,8 @@ Option<filter_result_t> Index::do_filtering_with_reference_ids(const std::string
     }
 
     // Collect all the doc ids from the reference ids.
-    std::vector<std::pair<uint32_t, uint32_t>> id_pairs;
-    std::unordered_set<uint32_t> unique_doc_ids;
+    ReferenceJoin join;
+    join.reserve(count);
 
     for (uint32_t i = 0; i < count; i++) {
         auto& reference_doc_id = reference_docs[i];
@@ -2427,62 +2832,16 @@ Option<filter_result_t> Index::do_filtering_with_reference_ids(const std::string
         num_tree->search(NUM_COMPARATOR::EQUALS, reference_doc_id, &doc_ids, doc_ids_len);
 
         for (size_t j = 0; j < doc_ids_len; j++) {
-            auto doc_id = doc_ids[j];
-            id_pairs.emplace_back(std::make_pair(doc_id, reference_doc_id));
-            unique_doc_ids.insert(doc_id);
+            join.add(doc_ids[j], reference_doc_id);
         }
         delete[] doc_ids;
     }
 
-    if (id_pairs.empty()) {
+    if (join.empty()) {
         return Option(filter_result);
     }
 
-    std::sort(id_pairs.begin(), id_pairs.end(), [](auto const& left, auto const& right) {
-        return left.first < right.first;
-    });
-
-    filter_result.count = unique_doc_ids.size();
-    filter_result.docs = new uint32_t[unique_doc_ids.size()];
-    filter_result.coll_to_references = new std::map<std::string, reference_filter_result_t>[unique_doc_ids.size()] {};
-
-    std::vector<uint32_t> previous_doc_references;
-    for (uint32_t i = 0, previous_doc = id_pairs[0].first + 1, result_index = 0; i < id_pairs.size(); i++) {
-        auto const& current_doc = id_pairs[i].first;
-        auto const& reference_doc_id = id_pairs[i].second;
-
-        if (current_doc != previous_doc) {
-            filter_result.docs[result_index] = current_doc;
-            if (result_index > 0) {
-                auto& reference_result = filter_result.coll_to_references[result_index - 1];
-
-                auto r = reference_filter_result_t(previous_doc_references.size(),
-                                                   new uint32_t[previous_doc_references.size()],
-                                                   false);
-                std::copy(previous_doc_references.begin(), previous_doc_references.end(), r.docs);
-                reference_result[ref_collection_name] = std::move(r);
-
-                previous_doc_references.clear();
-            }
-
-            result_index++;
-            previous_doc = current_doc;
-            previous_doc_references.push_back(reference_doc_id);
-        } else {
-            previous_doc_references.push_back(reference_doc_id);
-        }
-    }
-
-    if (!previous_doc_references.empty()) {
-        auto& reference_result = filter_result.coll_to_references[filter_result.count - 1];
-
-        auto r = reference_filter_result_t(previous_doc_references.size(),
-                                           new uint32_t[previous_doc_references.size()],
-                                           false);
-        std::copy(previous_doc_references.begin(), previous_doc_references.end(), r.docs);
-        reference_result[ref_collection_name] = std::move(r);
-    }
-
+    join.to_filter_result(ref_collection_name, false, filter_result);
     return Option<filter_result_t>(filter_result);
 }
 
@@ -2957,70 +3316,359 @@ Option<bool> Index::search_infix(const std::string& query, const std::string& fi
     const auto parent_search_stop_ms = search_stop_us;
     auto parent_search_cutoff = search_cutoff;
 
-    for(auto infix_set: infix_sets) {
-        thread_pool->enqueue([infix_set, &leaves, search_tree, &query, max_extra_prefix, max_extra_suffix,
-                                     &num_processed, &m_process, &cv_process,
-                                     &parent_search_begin, &parent_search_stop_ms, &parent_search_cutoff]() {
+    for(auto infix_set: infix_sets) {
+        thread_pool->enqueue([infix_set, &leaves, search_tree, &query, max_extra_prefix, max_extra_suffix,
+                                     &num_processed, &m_process, &cv_process,
+                                     &parent_search_begin, &parent_search_stop_ms, &parent_search_cutoff]() {
+
+            search_begin_us = parent_search_begin;
+            search_cutoff = false;
+            auto op_search_stop_ms = parent_search_stop_ms/2;
+
+            std::vector<art_leaf*> this_leaves;
+            std::string key_buffer;
+            size_t num_iterated = 0;
+
+            for(auto it = infix_set->begin(); it != infix_set->end(); it++) {
+                it.key(key_buffer);
+                num_iterated++;
+
+                auto start_index = key_buffer.find(query);
+                if(start_index != std::string::npos && start_index <= max_extra_prefix &&
+                   (key_buffer.size() - (start_index + query.size())) <= max_extra_suffix) {
+                    art_leaf* l = (art_leaf *) art_search(search_tree,
+                                                          (const unsigned char *) key_buffer.c_str(),
+                                                          key_buffer.size()+1);
+                    if(l != nullptr) {
+                        this_leaves.push_back(l);
+                    }
+                }
+
+                // check for search cutoff but only once every 2^10 docs to reduce overhead
+                if(((num_iterated + 1) % (1 << 12)) == 0) {
+                    if ((std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().
+                        time_since_epoch()).count() - search_begin_us) > op_search_stop_ms) {
+                        search_cutoff = true;
+                        break;
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(m_process);
+            leaves.insert(leaves.end(), this_leaves.begin(), this_leaves.end());
+            num_processed++;
+            parent_search_cutoff = parent_search_cutoff || search_cutoff;
+            cv_process.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock_process(m_process);
+    cv_process.wait(lock_process, [&](){ return num_processed == infix_sets.size(); });
+    search_cutoff = parent_search_cutoff;
+
+    for(auto leaf: leaves) {
+        posting_t::merge({leaf->values}, ids);
+    }
+
+    return Option<bool>(true);
+}
+
+void VectorFilterFunctor::compute_filter_ids_bitmap() {
+    filter_result_iterator->reset();
+    filter_ids_bitmap.clear();
+
+    while (filter_result_iterator->validity == filter_result_iterator_t::valid) {
+        const uint32_t seq_id = filter_result_iterator->seq_id;
+        const size_t word_index = seq_id >> 6;
+        if (word_index >= filter_ids_bitmap.size()) {
+            filter_ids_bitmap.resize(word_index + 1, 0);
+        }
+
+        filter_ids_bitmap[word_index] |= (uint64_t(1) << (seq_id & 63));
+        filter_result_iterator->next();
+    }
+
+    // a filter that timed out is still checked lazily
+    use_filter_ids_bitmap = filter_result_iterator->validity != filter_result_iterator_t::timed_out;
+
+    for (uint32_t i = 0; excluded_ids != nullptr && i < excluded_ids_length; i++) {
+        const size_t word_index = excluded_ids[i] >> 6;
+        if (word_index < filter_ids_bitmap.size()) {
+            filter_ids_bitmap[word_index] &= ~(uint64_t(1) << (excluded_ids[i] & 63));
+        }
+    }
+
+    filter_result_iterator->reset();
+}
+
+struct vector_search_plan_t {
+    bool bruteforce = false;
+    size_t ef = 0;
+};
+
+// Picks between a scan over the filtered ids and a filtered graph search, based on the selectivity of the filter.
+//
+// A graph search whose filter matches a fraction `s` of the vectors has to visit about `ef / s` nodes to collect `ef`
+// matching ones, computing the distances of up to `M` neighbours at each of them, while a scan computes one distance
+// for each of the `s * N` filtered vectors. Since fewer of the visited nodes match a selective filter, the graph
+// search also widens its candidate list to keep its recall.
+//
+// An explicit `flat_search_cutoff` overrides the plan.
+vector_search_plan_t plan_vector_search(const vector_query_t& vector_query, hnsw_index_t* field_vector_index,
+                                        const bool filter_by_provided, const uint32_t filter_id_count, const size_t k) {
+    static constexpr size_t MAX_EF_FACTOR = 8;
+
+    vector_search_plan_t plan;
+    plan.ef = vector_query.ef;
+
+    if (!filter_by_provided) {
+        return plan;
+    }
+
+    if (vector_query.flat_search_cutoff_given) {
+        plan.bruteforce = filter_id_count < vector_query.flat_search_cutoff;
+        return plan;
+    }
+
+    const size_t num_docs = field_vector_index->get_num_docs();
+    if (filter_id_count == 0 || filter_id_count >= num_docs) {
+        plan.bruteforce = (filter_id_count == 0);
+        return plan;
+    }
+
+    const double selectivity = double(filter_id_count) / num_docs;
+    const size_t base_ef = std::max<size_t>(vector_query.ef, k);
+    plan.ef = std::min<size_t>(size_t(base_ef / selectivity), base_ef * MAX_EF_FACTOR);
+
+    const double graph_search_cost = double(field_vector_index->M) * plan.ef / selectivity;
+    plan.bruteforce = filter_id_count <= graph_search_cost;
+
+    return plan;
+}
+
+// The query of a multi-vector field can hold several vectors, e.g. one per query token.
+std::vector<float> get_multi_vector_query(const vector_query_t& vector_query, hnsw_index_t* field_vector_index) {
+    const size_t num_dim = field_vector_index->num_dim;
+    std::vector<float> query_vectors = vector_query.values;
+
+    if (field_vector_index->distance_type == cosine) {
+        std::vector<float> query_vector(num_dim);
+        std::vector<float> normalized_q(num_dim);
+
+        for (size_t offset = 0; offset + num_dim <= query_vectors.size(); offset += num_dim) {
+            query_vector.assign(query_vectors.begin() + offset, query_vectors.begin() + offset + num_dim);
+            hnsw_index_t::normalize_vector(query_vector, normalized_q);
+            std::copy(normalized_q.begin(), normalized_q.end(), query_vectors.begin() + offset);
+        }
+    }
+
+    return query_vectors;
+}
+
+// MaxSim distance of a document of a multi-vector field: the distance of each query vector to the nearest vector of
+// the document, averaged over the query vectors. Returns false when the document has no vectors.
+bool compute_multi_vector_distance(hnsw_index_t* field_vector_index, const std::vector<float>& query_vectors,
+                                   const uint32_t seq_id, float& distance) {
+    const size_t num_dim = field_vector_index->num_dim;
+    const size_t num_query_vectors = query_vectors.size() / num_dim;
+    const uint32_t num_doc_vectors = field_vector_index->get_num_doc_vectors(seq_id);
+
+    if (num_query_vectors == 0 || num_doc_vectors == 0) {
+        return false;
+    }
+
+    std::vector<float> block(num_dim * VectorDistance::BLOCK_SIZE);
+    std::vector<float> min_distances(num_query_vectors, std::numeric_limits<float>::max());
+    float distances[VectorDistance::BLOCK_SIZE];
+    size_t num_block_vectors = 0;
+    bool found = false;
+
+    auto process_block = [&]() {
+        for (size_t q = 0; q < num_query_vectors; q++) {
+            VectorDistance::inner_product_distances(query_vectors.data() + q * num_dim, block.data(), num_dim,
+                                                    distances);
+            for (size_t lane = 0; lane < num_block_vectors; lane++) {
+                min_distances[q] = std::min(min_distances[q], distances[lane]);
+            }
+        }
+
+        found = true;
+        num_block_vectors = 0;
+    };
+
+    for (uint32_t i = 0; i < num_doc_vectors; i++) {
+        std::vector<float> values;
+
+        try {
+            values = field_vector_index->vecdex->getDataByLabel<float>(hnsw_index_t::get_label(seq_id, i));
+        } catch (...) {
+            // likely not found
+            continue;
+        }
+
+        VectorDistance::set_block_vector(block.data(), num_dim, num_block_vectors, values.data());
+        num_block_vectors++;
+
+        if (num_block_vectors == VectorDistance::BLOCK_SIZE) {
+            process_block();
+        }
+    }
+
+    if (num_block_vectors != 0) {
+        process_block();
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    distance = std::accumulate(min_distances.begin(), min_distances.end(), 0.0f) / num_query_vectors;
+    return true;
+}
+
+// Checks the document of a vector of a multi-vector field against the filter.
+class MultiVectorFilterFunctor: public hnswlib::BaseFilterFunctor {
+    VectorFilterFunctor& filter_functor;
+
+public:
+
+    explicit MultiVectorFilterFunctor(VectorFilterFunctor& filter_functor): filter_functor(filter_functor) {}
+
+    bool operator()(hnswlib::labeltype label) override {
+        return filter_functor(hnsw_index_t::get_seq_id(label));
+    }
+};
+
+// Finds the nearest vectors of each query vector, and ranks their documents by the MaxSim distance.
+std::vector<std::pair<float, size_t>> search_multi_vector_index(const std::vector<float>& query_vectors,
+                                                                hnsw_index_t* field_vector_index,
+                                                                VectorFilterFunctor& filterFunctor,
+                                                                const size_t k, const size_t ef) {
+    // since the nearest vectors can belong to the same documents, more of them are fetched to find `k` documents
+    static constexpr size_t CANDIDATE_VECTORS_FACTOR = 4;
+
+    const size_t num_dim = field_vector_index->num_dim;
+    const size_t num_candidate_vectors = k * CANDIDATE_VECTORS_FACTOR;
+    MultiVectorFilterFunctor multi_vector_filter_functor(filterFunctor);
+
+    std::vector<uint32_t> candidate_ids;
+    for (size_t offset = 0; offset + num_dim <= query_vectors.size(); offset += num_dim) {
+        auto pairs = field_vector_index->vecdex->searchKnnCloserFirst(query_vectors.data() + offset,
+                                                                      num_candidate_vectors,
+                                                                      std::max(ef, num_candidate_vectors),
+                                                                      &multi_vector_filter_functor);
+        for (const auto& pair: pairs) {
+            candidate_ids.push_back(hnsw_index_t::get_seq_id(pair.second));
+        }
+    }
+
+    std::sort(candidate_ids.begin(), candidate_ids.end());
+    candidate_ids.erase(std::unique(candidate_ids.begin(), candidate_ids.end()), candidate_ids.end());
+
+    std::vector<std::pair<float, size_t>> results;
+    for (const auto seq_id: candidate_ids) {
+        float distance;
+        if (compute_multi_vector_distance(field_vector_index, query_vectors, seq_id, distance)) {
+            results.emplace_back(distance, seq_id);
+        }
+    }
+
+    auto by_distance = [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    };
+
+    if (results.size() > k) {
+        std::partial_sort(results.begin(), results.begin() + k, results.end(), by_distance);
+        results.erase(results.begin() + k, results.end());
+    } else {
+        std::sort(results.begin(), results.end(), by_distance);
+    }
+
+    return results;
+}
+
+// Scans the vectors of the filtered documents, a block of vectors at a time.
+//
+// When `k` is given, only the `k` nearest results are kept, ordered by distance like the results of a graph search.
+void process_results_bruteforce(filter_result_iterator_t* filter_result_iterator, const vector_query_t& vector_query,
+                                hnsw_index_t* field_vector_index,
+                                const uint32_t* excluded_result_ids, const size_t excluded_result_ids_size,
+                                const size_t k, const bool apply_distance_threshold,
+                                std::vector<std::pair<float, single_filter_result_t>>& dist_results) {
 
-            search_begin_us = parent_search_begin;
-            search_cutoff = false;
-            auto op_search_stop_ms = parent_search_stop_ms/2;
+    const size_t num_dim = field_vector_index->num_dim;
+    const float* query = vector_query.values.data();
 
-            std::vector<art_leaf*> this_leaves;
-            std::string key_buffer;
-            size_t num_iterated = 0;
+    std::vector<float> normalized_q;
+    if (field_vector_index->distance_type == cosine && !field_vector_index->multi_vector) {
+        normalized_q.resize(vector_query.values.size());
+        hnsw_index_t::normalize_vector(vector_query.values, normalized_q);
+        query = normalized_q.data();
+    }
 
-            for(auto it = infix_set->begin(); it != infix_set->end(); it++) {
-                it.key(key_buffer);
-                num_iterated++;
+    std::vector<float> block(num_dim * VectorDistance::BLOCK_SIZE);
+    std::vector<single_filter_result_t> block_filter_results;
+    block_filter_results.reserve(VectorDistance::BLOCK_SIZE);
+    float distances[VectorDistance::BLOCK_SIZE];
 
-                auto start_index = key_buffer.find(query);
-                if(start_index != std::string::npos && start_index <= max_extra_prefix &&
-                   (key_buffer.size() - (start_index + query.size())) <= max_extra_suffix) {
-                    art_leaf* l = (art_leaf *) art_search(search_tree,
-                                                          (const unsigned char *) key_buffer.c_str(),
-                                                          key_buffer.size()+1);
-                    if(l != nullptr) {
-                        this_leaves.push_back(l);
-                    }
-                }
+    auto by_distance = [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    };
 
-                // check for search cutoff but only once every 2^10 docs to reduce overhead
-                if(((num_iterated + 1) % (1 << 12)) == 0) {
-                    if ((std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().
-                        time_since_epoch()).count() - search_begin_us) > op_search_stop_ms) {
-                        search_cutoff = true;
-                        break;
-                    }
-                }
+    auto add_result = [&](const float dist, single_filter_result_t&& filter_result) {
+        if (apply_distance_threshold) {
+            auto vec_dist_score = (field_vector_index->distance_type == cosine) ? std::abs(dist) : dist;
+            if (vec_dist_score > vector_query.distance_threshold) {
+                return;
             }
+        }
 
-            std::unique_lock<std::mutex> lock(m_process);
-            leaves.insert(leaves.end(), this_leaves.begin(), this_leaves.end());
-            num_processed++;
-            parent_search_cutoff = parent_search_cutoff || search_cutoff;
-            cv_process.notify_one();
-        });
-    }
+        if (k == 0) {
+            dist_results.emplace_back(dist, std::move(filter_result));
+        } else if (dist_results.size() < k) {
+            dist_results.emplace_back(dist, std::move(filter_result));
+            std::push_heap(dist_results.begin(), dist_results.end(), by_distance);
+        } else if (dist < dist_results.front().first) {
+            std::pop_heap(dist_results.begin(), dist_results.end(), by_distance);
+            dist_results.back().first = dist;
+            dist_results.back().second = std::move(filter_result);
+            std::push_heap(dist_results.begin(), dist_results.end(), by_distance);
+        }
+    };
 
-    std::unique_lock<std::mutex> lock_process(m_process);
-    cv_process.wait(lock_process, [&](){ return num_processed == infix_sets.size(); });
-    search_cutoff = parent_search_cutoff;
+    auto process_block = [&]() {
+        VectorDistance::inner_product_distances(query, block.data(), num_dim, distances);
 
-    for(auto leaf: leaves) {
-        posting_t::merge({leaf->values}, ids);
-    }
+        for (size_t lane = 0; lane < block_filter_results.size(); lane++) {
+            add_result(distances[lane], std::move(block_filter_results[lane]));
+        }
 
-    return Option<bool>(true);
-}
+        block_filter_results.clear();
+    };
 
-void process_results_bruteforce(filter_result_iterator_t* filter_result_iterator, const vector_query_t& vector_query,
-                                    hnsw_index_t* field_vector_index, std::vector<std::pair<float, single_filter_result_t>>& dist_results) {
+    std::vector<float> multi_vector_query;
+    if (field_vector_index->multi_vector) {
+        multi_vector_query = get_multi_vector_query(vector_query, field_vector_index);
+    }
 
     while (filter_result_iterator->validity == filter_result_iterator_t::valid) {
         auto seq_id = filter_result_iterator->seq_id;
         auto filter_result = single_filter_result_t(seq_id, std::move(filter_result_iterator->reference));
         filter_result_iterator->next();
+
+        if (excluded_result_ids_size != 0 &&
+            std::binary_search(excluded_result_ids, excluded_result_ids + excluded_result_ids_size, seq_id)) {
+            continue;
+        }
+
+        if (field_vector_index->multi_vector) {
+            float dist;
+            if (compute_multi_vector_distance(field_vector_index, multi_vector_query, seq_id, dist)) {
+                add_result(dist, std::move(filter_result));
+            }
+            continue;
+        }
+
         std::vector<float> values;
 
         try {
@@ -3030,32 +3678,37 @@ void process_results_bruteforce(filter_result_iterator_t* filter_result_iterator
             continue;
         }
 
-        float dist;
-        if (field_vector_index->distance_type == cosine) {
-            std::vector<float> normalized_q(vector_query.values.size());
-            hnsw_index_t::normalize_vector(vector_query.values, normalized_q);
-            dist = field_vector_index->space->get_dist_func()(normalized_q.data(), values.data(),
-                                                              &field_vector_index->num_dim);
-        } else {
-            dist = field_vector_index->space->get_dist_func()(vector_query.values.data(), values.data(),
-                                                              &field_vector_index->num_dim);
+        VectorDistance::set_block_vector(block.data(), num_dim, block_filter_results.size(), values.data());
+        block_filter_results.push_back(std::move(filter_result));
+
+        if (block_filter_results.size() == VectorDistance::BLOCK_SIZE) {
+            process_block();
         }
+    }
 
-        dist_results.emplace_back(dist, filter_result);
+    if (!block_filter_results.empty()) {
+        process_block();
+    }
+
+    if (k != 0) {
+        std::sort_heap(dist_results.begin(), dist_results.end(), by_distance);
     }
 }
 
 void process_results_hnsw_index(filter_result_iterator_t* filter_result_iterator, const vector_query_t& vector_query,
-                               hnsw_index_t* field_vector_index, VectorFilterFunctor& filterFunctor, size_t k,
+                               hnsw_index_t* field_vector_index, VectorFilterFunctor& filterFunctor, size_t k, size_t ef,
                                 std::vector<std::pair<float, single_filter_result_t>>& dist_results, bool is_wildcard_non_phrase_query = false) {
 
     std::vector<std::pair<float, size_t>> pairs;
-    if(field_vector_index->distance_type == cosine) {
+    if(field_vector_index->multi_vector) {
+        pairs = search_multi_vector_index(get_multi_vector_query(vector_query, field_vector_index), field_vector_index,
+                                          filterFunctor, k, ef);
+    } else if(field_vector_index->distance_type == cosine) {
         std::vector<float> normalized_q(vector_query.values.size());
         hnsw_index_t::normalize_vector(vector_query.values, normalized_q);
-        pairs = field_vector_index->vecdex->searchKnnCloserFirst(normalized_q.data(), k, vector_query.ef, &filterFunctor);
+        pairs = field_vector_index->vecdex->searchKnnCloserFirst(normalized_q.data(), k, ef, &filterFunctor);
     } else {
-        pairs = field_vector_index->vecdex->searchKnnCloserFirst(vector_query.values.data(), k, vector_query.ef, &filterFunctor);
+        pairs = field_vector_index->vecdex->searchKnnCloserFirst(vector_query.values.data(), k, ef, &filterFunctor);
     }
 
     std::sort(pairs.begin(), pairs.end(), [](auto& x, auto& y) {
@@ -3214,8 +3867,13 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
     bool const& filter_by_provided = filter_tree_root != nullptr;
     bool const& no_filter_by_matches = filter_by_provided && filter_result_iterator->approx_filter_ids_length == 0;
 
+    // disjunctive facets can have counts even when the filter has no matches
+    const bool has_disjunctive_facets = std::any_of(facets.begin(), facets.end(), [](const facet& a_facet) {
+        return a_facet.is_disjunctive;
+    });
+
     // If curation is not involved and there are no filter matches, return early.
-    if (curated_ids_sorted.empty() && no_filter_by_matches) {
+    if (curated_ids_sorted.empty() && no_filter_by_matches && !has_disjunctive_facets) {
         return Option(true);
     }
 
@@ -3343,13 +4001,19 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
             filter_result_iterator->compute_iterators();
 
             uint32_t filter_id_count = filter_result_iterator->approx_filter_ids_length;
+            auto plan = plan_vector_search(vector_query, field_vector_index, filter_by_provided, filter_id_count, k);
 
-            if (filter_by_provided && filter_id_count < vector_query.flat_search_cutoff) {
-                process_results_bruteforce(filter_result_iterator, vector_query, field_vector_index, dist_results);
-            } else if(!filter_by_provided ||
-                (filter_id_count >= vector_query.flat_search_cutoff && filter_result_iterator->validity == filter_result_iterator_t::valid)) {
+            if (plan.bruteforce) {
+                process_results_bruteforce(filter_result_iterator, vector_query, field_vector_index,
+                                           excluded_result_ids, excluded_result_ids_size,
+                                           vector_query.flat_search_cutoff_given ? 0 : k, false, dist_results);
+            } else if(!filter_by_provided || filter_result_iterator->validity == filter_result_iterator_t::valid) {
                 dist_results.clear();
-                process_results_hnsw_index(filter_result_iterator, vector_query, field_vector_index, filterFunctor, k, dist_results, true);
+                if (filter_by_provided) {
+                    filterFunctor.compute_filter_ids_bitmap();
+                }
+                process_results_hnsw_index(filter_result_iterator, vector_query, field_vector_index, filterFunctor, k,
+                                           plan.ef, dist_results, true);
             }
 
             search_cutoff = search_cutoff || filter_result_iterator->validity == filter_result_iterator_t::timed_out;
@@ -3716,16 +4380,25 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                 uint32_t filter_id_count = filter_result_iterator->approx_filter_ids_length;
                 std::vector<std::pair<float, single_filter_result_t>> dist_results;
 
-                if (filter_by_provided && filter_id_count < vector_query.flat_search_cutoff) {
-                    process_results_bruteforce(filter_result_iterator, vector_query, field_vector_index, dist_results);
-                } else if (!filter_by_provided || (filter_id_count >= vector_query.flat_search_cutoff && filter_result_iterator->validity == filter_result_iterator_t::valid)) {
-                    dist_results.clear();
-                    // use k as 100 by default for ensuring results stability in pagination
-                    size_t default_k = 100;
-                    auto k = vector_query.k == 0 ? std::max<size_t>(fetch_size, default_k)
-                                                 : vector_query.k;
+                // use k as 100 by default for ensuring results stability in pagination
+                size_t default_k = 100;
+                auto k = vector_query.k == 0 ? std::max<size_t>(fetch_size, default_k)
+                                             : vector_query.k;
 
-                    process_results_hnsw_index(filter_result_iterator, vector_query, field_vector_index, filterFunctor, k, dist_results);
+                auto plan = plan_vector_search(vector_query, field_vector_index, filter_by_provided, filter_id_count, k);
+
+                if (plan.bruteforce) {
+                    process_results_bruteforce(filter_result_iterator, vector_query, field_vector_index,
+                                               excluded_result_ids, excluded_result_ids_size,
+                                               vector_query.flat_search_cutoff_given ? 0 : k,
+                                               !vector_query.flat_search_cutoff_given, dist_results);
+                } else if (!filter_by_provided || filter_result_iterator->validity == filter_result_iterator_t::valid) {
+                    dist_results.clear();
+                    if (filter_by_provided) {
+                        filterFunctor.compute_filter_ids_bitmap();
+                    }
+                    process_results_hnsw_index(filter_result_iterator, vector_query, field_vector_index, filterFunctor,
+                                               k, plan.ef, dist_results);
                 }
 
                 std::unordered_map<uint32_t, uint32_t> seq_id_to_rank;
@@ -3914,6 +4587,32 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
     std::vector<uint32_t> top_k_result_ids, top_k_curated_result_ids;
     std::vector<facet> top_k_facets;
 
+    // facet index => ids that the facet is counted over
+    std::map<uint32_t, std::vector<uint32_t>> disjunctive_facet_ids;
+
+    if(has_disjunctive_facets && is_wildcard_non_phrase_query && vector_query.field_name.empty() && filter_by_provided) {
+        for(const auto& a_facet: facets) {
+            if(!a_facet.is_disjunctive || a_facet.is_top_k) {
+                continue;
+            }
+
+            std::vector<uint32_t> facet_result_ids;
+            auto disjunctive_op = get_disjunctive_facet_ids(filter_tree_root.get(), a_facet.field_name,
+                                                            excluded_result_ids, excluded_result_ids_size,
+                                                            facet_result_ids);
+            if(!disjunctive_op.ok()) {
+                delete [] exclude_token_ids;
+                delete [] excluded_result_ids;
+                delete [] all_result_ids;
+                return disjunctive_op;
+            }
+
+            if(disjunctive_op.get()) {
+                disjunctive_facet_ids.emplace(a_facet.orig_index, std::move(facet_result_ids));
+            }
+        }
+    }
+
     delete [] exclude_token_ids;
     delete [] excluded_result_ids;
 
@@ -3935,6 +4634,31 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                             group_by_fields, group_limit, is_wildcard_no_filter_query,
                             max_candidates, facet_infos, facet_index_types);
 
+        // facet counts of a wildcard query depend only on the filter, so they can be reused across requests
+        const bool can_cache_facet_counts = is_wildcard_non_phrase_query && vector_query.field_name.empty() &&
+                                            curated_ids_sorted.empty() && group_limit == 0 &&
+                                            !estimate_facets && !search_cutoff &&
+                                            (!filter_by_provided ||
+                                             (!filter_tree_root->filter_query.empty() &&
+                                              !filter_tree_root->has_reference_filter()));
+
+        if(!override_result_kvs.empty() &&
+           std::any_of(facets.begin(), facets.end(), [](const facet& a_facet) { return a_facet.is_top_k; })) {
+            get_top_k_result_ids(override_result_kvs, top_k_curated_result_ids);
+        }
+
+        for(size_t i = 0; i < facets.size(); i++) {
+            facet_infos[i].curated_ids = facets[i].is_top_k ? top_k_curated_result_ids : included_ids_vec;
+        }
+
+        for(size_t i = 0; i < facets.size() && can_cache_facet_counts; i++) {
+            if(!facets[i].is_top_k && disjunctive_facet_ids.count(facets[i].orig_index) == 0 &&
+               use_facet_counts_cache(facets[i], facet_infos[i])) {
+                facet_infos[i].use_facet_counts_cache = true;
+                facet_infos[i].facet_counts_filter = filter_by_provided ? filter_tree_root->filter_query : "";
+            }
+        }
+
         std::vector<std::vector<facet>> facet_batches(num_threads);
         std::vector<std::vector<facet>> value_facets(concurrency);
 
@@ -3949,8 +4673,14 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                 continue;
             }
 
-            if(facet_infos[i].use_value_index) {
-                // value based faceting on a single thread
+            if(disjunctive_facet_ids.count(this_facet.orig_index) != 0) {
+                continue;
+            }
+
+            if(facet_infos[i].use_value_index || facet_infos[i].use_dense_counts ||
+               facet_infos[i].use_facet_counts_cache || facet_infos[i].use_sketch) {
+                // value based, dense count based, cached and sketch based faceting on a single thread, since they
+                // need the entire result set to pick the top values
                 value_facets[num_value_facets % num_threads].emplace_back(this_facet.field_name, this_facet.orig_index,
                                           this_facet.is_top_k, this_facet.facet_range_map,
                                           this_facet.is_range_query, this_facet.is_sort_by_alpha,
@@ -4003,7 +4733,7 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                                          is_wildcard_no_filter_query, estimate_facets,
                                          facet_sample_percent, group_missing_values,
                                          &parent_search_begin, &parent_search_stop_ms, &parent_search_cutoff,
-                                         &num_processed, &m_process, &cv_process, &facet_index_types]() {
+                                         &num_processed, &m_process, &cv_process, facet_index_types]() {
                 search_begin_us = parent_search_begin;
                 search_stop_us = parent_search_stop_ms;
                 search_cutoff = false;
@@ -4030,7 +4760,7 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
             result_index += batch_res_len;
         }
 
-        // do value based faceting field-wise parallel but on the entire result set
+        // do value based, dense count based and cached faceting field-wise parallel but on the entire result set
         for(size_t thread_id = 0; thread_id < concurrency && num_value_facets > 0; thread_id++) {
             if(value_facets[thread_id].empty()) {
                 continue;
@@ -4068,6 +4798,69 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
             });
         }
 
+        // each disjunctive facet is counted on a thread of its own, over its own result ids
+        std::vector<std::vector<facet>> disjunctive_facets;
+        std::vector<std::vector<facet_info_t>> disjunctive_facet_infos;
+
+        for(auto& facet_ids: disjunctive_facet_ids) {
+            const auto& this_facet = facets[facet_ids.first];
+            auto& facet_result_ids = facet_ids.second;
+
+            disjunctive_facets.emplace_back();
+            disjunctive_facets.back().emplace_back(this_facet.field_name, this_facet.orig_index, this_facet.is_top_k,
+                                                   this_facet.facet_range_map, this_facet.is_range_query,
+                                                   this_facet.is_sort_by_alpha, this_facet.sort_order,
+                                                   this_facet.sort_field);
+
+            disjunctive_facet_infos.emplace_back(1);
+            compute_facet_infos(disjunctive_facets.back(), facet_query, facet_query_num_typos,
+                                facet_result_ids.data(), facet_result_ids.size(), group_by_fields, group_limit,
+                                false, max_candidates, disjunctive_facet_infos.back(), facet_index_types);
+            disjunctive_facet_infos.back()[0].curated_ids = included_ids_vec;
+
+            // the facet is counted against its own single facet info, and aggregated by `disjunctive_facet_ids`
+            disjunctive_facets.back()[0].orig_index = 0;
+        }
+
+        size_t disjunctive_index = 0;
+        for(const auto& facet_ids: disjunctive_facet_ids) {
+            const size_t facet_index = disjunctive_index++;
+            const std::vector<uint32_t>& facet_result_ids = facet_ids.second;
+
+            if(facet_result_ids.empty()) {
+                continue;
+            }
+
+            num_queued++;
+
+            const uint32_t acc_facet_index = facet_ids.first;
+
+            thread_pool->enqueue([this, facet_index, acc_facet_index, &facets, &disjunctive_facets,
+                                         &disjunctive_facet_infos, &facet_result_ids, &facet_query,
+                                         group_limit, group_by_fields,
+                                         max_facet_values, estimate_facets, facet_sample_percent, group_missing_values,
+                                         &parent_search_begin, &parent_search_stop_ms, &parent_search_cutoff,
+                                         &num_processed, &m_process, &cv_process, facet_index_types]() {
+                search_begin_us = parent_search_begin;
+                search_stop_us = parent_search_stop_ms;
+                search_cutoff = false;
+
+                auto fq = facet_query;
+                do_facets(disjunctive_facets[facet_index], fq, estimate_facets, facet_sample_percent,
+                          disjunctive_facet_infos[facet_index], group_limit, group_by_fields, group_missing_values,
+                          facet_result_ids.data(), facet_result_ids.size(), max_facet_values,
+                          false, facet_index_types);
+
+                std::unique_lock<std::mutex> lock(m_process);
+
+                aggregate_facet(group_limit, disjunctive_facets[facet_index][0], facets[acc_facet_index]);
+
+                num_processed++;
+                parent_search_cutoff = parent_search_cutoff || search_cutoff;
+                cv_process.notify_one();
+            });
+        }
+
         std::unique_lock<std::mutex> lock_process(m_process);
         cv_process.wait(lock_process, [&](){ return num_processed == num_queued; });
         search_cutoff = parent_search_cutoff;
@@ -4106,7 +4899,6 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
               facet_index_types);
 
     if(top_k_facets.size() >  0) {
-        get_top_k_result_ids(override_result_kvs, top_k_curated_result_ids);
         do_facets(top_k_facets, facet_query, estimate_facets, facet_sample_percent,
                   facet_infos, group_limit, group_by_fields, group_missing_values, top_k_curated_result_ids.data(),
                   top_k_curated_result_ids.size(), max_facet_values, is_wildcard_no_filter_query,
@@ -4150,10 +4942,15 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
 
 void Index::aggregate_facet(const size_t group_limit, facet& this_facet, facet& acc_facet) const {
     acc_facet.is_intersected = this_facet.is_intersected;
+    acc_facet.is_sketched = acc_facet.is_sketched || this_facet.is_sketched;
+    acc_facet.sampled = acc_facet.sampled || this_facet.sampled;
     acc_facet.is_sort_by_alpha = this_facet.is_sort_by_alpha;
     acc_facet.sort_order = this_facet.sort_order;
     acc_facet.sort_field = this_facet.sort_field;
 
+    // facets that keep only their top values are counted over the entire result set, by a single thread
+    acc_facet.num_distinct_values = std::max(acc_facet.num_distinct_values, this_facet.num_distinct_values);
+
     for(auto & facet_kv: this_facet.result_map) {
         uint32_t fhash = 0;
         if(group_limit) {
@@ -4191,6 +4988,8 @@ void Index::aggregate_facet(const size_t group_limit, facet& this_facet, facet&
         }
 
         acc_facet.value_result_map[facet_kv.first].count = count;
+        acc_facet.value_result_map[facet_kv.first].count_lower += facet_kv.second.count_lower;
+        acc_facet.value_result_map[facet_kv.first].count_upper += facet_kv.second.count_upper;
 
         acc_facet.value_result_map[facet_kv.first].doc_id = facet_kv.second.doc_id;
         acc_facet.value_result_map[facet_kv.first].array_pos = facet_kv.second.array_pos;
@@ -4755,15 +5554,20 @@ int64_t Index::compute_aggregated_score(const std::vector<or_iterator_t>& its,
                                  const tsl::htrie_map<char, field>& search_schema,
                                  const std::vector<std::vector<art_leaf*>>& searched_queries,
                                  const int* sort_order,
-                                 int64_t& out_best_field_match_score) {
+                                 int64_t& out_best_field_match_score,
+                                 const bm25_stats_t* bm25_stats) {
     // Convert [token -> fields] orientation to [field -> tokens] orientation
     std::vector<std::vector<posting_list_t::iterator_t>> field_to_tokens(num_search_fields);
     size_t query_len = 0;
 
+    const bool compute_bm25 = (match_type == bm25 && bm25_stats != nullptr);
+    float bm25_score = 0;
+
     for(size_t ti = 0; ti < its.size(); ti++) {
         const or_iterator_t& token_fields_iters = its[ti];
         const std::vector<posting_list_t::iterator_t>& field_iters = token_fields_iters.get_its();
         bool found_token = false;
+        float weighted_tf = 0;
 
         for(size_t fi = 0; fi < field_iters.size(); fi++) {
             const posting_list_t::iterator_t& field_iter = field_iters[fi];
@@ -4771,11 +5575,24 @@ int64_t Index::compute_aggregated_score(const std::vector<or_iterator_t>& its,
                 // not all fields might contain a given token
                 field_to_tokens[field_iter.get_field_id()].push_back(field_iter.clone());
                 found_token = true;
+
+                if(compute_bm25) {
+                    const auto field_id = field_iter.get_field_id();
+                    const auto field_lengths = bm25_stats->field_lengths[field_id];
+                    const uint32_t tf = posting_list_t::get_num_positions(field_iter, bm25_stats->field_is_arrays[field_id]);
+                    const uint32_t field_len = field_lengths ? field_lengths->get_length(seq_id) : 0;
+                    const size_t field_weight = std::max<size_t>(1, the_fields[field_id].weight);
+                    weighted_tf += field_weight * bm25_t::normalized_tf(tf, field_len, bm25_stats->avg_field_lengths[field_id]);
+                }
             }
         }
 
         if(found_token) {
             query_len++;
+
+            if(compute_bm25 && ti < bm25_stats->token_idfs.size()) {
+                bm25_score += bm25_t::token_score(bm25_stats->token_idfs[ti], weighted_tf);
+            }
         }
     }
 
@@ -4814,6 +5631,12 @@ int64_t Index::compute_aggregated_score(const std::vector<or_iterator_t>& its,
             continue;
         }
 
+        if(match_type == bm25) {
+            // field level match scores are not used in BM25 scoring
+            num_matching_fields++;
+            continue;
+        }
+
         const int64_t field_weight = the_fields[fi].weight;
         const bool field_is_array = search_schema.at(the_fields[fi].name).is_array();
 
@@ -4848,6 +5671,13 @@ int64_t Index::compute_aggregated_score(const std::vector<or_iterator_t>& its,
         num_matching_fields++;
     }
 
+    if(match_type == bm25) {
+        // typo corrected candidates are scored lower than the exact tokens
+        bm25_score = bm25_score / (1 + total_cost);
+        best_field_match_score = (num_matching_fields == 0) ? 0 : bm25_t::scaled_score(bm25_score);
+        sum_field_weighted_score = best_field_match_score;
+    }
+
     query_len = (best_field_match_score == 0) ? 0 : std::min<size_t>(15, query_len);
 
     // NOTE: `query_len` is total tokens matched across fields.
@@ -4865,6 +5695,10 @@ int64_t Index::compute_aggregated_score(const std::vector<or_iterator_t>& its,
     // [ sign | tokens_matched | sum_field_score  | num_matching_fields ]
     // [   1  |        4       |       56         |         3           ]  (64 bits)
 
+    // BM25
+    // [ sign | tokens_matched | bm25_score  | num_matching_fields ]
+    // [   1  |        4       |     56      |         3           ]  (64 bits)
+
     auto max_field_weight = std::min<size_t>(FIELD_MAX_WEIGHT, best_field_weight);
     num_matching_fields = std::min<size_t>(7, num_matching_fields);
 
@@ -4885,7 +5719,7 @@ int64_t Index::compute_aggregated_score(const std::vector<or_iterator_t>& its,
                             (int64_t(best_field_match_score) << 3) |
                             (int64_t(num_matching_fields) << 0));
     } else {
-        // sum_score
+        // sum_score and bm25
         aggregated_score = ((int64_t(query_len) << 59) |
                             (int64_t(sum_field_weighted_score) << 3) |
                             (int64_t(num_matching_fields) << 0));
@@ -4971,7 +5805,14 @@ Option<bool> Index::search_across_fields(const std::vector<token_t>& query_token
     // used to track plists that must be destructed once done
     std::vector<posting_list_t*> expanded_plists;
 
-    get_field_token_its(num_search_fields, query_suggestion, token_its, expanded_plists, query_tokens, the_fields);
+    std::vector<size_t> token_doc_freqs;
+    get_field_token_its(num_search_fields, query_suggestion, token_its, expanded_plists, query_tokens, the_fields,
+                        &token_doc_freqs);
+
+    bm25_stats_t bm25_stats;
+    if(match_type == bm25) {
+        init_bm25_stats(the_fields, num_search_fields, token_doc_freqs, bm25_stats);
+    }
 
     std::vector<uint32_t> result_ids;
     std::vector<uint32_t> eval_filter_indexes;
@@ -5009,7 +5850,8 @@ Option<bool> Index::search_across_fields(const std::vector<token_t>& query_token
                                                               search_schema,
                                                               searched_queries,
                                                               sort_order,
-                                                              best_field_match_score);
+                                                              best_field_match_score,
+                                                              &bm25_stats);
 
          uint64_t distinct_id = seq_id;
          if(group_limit != 0) {
@@ -5105,7 +5947,8 @@ Option<bool> Index::search_across_fields(const std::vector<token_t>& query_token
 void Index::get_field_token_its(const size_t num_search_fields, std::vector<art_leaf*>& query_suggestion,
                                 std::vector<or_iterator_t>& token_its, std::vector<posting_list_t*>& expanded_plists,
                                 const std::vector<token_t>& query_tokens,
-                                const std::vector<search_field_t>& the_fields) const {
+                                const std::vector<search_field_t>& the_fields,
+                                std::vector<size_t>* token_doc_freqs) const {
     // for each token, find the posting lists across all query_by fields
     for(size_t ti = 0; ti < query_tokens.size(); ti++) {
         const uint32_t token_num_typos = query_tokens[ti].num_typos;
@@ -5115,6 +5958,7 @@ void Index::get_field_token_its(const size_t num_search_fields, std::vector<art_
         auto token_c_str = (const unsigned char*) token_str.c_str();
         const size_t token_len = token_str.size() + 1;
         std::vector<posting_list_t::iterator_t> its;
+        size_t token_doc_freq = 0;
 
         for(size_t i = 0; i < num_search_fields; i++) {
             const std::string& field_name = the_fields[i].name;
@@ -5140,6 +5984,7 @@ void Index::get_field_token_its(const size_t num_search_fields, std::vector<art_
             }
 
             query_suggestion.push_back(leaf);
+            token_doc_freq = std::max<size_t>(token_doc_freq, posting_t::num_ids(leaf->values));
 
             /*LOG(INFO) << "Token: " << token_str << ", field_name: " << field_name
                       << ", num_ids: " << posting_t::num_ids(leaf->values);*/
@@ -5163,6 +6008,32 @@ void Index::get_field_token_its(const size_t num_search_fields, std::vector<art_
 
         or_iterator_t token_fields(its);
         token_its.push_back(std::move(token_fields));
+
+        if(token_doc_freqs != nullptr) {
+            token_doc_freqs->push_back(token_doc_freq);
+        }
+    }
+}
+
+void Index::init_bm25_stats(const std::vector<search_field_t>& the_fields, const size_t num_search_fields,
+                            const std::vector<size_t>& token_doc_freqs, bm25_stats_t& bm25_stats) const {
+    const size_t num_docs = seq_ids->num_ids();
+
+    for(const size_t doc_freq: token_doc_freqs) {
+        bm25_stats.token_idfs.push_back(bm25_t::idf(num_docs, doc_freq));
+    }
+
+    for(size_t i = 0; i < num_search_fields; i++) {
+        auto field_length_it = field_length_index.find(the_fields[i].name);
+        const field_length_stats_t* field_lengths = field_length_it == field_length_index.end() ? nullptr :
+                                                    field_length_it->second;
+        bm25_stats.field_lengths.push_back(field_lengths);
+
+        // without length statistics, term frequencies are not normalized (see `bm25_t::normalized_tf`)
+        bm25_stats.avg_field_lengths.push_back(field_lengths ? field_lengths->avg_length() : 0);
+
+        auto field_it = search_schema.find(the_fields[i].name);
+        bm25_stats.field_is_arrays.push_back(field_it != search_schema.end() && field_it.value().is_array());
     }
 }
 
@@ -5307,17 +6178,27 @@ Option<bool> Index::compute_sort_scores(const std::vector<sort_by>& sort_fields,
         } else if(field_values[i] == &vector_query_sentinel_value) {
             scores[i] = float_to_int64_t(2.0f);
             try {
-                const auto& values = sort_fields[i].vector_query.vector_index->vecdex->getDataByLabel<float>(seq_id);
-                const auto& dist_func = sort_fields[i].vector_query.vector_index->space->get_dist_func();
-                float dist = dist_func(sort_fields[i].vector_query.query.values.data(), values.data(), &sort_fields[i].vector_query.vector_index->num_dim);
+                float dist;
+                bool found = true;
 
-                if(dist > sort_fields[i].vector_query.query.distance_threshold) {
-                    //if computed distance is more then distance_thershold then we set it to max float,
-                    //so that other sort conditions can execute
-                    dist = std::numeric_limits<float>::max();
+                if(sort_fields[i].vector_query.vector_index->multi_vector) {
+                    found = compute_multi_vector_distance(sort_fields[i].vector_query.vector_index,
+                                                          sort_fields[i].vector_query.query.values, seq_id, dist);
+                } else {
+                    const auto& values = sort_fields[i].vector_query.vector_index->vecdex->getDataByLabel<float>(seq_id);
+                    const auto& dist_func = sort_fields[i].vector_query.vector_index->space->get_dist_func();
+                    dist = dist_func(sort_fields[i].vector_query.query.values.data(), values.data(), &sort_fields[i].vector_query.vector_index->num_dim);
                 }
 
-                scores[i] = float_to_int64_t(dist);
+                if(found) {
+                    if(dist > sort_fields[i].vector_query.query.distance_threshold) {
+                        //if computed distance is more then distance_thershold then we set it to max float,
+                        //so that other sort conditions can execute
+                        dist = std::numeric_limits<float>::max();
+                    }
+
+                    scores[i] = float_to_int64_t(dist);
+                }
             } catch(...) {
                 // probably not found
                 // do nothing
@@ -5657,8 +6538,8 @@ Option<bool> Index::do_infix_search(const size_t num_search_fields, const std::v
                 for(size_t i = 0; i < raw_infix_ids_length; i++) {
                     auto seq_id = raw_infix_ids[i];
                     std::map<std::string, reference_filter_result_t> references;
-                    if (filtered_infix_ids.coll_to_references != nullptr) {
-                        references = std::move(filtered_infix_ids.coll_to_references[i]);
+                    if (filtered_infix_ids.has_references()) {
+                        filtered_infix_ids.move_references(i, references);
                     }
 
                     int64_t match_score = 0;
@@ -5772,6 +6653,104 @@ void Index::handle_exclusion(const size_t num_search_fields, std::vector<query_t
     }
 }
 
+static filter_node_t* copy_filter_node(const filter_node_t* filter_node) {
+    if(filter_node == nullptr) {
+        return nullptr;
+    }
+
+    if(!filter_node->isOperator) {
+        return new filter_node_t(filter_node->filter_exp);
+    }
+
+    return new filter_node_t(filter_node->filter_operator, copy_filter_node(filter_node->left),
+                             copy_filter_node(filter_node->right));
+}
+
+static bool filter_refers_only_to_field(const filter_node_t* filter_node, const std::string& field_name) {
+    if(filter_node == nullptr) {
+        return true;
+    }
+
+    if(filter_node->isOperator) {
+        return filter_refers_only_to_field(filter_node->left, field_name) &&
+               filter_refers_only_to_field(filter_node->right, field_name);
+    }
+
+    return filter_node->filter_exp.field_name == field_name &&
+           filter_node->filter_exp.referenced_collection_name.empty();
+}
+
+filter_node_t* Index::copy_filter_without_field(const filter_node_t* filter_node, const std::string& field_name,
+                                                bool& removed) {
+    if(filter_node == nullptr) {
+        return nullptr;
+    }
+
+    if(filter_refers_only_to_field(filter_node, field_name)) {
+        removed = true;
+        return nullptr;
+    }
+
+    if(filter_node->isOperator && filter_node->filter_operator == AND) {
+        auto left = copy_filter_without_field(filter_node->left, field_name, removed);
+        auto right = copy_filter_without_field(filter_node->right, field_name, removed);
+
+        if(left == nullptr) {
+            return right;
+        }
+
+        if(right == nullptr) {
+            return left;
+        }
+
+        return new filter_node_t(AND, left, right);
+    }
+
+    // a clause on the field that is OR-ed with clauses on other fields can't be removed
+    return copy_filter_node(filter_node);
+}
+
+Option<bool> Index::get_disjunctive_facet_ids(const filter_node_t* filter_tree_root, const std::string& field_name,
+                                              const uint32_t* excluded_result_ids, size_t excluded_result_ids_size,
+                                              std::vector<uint32_t>& result_ids) const {
+    bool removed = false;
+    std::unique_ptr<filter_node_t> relaxed_filter(copy_filter_without_field(filter_tree_root, field_name, removed));
+
+    if(!removed) {
+        return Option<bool>(false);
+    }
+
+    uint32_t* filter_ids = nullptr;
+    uint32_t filter_ids_length = 0;
+
+    if(relaxed_filter == nullptr) {
+        filter_ids = seq_ids->uncompress();
+        filter_ids_length = seq_ids->num_ids();
+    } else {
+        filter_result_iterator_t filter_result_iterator(get_collection_name(), this, relaxed_filter.get(), false,
+                                                        DEFAULT_FILTER_BY_CANDIDATES,
+                                                        search_begin_us, search_stop_us);
+        auto filter_init_op = filter_result_iterator.init_status();
+        if(!filter_init_op.ok()) {
+            return filter_init_op;
+        }
+
+        filter_result_iterator.compute_iterators();
+        search_cutoff = search_cutoff || filter_result_iterator.validity == filter_result_iterator_t::timed_out;
+        filter_ids_length = filter_result_iterator.to_filter_id_array(filter_ids);
+    }
+
+    std::unique_ptr<uint32_t[]> filter_ids_guard(filter_ids);
+
+    uint32_t* ids = nullptr;
+    size_t ids_length = ArrayUtils::exclude_scalar(filter_ids, filter_ids_length,
+                                                   excluded_result_ids, excluded_result_ids_size, &ids);
+    std::unique_ptr<uint32_t[]> ids_guard(ids);
+
+    result_ids.assign(ids, ids + ids_length);
+    return Option<bool>(true);
+}
+
 void Index::compute_facet_infos(const std::vector<facet>& facets, facet_query_t& facet_query,
                                 const uint32_t facet_query_num_typos,
                                 uint32_t* all_result_ids, const size_t& all_result_ids_len,
@@ -5805,6 +6784,12 @@ void Index::compute_facet_infos(const std::vector<facet>& facets, facet_query_t&
         if(facet_index_type == exhaustive) {
             facet_infos[findex].use_value_index = false;
         }
+        else if(facet_index_type == sketch) {
+            facet_infos[findex].use_value_index = false;
+            facet_infos[findex].use_sketch = facet_value_index_exists && (group_limit == 0) &&
+                                             !a_facet.is_range_query && a_facet.sort_field.empty() &&
+                                             !a_facet.is_sort_by_alpha;
+        }
         else if(facet_value_index_exists) {
             if(facet_index_type == top_values) {
                 facet_infos[findex].use_value_index = true;
@@ -5821,8 +6806,15 @@ void Index::compute_facet_infos(const std::vector<facet>& facets, facet_query_t&
             facet_infos[findex].use_value_index = false;
         }
 
+        if(!facet_infos[findex].use_value_index && !facet_infos[findex].use_sketch) {
+            facet_infos[findex].use_dense_counts = use_dense_facet_counts(a_facet, facet_field, group_limit,
+                                                                          all_result_ids_len);
+        }
+
         if(a_facet.field_name == facet_query.field_name && !facet_query.query.empty()) {
             facet_infos[findex].use_facet_query = true;
+            // sketches sample the documents of a value, so they can't be restricted to the matching values
+            facet_infos[findex].use_sketch = false;
 
             if (facet_field.is_bool()) {
                 if (facet_query.query == "true") {
@@ -6080,8 +7072,8 @@ Option<bool> Index::search_wildcard(filter_node_t const* const& filter_tree_root
             for(size_t i = 0; i < batch_result->count; i++) {
                 const uint32_t seq_id = batch_result->docs[i];
                 std::map<basic_string<char>, reference_filter_result_t> references;
-                if (batch_result->coll_to_references != nullptr) {
-                    references = std::move(batch_result->coll_to_references[i]);
+                if (batch_result->has_references()) {
+                    batch_result->move_references(i, references);
                 }
 
                 int64_t match_score = 0;
@@ -6138,13 +7130,16 @@ Option<bool> Index::search_wildcard(filter_node_t const* const& filter_tree_root
     search_cutoff = parent_search_cutoff || timed_out_before_processing ||
                         filter_result_iterator->validity == filter_result_iterator_t::timed_out;
 
+    // merging the groups of many threads one thread at a time dominates grouped searches over large result sets
+    const bool aggregate_groups_concurrently = (group_limit != 0 && num_processed > 1);
+
     for(size_t thread_id = 0; thread_id < num_processed; thread_id++) {
         if (compute_sort_score_statuses[thread_id] != nullptr) {
             auto& status = compute_sort_score_statuses[thread_id];
             auto return_value = Option<bool>(status->code(), status->error());
 
             // Cleanup the remaining threads.
-            for (size_t i = thread_id; i < num_processed; i++) {
+            for (size_t i = aggregate_groups_concurrently ? 0 : thread_id; i < num_processed; i++) {
                 delete compute_sort_score_statuses[i];
                 delete topsters[i];
             }
@@ -6152,6 +7147,10 @@ Option<bool> Index::search_wildcard(filter_node_t const* const& filter_tree_root
             return return_value;
         }
 
+        if(aggregate_groups_concurrently) {
+            continue;
+        }
+
         //groups_processed.insert(tgroups_processed[thread_id].begin(), tgroups_processed[thread_id].end());
         for(const auto& it : tgroups_processed[thread_id]) {
             groups_processed[it.first]+= it.second;
@@ -6160,6 +7159,14 @@ Option<bool> Index::search_wildcard(filter_node_t const* const& filter_tree_root
         delete topsters[thread_id];
     }
 
+    if(aggregate_groups_concurrently) {
+        aggregate_group_topsters(topster, topsters, num_processed, tgroups_processed, groups_processed);
+
+        for(size_t thread_id = 0; thread_id < num_processed; thread_id++) {
+            delete topsters[thread_id];
+        }
+    }
+
     /*long long int timeMillisF = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::high_resolution_clock::now() - beginF).count();
     LOG(INFO) << "Time for raw scoring: " << timeMillisF;*/
@@ -6605,6 +7612,11 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
         std::vector<std::string> tokens;
         tokenize_string_field(document, search_field, tokens, search_field.locale, symbols_to_index, token_separators);
 
+        auto field_length_it = field_length_index.find(field_name);
+        if(field_length_it != field_length_index.end()) {
+            field_length_it->second->remove(seq_id);
+        }
+
         for(size_t i = 0; i < tokens.size(); i++) {
             const auto& token = tokens[i];
             const unsigned char *key = (const unsigned char *) token.c_str();
@@ -6688,7 +7700,11 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
     } else if(search_field.num_dim) {
         if(!is_update) {
             // since vector index supports upsert natively, we should not attempt to delete for update
-            vector_index[search_field.name]->vecdex->markDelete(seq_id);
+            if(search_field.multi_vector) {
+                remove_doc_vectors(vector_index[search_field.name], seq_id);
+            } else {
+                vector_index[search_field.name]->vecdex->markDelete(seq_id);
+            }
         }
     } else if(search_field.is_float()) {
         const std::vector<float>& values = search_field.is_single_float() ?
@@ -6776,6 +7792,12 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
 Option<uint32_t> Index::remove(const uint32_t seq_id, nlohmann::json & document,
                                const std::vector<field>& del_fields, const bool is_update) {
     std::unique_lock lock(mutex);
+    return do_remove(seq_id, document, del_fields, is_update);
+}
+
+Option<uint32_t> Index::do_remove(const uint32_t seq_id, nlohmann::json & document,
+                                  const std::vector<field>& del_fields, const bool is_update) {
+    facet_index_v4->invalidate_filtered_facet_counts();
 
     // The exception during removal is mostly because of an edge case with auto schema detection:
     // Value indexed as Type T but later if field is dropped and reindexed in another type X,
@@ -6847,6 +7869,15 @@ const spp::sparse_hash_map<std::string, art_tree *> &Index::_get_search_index()
     return search_index;
 }
 
+const field_length_stats_t* Index::_get_field_length_stats(const std::string& field_name) const {
+    auto field_length_it = field_length_index.find(field_name);
+    if(field_length_it == field_length_index.end()) {
+        return nullptr;
+    }
+
+    return field_length_it->second;
+}
+
 const spp::sparse_hash_map<std::string, num_tree_t*>& Index::_get_numerical_index() const {
     return numerical_index;
 }
@@ -6878,7 +7909,8 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
         search_schema.emplace(new_field.name, new_field);
 
         if(new_field.type == field_types::FLOAT_ARRAY && new_field.num_dim > 0) {
-            auto hnsw_index = new hnsw_index_t(new_field.num_dim, 16, new_field.vec_dist, new_field.hnsw_params["M"].get<uint32_t>(), new_field.hnsw_params["ef_construction"].get<uint32_t>());
+            auto hnsw_index = new hnsw_index_t(new_field.num_dim, 16, new_field.vec_dist, new_field.hnsw_params["M"].get<uint32_t>(),
+                                               new_field.hnsw_params["ef_construction"].get<uint32_t>(), new_field.multi_vector);
             vector_index.emplace(new_field.name, hnsw_index);
             continue;
         }
@@ -6897,6 +7929,10 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
                 art_tree *t = new art_tree;
                 art_tree_init(t);
                 search_index.emplace(new_field.name, t);
+
+                if(new_field.bm25) {
+                    field_length_index.emplace(new_field.name, new field_length_stats_t());
+                }
             } else if(new_field.is_geopoint()) {
                 geo_range_index.emplace(new_field.name, new NumericTrie(32));
                 if(!new_field.is_single_geopoint()) {
@@ -6953,6 +7989,12 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
             art_tree_destroy(search_index[del_field.name]);
             delete search_index[del_field.name];
             search_index.erase(del_field.name);
+
+            auto length_stats_it = field_length_index.find(del_field.name);
+            if(length_stats_it != field_length_index.end()) {
+                delete length_stats_it->second;
+                field_length_index.erase(length_stats_it);
+            }
         } else if(del_field.is_geopoint()) {
             delete geo_range_index[del_field.name];
             geo_range_index.erase(del_field.name);
@@ -7822,7 +8864,14 @@ void Index::compute_aux_scores(Topster<KV>* topster, const std::vector<search_fi
         std::vector<posting_list_t*> expanded_plists;
 
         std::vector<art_leaf*> query_suggestion;
-        get_field_token_its(the_fields.size(), query_suggestion, token_its, expanded_plists, query_tokens, the_fields);
+        std::vector<size_t> token_doc_freqs;
+        get_field_token_its(the_fields.size(), query_suggestion, token_its, expanded_plists, query_tokens, the_fields,
+                            &token_doc_freqs);
+
+        bm25_stats_t bm25_stats;
+        if(match_type == bm25) {
+            init_bm25_stats(the_fields, the_fields.size(), token_doc_freqs, bm25_stats);
+        }
 
         int64_t best_field_match_score = 0;
         std::vector<std::vector<art_leaf*>> searched_queries;
@@ -7849,7 +8898,8 @@ void Index::compute_aux_scores(Topster<KV>* topster, const std::vector<search_fi
                                                                  search_schema,
                                                                  searched_queries,
                                                                  sort_order,
-                                                                 best_field_match_score);
+                                                                 best_field_match_score,
+                                                                 &bm25_stats);
 
             kv->text_match_score = aggregated_score;
         }
@@ -7860,36 +8910,71 @@ void Index::compute_aux_scores(Topster<KV>* topster, const std::vector<search_fi
     };
 
     std::vector<KV *> text_match_ids;
+    std::vector<KV *> vector_distance_ids;
     for (auto &kv: topster->map) {
         if (kv.second->text_match_score == 0) {
             //only found via vector distance, should compute text_match_score later
             text_match_ids.push_back(kv.second);
         } else if (kv.second->vector_distance == -1.0f) {
             //only found via text_match, should compute vector distance
+            vector_distance_ids.push_back(kv.second);
+        }
+    }
+
+    if (!vector_distance_ids.empty() && vector_index.at(vector_query.field_name)->multi_vector) {
+        auto &field_vector_index = vector_index.at(vector_query.field_name);
+        const auto& query_vectors = get_multi_vector_query(vector_query, field_vector_index);
+
+        for (KV* kv: vector_distance_ids) {
+            float dist;
+            if (compute_multi_vector_distance(field_vector_index, query_vectors, kv->key, dist)) {
+                kv->vector_distance = dist;
+            }
+        }
+    } else if (!vector_distance_ids.empty()) {
+        auto &field_vector_index = vector_index.at(vector_query.field_name);
+        const size_t num_dim = field_vector_index->num_dim;
+        const float* query = vector_query.values.data();
+
+        std::vector<float> normalized_q;
+        if (field_vector_index->distance_type == cosine) {
+            normalized_q.resize(vector_query.values.size());
+            hnsw_index_t::normalize_vector(vector_query.values, normalized_q);
+            query = normalized_q.data();
+        }
+
+        std::vector<float> block(num_dim * VectorDistance::BLOCK_SIZE);
+        std::vector<KV*> block_kvs;
+        float distances[VectorDistance::BLOCK_SIZE];
+
+        auto process_block = [&]() {
+            VectorDistance::inner_product_distances(query, block.data(), num_dim, distances);
+            for (size_t lane = 0; lane < block_kvs.size(); lane++) {
+                block_kvs[lane]->vector_distance = distances[lane];
+            }
+            block_kvs.clear();
+        };
+
+        for (KV* kv: vector_distance_ids) {
             std::vector<float> values;
-            auto &field_vector_index = vector_index.at(vector_query.field_name);
 
             try {
-                values = field_vector_index->vecdex->getDataByLabel<float>(kv.second->key);
+                values = field_vector_index->vecdex->getDataByLabel<float>(kv->key);
             } catch (...) {
                 // likely not found
                 continue;
             }
 
-            float dist;
-            if (field_vector_index->distance_type == cosine) {
-                std::vector<float> normalized_q(vector_query.values.size());
-                hnsw_index_t::normalize_vector(vector_query.values, normalized_q);
-                dist = field_vector_index->space->get_dist_func()(normalized_q.data(),
-                                                                  values.data(),
-                                                                  &field_vector_index->num_dim);
-            } else {
-                dist = field_vector_index->space->get_dist_func()(vector_query.values.data(),
-                                                                  values.data(),
-                                                                  &field_vector_index->num_dim);
+            VectorDistance::set_block_vector(block.data(), num_dim, block_kvs.size(), values.data());
+            block_kvs.push_back(kv);
+
+            if (block_kvs.size() == VectorDistance::BLOCK_SIZE) {
+                process_block();
             }
+        }
 
-            kv.second->vector_distance = dist;
+        if (!block_kvs.empty()) {
+            process_block();
         }
     }
 
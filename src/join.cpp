@@ -384,12 +384,92 @@ Option<bool> Join::add_reference_helper_fields(nlohmann::json& document,
     return Option<bool>(true);
 }
 
+std::string Join::get_ref_doc_spec(const ref_include_exclude_fields& ref_include_exclude) {
+    return ref_include_exclude.include_fields + REF_DOC_KEY_SEPARATOR + ref_include_exclude.exclude_fields;
+}
+
+Option<bool> Join::get_pruned_ref_docs(Collection* const ref_collection,
+                                       const reference_filter_result_t& references,
+                                       const tsl::htrie_set<char>& ref_include_fields_full,
+                                       const tsl::htrie_set<char>& ref_exclude_fields_full,
+                                       const ref_include_exclude_fields& ref_include_exclude,
+                                       request_ref_docs_t* const request_ref_docs,
+                                       std::vector<nlohmann::json>& ref_docs) {
+    auto const& spec = get_ref_doc_spec(ref_include_exclude);
+    auto const& request_key_prefix = ref_collection->get_name() + REF_DOC_KEY_SEPARATOR + spec + REF_DOC_KEY_SEPARATOR;
+    auto& ref_doc_cache = ref_collection->get_reference_doc_cache();
+    // Has to be read before fetching the documents, so that the documents updated in the meantime are not cached.
+    auto const cache_generation = ref_doc_cache.get_generation();
+
+    ref_docs.clear();
+    ref_docs.resize(references.count);
+
+    std::vector<uint32_t> fetch_seq_ids, fetch_indices;
+    for (uint32_t i = 0; i < references.count; i++) {
+        auto const& ref_doc_seq_id = references.docs[i];
+        // Referenced document is not yet indexed.
+        if (ref_doc_seq_id == Index::reference_helper_sentinel_value) {
+            continue;
+        }
+
+        if (request_ref_docs != nullptr) {
+            auto it = request_ref_docs->find(request_key_prefix + std::to_string(ref_doc_seq_id));
+            if (it != request_ref_docs->end()) {
+                ref_docs[i] = it->second;
+                continue;
+            }
+        }
+
+        if (ref_doc_cache.get(ref_doc_seq_id, spec, ref_docs[i])) {
+            if (request_ref_docs != nullptr) {
+                request_ref_docs->emplace(request_key_prefix + std::to_string(ref_doc_seq_id), ref_docs[i]);
+            }
+            continue;
+        }
+
+        fetch_seq_ids.push_back(ref_doc_seq_id);
+        fetch_indices.push_back(i);
+    }
+
+    if (fetch_seq_ids.empty()) {
+        return Option<bool>(true);
+    }
+
+    std::vector<nlohmann::json> fetched_docs;
+    auto get_docs_op = ref_collection->get_documents_from_store(fetch_seq_ids, fetched_docs);
+    if (!get_docs_op.ok()) {
+        return get_docs_op;
+    }
+
+    for (size_t i = 0; i < fetched_docs.size(); i++) {
+        auto& ref_doc = fetched_docs[i];
+
+        Collection::remove_flat_fields(ref_doc);
+        Collection::remove_reference_helper_fields(ref_doc);
+
+        auto prune_op = Collection::prune_doc(ref_doc, ref_include_fields_full, ref_exclude_fields_full);
+        if (!prune_op.ok()) {
+            return prune_op;
+        }
+
+        ref_doc_cache.put(fetch_seq_ids[i], spec, ref_doc, cache_generation);
+        if (request_ref_docs != nullptr) {
+            request_ref_docs->emplace(request_key_prefix + std::to_string(fetch_seq_ids[i]), ref_doc);
+        }
+
+        ref_docs[fetch_indices[i]] = std::move(ref_doc);
+    }
+
+    return Option<bool>(true);
+}
+
 Option<bool> Join::prune_ref_doc(nlohmann::json& doc,
                                  const reference_filter_result_t& references,
                                  const tsl::htrie_set<char>& ref_include_fields_full,
                                  const tsl::htrie_set<char>& ref_exclude_fields_full,
                                  const bool& is_reference_array,
-                                 const ref_include_exclude_fields& ref_include_exclude) {
+                                 const ref_include_exclude_fields& ref_include_exclude,
+                                 request_ref_docs_t* const request_ref_docs) {
     nlohmann::json original_doc;
     if (!ref_include_exclude.nested_join_includes.empty()) {
         original_doc = doc;
@@ -406,25 +486,21 @@ Option<bool> Join::prune_ref_doc(nlohmann::json& doc,
     auto const& strategy = ref_include_exclude.strategy;
     auto error_prefix = "Referenced collection `" + ref_collection_name + "`: ";
 
+    std::vector<nlohmann::json> ref_docs;
+    auto get_ref_docs_op = get_pruned_ref_docs(ref_collection.get(), references, ref_include_fields_full,
+                                               ref_exclude_fields_full, ref_include_exclude, request_ref_docs, ref_docs);
+    if (!get_ref_docs_op.ok()) {
+        return Option<bool>(get_ref_docs_op.code(), error_prefix + get_ref_docs_op.error());
+    }
+
     // One-to-one relation.
     if (strategy != ref_include::nest_array && !is_reference_array && references.count == 1) {
         auto ref_doc_seq_id = references.docs[0];
 
-        nlohmann::json ref_doc;
-        auto get_doc_op = ref_collection->get_document_from_store(ref_doc_seq_id, ref_doc);
-        if (!get_doc_op.ok()) {
-            if (ref_doc_seq_id == Index::reference_helper_sentinel_value) {
-                return Option<bool>(true);
-            }
-            return Option<bool>(get_doc_op.code(), error_prefix + get_doc_op.error());
-        }
-
-        Collection::remove_flat_fields(ref_doc);
-        Collection::remove_reference_helper_fields(ref_doc);
-
-        auto prune_op = Collection::prune_doc(ref_doc, ref_include_fields_full, ref_exclude_fields_full);
-        if (!prune_op.ok()) {
-            return Option<bool>(prune_op.code(), error_prefix + prune_op.error());
+        auto& ref_doc = ref_docs[0];
+        // Referenced document is not yet indexed.
+        if (ref_doc.is_null()) {
+            return Option<bool>(true);
         }
 
         auto const key = alias.empty() ? ref_collection_name : alias;
@@ -453,7 +529,8 @@ Option<bool> Join::prune_ref_doc(nlohmann::json& doc,
                                                                 ref_collection.get(),
                                                                 references.coll_to_references == nullptr ? refs :
                                                                 references.coll_to_references[0],
-                                                                ref_include_exclude.nested_join_includes, original_doc);
+                                                                ref_include_exclude.nested_join_includes, original_doc,
+                                                                request_ref_docs);
             if (!nested_include_exclude_op.ok()) {
                 return nested_include_exclude_op;
             }
@@ -466,25 +543,13 @@ Option<bool> Join::prune_ref_doc(nlohmann::json& doc,
     for (uint32_t i = 0; i < references.count; i++) {
         auto ref_doc_seq_id = references.docs[i];
 
-        nlohmann::json ref_doc;
+        auto& ref_doc = ref_docs[i];
         std::string key;
         auto const& nest_ref_doc = (strategy == ref_include::nest || strategy == ref_include::nest_array);
 
-        auto get_doc_op = ref_collection->get_document_from_store(ref_doc_seq_id, ref_doc);
-        if (!get_doc_op.ok()) {
-            // Referenced document is not yet indexed.
-            if (ref_doc_seq_id == Index::reference_helper_sentinel_value) {
-                continue;
-            }
-            return Option<bool>(get_doc_op.code(), error_prefix + get_doc_op.error());
-        }
-
-        Collection::remove_flat_fields(ref_doc);
-        Collection::remove_reference_helper_fields(ref_doc);
-
-        auto prune_op = Collection::prune_doc(ref_doc, ref_include_fields_full, ref_exclude_fields_full);
-        if (!prune_op.ok()) {
-            return Option<bool>(prune_op.code(), error_prefix + prune_op.error());
+        // Referenced document is not yet indexed.
+        if (ref_doc.is_null()) {
+            continue;
         }
 
         if (!ref_doc.empty()) {
@@ -523,7 +588,8 @@ Option<bool> Join::prune_ref_doc(nlohmann::json& doc,
                                                                 ref_collection.get(),
                                                                 references.coll_to_references == nullptr ? refs :
                                                                 references.coll_to_references[i],
-                                                                ref_include_exclude.nested_join_includes, original_doc);
+                                                                ref_include_exclude.nested_join_includes, original_doc,
+                                                                request_ref_docs);
             if (!nested_include_exclude_op.ok()) {
                 return nested_include_exclude_op;
             }
@@ -536,7 +602,7 @@ Option<bool> Join::prune_ref_doc(nlohmann::json& doc,
 Option<bool> Join::include_references(nlohmann::json& doc, const uint32_t& seq_id, Collection *const collection,
                                       const std::map<std::string, reference_filter_result_t>& reference_filter_results,
                                       const std::vector<ref_include_exclude_fields>& ref_include_exclude_fields_vec,
-                                      const nlohmann::json& original_doc) {
+                                      const nlohmann::json& original_doc, request_ref_docs_t* const request_ref_docs) {
     for (auto const& ref_include_exclude: ref_include_exclude_fields_vec) {
         auto ref_collection_name = ref_include_exclude.collection_name;
 
@@ -598,7 +664,8 @@ Option<bool> Join::include_references(nlohmann::json& doc, const uint32_t& seq_i
         if (has_filter_reference) {
             auto const& ref_filter_result = reference_filter_results.at(ref_collection_name);
             prune_doc_op = prune_ref_doc(doc, ref_filter_result, ref_include_fields_full, ref_exclude_fields_full,
-                                         ref_filter_result.is_reference_array_field, ref_include_exclude);
+                                         ref_filter_result.is_reference_array_field, ref_include_exclude,
+                                         request_ref_docs);
         } else if (doc_has_reference) {
             auto get_reference_field_op = ref_collection->get_referenced_in_field_with_lock(collection->get_name());
             if (!get_reference_field_op.ok()) {
@@ -651,7 +718,7 @@ Option<bool> Join::include_references(nlohmann::json& doc, const uint32_t& seq_i
                         reference_filter_result_t result(1, new uint32_t[1]{ref_doc_id});
                         prune_doc_op = prune_ref_doc(doc[key][i], result,
                                                      ref_include_fields_full, ref_exclude_fields_full,
-                                                     false, ref_include_exclude);
+                                                     false, ref_include_exclude, request_ref_docs);
                         if (!prune_doc_op.ok()) {
                             return prune_doc_op;
                         }
@@ -665,7 +732,8 @@ Option<bool> Join::include_references(nlohmann::json& doc, const uint32_t& seq_i
                     }
                     reference_filter_result_t result(ids.size(), &ids[0]);
                     prune_doc_op = prune_ref_doc(doc[key], result, ref_include_fields_full, ref_exclude_fields_full,
-                                                 collection->get_schema().at(field_name).is_array(), ref_include_exclude);
+                                                 collection->get_schema().at(field_name).is_array(), ref_include_exclude,
+                                                 request_ref_docs);
                     result.docs = nullptr;
                 }
             } else {
@@ -677,7 +745,8 @@ Option<bool> Join::include_references(nlohmann::json& doc, const uint32_t& seq_i
                 }
                 reference_filter_result_t result(ids.size(), &ids[0]);
                 prune_doc_op = prune_ref_doc(doc, result, ref_include_fields_full, ref_exclude_fields_full,
-                                             collection->get_schema().at(field_name).is_array(), ref_include_exclude);
+                                             collection->get_schema().at(field_name).is_array(), ref_include_exclude,
+                                             request_ref_docs);
                 result.docs = nullptr;
             }
         } else if (joined_coll_has_reference) {
@@ -711,7 +780,7 @@ Option<bool> Join::include_references(nlohmann::json& doc, const uint32_t& seq_i
             result.docs = &ids[0];
             prune_doc_op = prune_ref_doc(doc, result, ref_include_fields_full, ref_exclude_fields_full,
                                          joined_collection->get_schema().at(reference_field_name).is_array(),
-                                         ref_include_exclude);
+                                         ref_include_exclude, request_ref_docs);
             result.docs = nullptr;
         }
 
@@ -11,6 +11,7 @@
 #include "collection.h"
 #include "string_utils.h"
 #include "collection_manager.h"
+#include "vector_distance.h"
 
 using namespace std;
 
@@ -169,6 +170,44 @@ void benchmark_reactjs_pages(char* file_path) {
     std::cout << "Results total: " << results_total << std::endl;
 }
 
+void benchmark_vector_distances() {
+    const size_t num_dim = 384;
+    const size_t num_blocks = 64 * 1024;
+    const size_t num_runs = 10;
+
+    std::vector<float> query(num_dim);
+    std::vector<float> block(num_dim * VectorDistance::BLOCK_SIZE);
+    for(auto& value: query) {
+        value = float(rand()) / RAND_MAX;
+    }
+    for(auto& value: block) {
+        value = float(rand()) / RAND_MAX;
+    }
+
+    const char* kernel_names[] = {"scalar", "sse", "avx2", "avx512"};
+    float distances[VectorDistance::BLOCK_SIZE];
+
+    for(int kernel = VectorDistance::scalar; kernel <= VectorDistance::get_supported_kernel(); kernel++) {
+        float total = 0; // to prevent no-op optimization!
+        auto begin = std::chrono::high_resolution_clock::now();
+
+        for(size_t run = 0; run < num_runs; run++) {
+            for(size_t i = 0; i < num_blocks; i++) {
+                VectorDistance::inner_product_distances(VectorDistance::kernel_t(kernel), query.data(), block.data(),
+                                                        num_dim, distances);
+                total += distances[i % VectorDistance::BLOCK_SIZE];
+            }
+        }
+
+        long long int timeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::high_resolution_clock::now() - begin).count();
+        double flops = 2.0 * num_dim * VectorDistance::BLOCK_SIZE * num_blocks * num_runs;
+
+        std::cout << "Kernel: " << kernel_names[kernel] << ", time taken: " << (timeMicros / 1000) << "ms, "
+                  << "GFLOP/s: " << (flops / timeMicros / 1000) << ", total: " << total << std::endl;
+    }
+}
+
 void generate_word_freq() {
     std::ifstream infile("/tmp/unigram_freq.jsonl");
     std::ofstream outfile("/tmp/eng_words.jsonl", std::ios_base::app);
@@ -195,6 +234,7 @@ int main(int argc, char* argv[]) {
 
 //    benchmark_hn_titles(argv[1]);
 //    benchmark_reactjs_pages(argv[1]);
+//    benchmark_vector_distances();
 
     generate_word_freq();
 
@@ -1932,6 +1932,61 @@ size_t posting_list_t::get_last_offset(const posting_list_t::iterator_t& it, boo
     return 0;
 }
 
+uint32_t posting_list_t::count_token_positions(const uint32_t* offsets, size_t num_offsets, bool field_is_array) {
+    uint32_t num_positions = 0;
+
+    if(!field_is_array) {
+        for(size_t i = 0; i < num_offsets; i++) {
+            // 0 is used to mark the token as being the last token of the field
+            if(offsets[i] != 0) {
+                num_positions++;
+            }
+        }
+
+        return num_positions;
+    }
+
+    size_t i = 0;
+    int64_t prev_pos = -1;
+
+    while(i < num_offsets) {
+        int64_t pos = offsets[i];
+        i++;
+
+        if(pos == prev_pos) {  // indicates end of array index
+            if(i+1 < num_offsets && offsets[i + 1] == 0) {
+                // indicates that token is the last token on the array element
+                i++;
+            }
+
+            i++;  // skip the array index
+            prev_pos = -1;
+            continue;
+        }
+
+        num_positions++;
+        prev_pos = pos;
+    }
+
+    return num_positions;
+}
+
+uint32_t posting_list_t::get_num_positions(const posting_list_t::iterator_t& it, bool field_is_array) {
+    block_t* curr_block = it.block();
+    uint32_t curr_index = it.index();
+
+    if(curr_block == nullptr || curr_index == UINT32_MAX) {
+        return 0;
+    }
+
+    uint32_t start_offset = it.offset_index[curr_index];
+    uint32_t end_offset = (curr_index == curr_block->size() - 1) ?
+                          curr_block->offsets.getLength() :
+                          it.offset_index[curr_index + 1];
+
+    return count_token_positions(it.offsets + start_offset, end_offset - start_offset, field_is_array);
+}
+
 /* iterator_t operations */
 
 posting_list_t::iterator_t::iterator_t(const std::map<last_id_t, block_t*>* id_block_map,
@@ -0,0 +1,204 @@
+#include "query_admission.h"
+#include "collection_manager.h"
+#include "string_utils.h"
+
+void QueryAdmission::init(uint64_t max_inflight_cost, uint32_t queue_timeout_ms) {
+    std::unique_lock lock(mutex);
+    this->max_inflight_cost = max_inflight_cost;
+    this->queue_timeout_ms = queue_timeout_ms;
+}
+
+uint64_t QueryAdmission::estimate_cost(uint64_t num_candidates, size_t num_facets, bool group_by, size_t per_page) {
+    // every candidate is scored, and counted once more for each facet and for grouping
+    uint64_t scan_passes = 1 + num_facets + (group_by ? 1 : 0);
+    return num_candidates * scan_passes + per_page * HIT_COST;
+}
+
+bool QueryAdmission::is_enabled() const {
+    std::unique_lock lock(mutex);
+    return max_inflight_cost != 0;
+}
+
+uint64_t QueryAdmission::estimate_search_cost(const std::map<std::string, std::string>& search_params,
+                                              const nlohmann::json& embedded_params) {
+    if(!get_instance().is_enabled()) {
+        return 0;
+    }
+
+    // scoped API keys can override params like `per_page` or narrow down `filter_by`
+    std::map<std::string, std::string> req_params = search_params;
+    nlohmann::json key_params = embedded_params;
+    if(!CollectionManager::apply_embedded_params(key_params, req_params).ok()) {
+        return 0;
+    }
+
+    auto get_param = [&](const std::string& name) -> std::string {
+        auto it = req_params.find(name);
+        return it == req_params.end() ? "" : it->second;
+    };
+
+    auto collection = CollectionManager::get_instance().get_collection(get_param("collection"));
+    if(collection == nullptr) {
+        return 0;
+    }
+
+    uint64_t num_candidates = collection->get_num_documents();
+
+    // a reference filter is resolved by a join, which we don't want to pay for twice
+    const std::string& filter_query = get_param(collection_search_args_t::FILTER);
+    if(!filter_query.empty() && filter_query.find('$') == std::string::npos) {
+        uint32_t approx_filter_ids_length = 0;
+        auto filter_op = collection->get_approx_filter_ids_length(filter_query, approx_filter_ids_length);
+        if(!filter_op.ok()) {
+            return 0;
+        }
+
+        num_candidates = std::min<uint64_t>(num_candidates, approx_filter_ids_length);
+    }
+
+    std::vector<std::string> facet_fields;
+    StringUtils::split_facet(get_param(collection_search_args_t::FACET_BY), facet_fields);
+
+    bool group_by = !get_param(collection_search_args_t::GROUP_BY).empty();
+
+    size_t per_page = 10;
+    for(const auto& per_page_param: {collection_search_args_t::PER_PAGE, collection_search_args_t::LIMIT}) {
+        const std::string& per_page_str = get_param(per_page_param);
+        if(StringUtils::is_uint32_t(per_page_str)) {
+            per_page = std::stoul(per_page_str);
+        }
+    }
+
+    return estimate_cost(num_candidates, facet_fields.size(), group_by, per_page);
+}
+
+void QueryAdmission::add_inflight(const std::string& api_key, uint64_t cost) {
+    inflight_cost += cost;
+    key_inflight_costs[api_key] += cost;
+}
+
+void QueryAdmission::admit_waiters() {
+    bool admitted_any = false;
+
+    while(!waiters.empty()) {
+        // max-min fairness: pick the earliest waiter of the API key with the least cost in flight
+        auto next_it = waiters.end();
+        uint64_t next_key_inflight_cost = 0;
+
+        for(auto it = waiters.begin(); it != waiters.end(); it++) {
+            auto key_cost_it = key_inflight_costs.find((*it)->api_key);
+            uint64_t key_inflight_cost = (key_cost_it == key_inflight_costs.end()) ? 0 : key_cost_it->second;
+            if(next_it == waiters.end() || key_inflight_cost < next_key_inflight_cost) {
+                next_it = it;
+                next_key_inflight_cost = key_inflight_cost;
+            }
+        }
+
+        waiter_t* waiter = *next_it;
+
+        // the waiter is not skipped when it does not fit, since cheaper searches of other keys would starve it
+        if(inflight_cost != 0 && inflight_cost + waiter->cost > max_inflight_cost) {
+            break;
+        }
+
+        waiter->admitted = true;
+        waiters.erase(next_it);
+
+        auto key_queued_it = key_queued_costs.find(waiter->api_key);
+        key_queued_it->second -= waiter->cost;
+        if(key_queued_it->second == 0) {
+            key_queued_costs.erase(key_queued_it);
+        }
+
+        add_inflight(waiter->api_key, waiter->cost);
+        admitted_any = true;
+    }
+
+    if(admitted_any) {
+        cv.notify_all();
+    }
+}
+
+Option<uint64_t> QueryAdmission::admit(const std::string& api_key, uint64_t cost) {
+    std::unique_lock lock(mutex);
+
+    if(max_inflight_cost == 0) {
+        return Option<uint64_t>(0);
+    }
+
+    // a search costlier than the whole budget still runs, but only when nothing else is in flight
+    cost = std::max<uint64_t>(1, std::min(cost, max_inflight_cost));
+
+    if(waiters.empty() && inflight_cost + cost <= max_inflight_cost) {
+        add_inflight(api_key, cost);
+        return Option<uint64_t>(cost);
+    }
+
+    // an API key can't queue more than the whole budget
+    auto key_queued_it = key_queued_costs.find(api_key);
+    uint64_t key_queued_cost = (key_queued_it == key_queued_costs.end()) ? 0 : key_queued_it->second;
+    if(key_queued_cost + cost > max_inflight_cost) {
+        num_rejected++;
+        return Option<uint64_t>(429, "Query cost budget exceeded.");
+    }
+
+    waiter_t waiter(api_key, cost);
+    waiters.push_back(&waiter);
+    key_queued_costs[api_key] += cost;
+
+    admit_waiters();
+
+    bool admitted = cv.wait_for(lock, std::chrono::milliseconds(queue_timeout_ms), [&]() {
+        return waiter.admitted;
+    });
+
+    if(!admitted) {
+        waiters.remove(&waiter);
+
+        key_queued_it = key_queued_costs.find(api_key);
+        key_queued_it->second -= cost;
+        if(key_queued_it->second == 0) {
+            key_queued_costs.erase(key_queued_it);
+        }
+
+        // this waiter might have been the one holding up the others
+        admit_waiters();
+
+        num_shed++;
+        return Option<uint64_t>(503, "Server is overloaded, too many expensive searches are in flight.");
+    }
+
+    return Option<uint64_t>(cost);
+}
+
+void QueryAdmission::release(const std::string& api_key, uint64_t admitted_cost) {
+    if(admitted_cost == 0) {
+        return;
+    }
+
+    std::unique_lock lock(mutex);
+
+    inflight_cost -= admitted_cost;
+
+    auto key_cost_it = key_inflight_costs.find(api_key);
+    if(key_cost_it != key_inflight_costs.end()) {
+        key_cost_it->second -= admitted_cost;
+        if(key_cost_it->second == 0) {
+            key_inflight_costs.erase(key_cost_it);
+        }
+    }
+
+    admit_waiters();
+}
+
+uint64_t QueryAdmission::get_inflight_cost() const {
+    std::unique_lock lock(mutex);
+    return inflight_cost;
+}
+
+void QueryAdmission::get_metrics(nlohmann::json& result) const {
+    std::unique_lock lock(mutex);
+    result["typesense_query_admission_inflight_cost"] = std::to_string(inflight_cost);
+    result["typesense_query_admission_shed_searches"] = std::to_string(num_shed);
+    result["typesense_query_admission_rejected_searches"] = std::to_string(num_rejected);
+}
@@ -0,0 +1,113 @@
+#include "query_embedding_cache.h"
+#include <cctype>
+
+void QueryEmbeddingCache::init(size_t capacity_bytes) {
+    std::unique_lock lock(mutex);
+    this->capacity_bytes = capacity_bytes;
+    evict();
+}
+
+bool QueryEmbeddingCache::is_enabled() const {
+    std::unique_lock lock(mutex);
+    return capacity_bytes != 0;
+}
+
+std::string QueryEmbeddingCache::get_key(const std::string& model_key, const std::string& query) {
+    std::string key = model_key;
+    key += KEY_SEPARATOR;
+
+    bool pending_space = false;
+    for(char c: query) {
+        if(std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = true;
+            continue;
+        }
+
+        if(pending_space && key.back() != KEY_SEPARATOR) {
+            key += ' ';
+        }
+
+        pending_space = false;
+        key += c;
+    }
+
+    return key;
+}
+
+bool QueryEmbeddingCache::get(const std::string& key, std::vector<float>& embedding) {
+    std::unique_lock lock(mutex);
+
+    if(capacity_bytes == 0) {
+        return false;
+    }
+
+    auto entry_it = entry_map.find(key);
+    if(entry_it == entry_map.end()) {
+        num_misses++;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, entry_it->second);
+    embedding = entry_it->second->embedding;
+    num_hits++;
+    return true;
+}
+
+void QueryEmbeddingCache::put(const std::string& key, const std::vector<float>& embedding) {
+    std::unique_lock lock(mutex);
+
+    if(capacity_bytes == 0 || entry_map.count(key) != 0) {
+        return;
+    }
+
+    entries.emplace_front(key, embedding);
+    entry_map.emplace(key, entries.begin());
+    size_bytes += entries.front().size_bytes();
+
+    evict();
+}
+
+void QueryEmbeddingCache::evict() {
+    while(size_bytes > capacity_bytes && !entries.empty()) {
+        const auto& entry = entries.back();
+        size_bytes -= entry.size_bytes();
+        entry_map.erase(entry.key);
+        entries.pop_back();
+    }
+}
+
+void QueryEmbeddingCache::remove_model(const std::string& model_key) {
+    std::unique_lock lock(mutex);
+
+    const std::string key_prefix = model_key + KEY_SEPARATOR;
+
+    for(auto it = entries.begin(); it != entries.end();) {
+        if(it->key.compare(0, key_prefix.size(), key_prefix) == 0) {
+            size_bytes -= it->size_bytes();
+            entry_map.erase(it->key);
+            it = entries.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void QueryEmbeddingCache::clear() {
+    std::unique_lock lock(mutex);
+    entries.clear();
+    entry_map.clear();
+    size_bytes = 0;
+}
+
+size_t QueryEmbeddingCache::get_size_bytes() const {
+    std::unique_lock lock(mutex);
+    return size_bytes;
+}
+
+void QueryEmbeddingCache::get_metrics(nlohmann::json& result) const {
+    std::unique_lock lock(mutex);
+    result["typesense_query_embedding_cache_entries"] = std::to_string(entries.size());
+    result["typesense_query_embedding_cache_bytes"] = std::to_string(size_bytes);
+    result["typesense_query_embedding_cache_hits"] = std::to_string(num_hits);
+    result["typesense_query_embedding_cache_misses"] = std::to_string(num_misses);
+}
@@ -29,6 +29,10 @@ void ReplicationClosure::Run() {
     std::unique_ptr<ReplicationClosure> self_guard(this);
 }
 
+void ReplicationBatchClosure::Run() {
+    std::unique_ptr<ReplicationBatchClosure> self_guard(this);
+}
+
 // State machine implementation
 
 int ReplicationState::start(const butil::EndPoint & peering_endpoint, const int api_port,
@@ -122,6 +126,8 @@ int ReplicationState::start(const butil::EndPoint & peering_endpoint, const int
             LOG(ERROR) << "Failed to initialize DB.";
             return init_db_status;
         }
+
+        state_loaded = true;
     }
 
     if (node->init(node_options) != 0) {
@@ -203,15 +209,20 @@ Option<bool> ReplicationState::handle_gzip(const std::shared_ptr<http_req>& requ
         request->zstream_initialized = true;
     }
 
+    // JSONL compresses well beyond 10x, so the output buffer is grown geometrically instead of being sized upfront
     std::string outbuffer;
-    outbuffer.resize(10 * request->body.size());
+    outbuffer.resize(std::max<size_t>(4 * request->body.size(), 64 * 1024));
 
     request->zs.next_in = (Bytef *) request->body.c_str();
     request->zs.avail_in = request->body.size();
     std::size_t size_uncompressed = 0;
     int ret = 0;
     do {
-        request->zs.avail_out = static_cast<unsigned int>(outbuffer.size());
+        if(size_uncompressed == outbuffer.size()) {
+            outbuffer.resize(2 * outbuffer.size());
+        }
+
+        request->zs.avail_out = static_cast<unsigned int>(outbuffer.size() - size_uncompressed);
         request->zs.next_out = reinterpret_cast<Bytef *>(&outbuffer[0] + size_uncompressed);
         ret = inflate(&request->zs, Z_FINISH);
         if (ret != Z_STREAM_END && ret != Z_OK && ret != Z_BUF_ERROR) {
@@ -220,7 +231,7 @@ Option<bool> ReplicationState::handle_gzip(const std::shared_ptr<http_req>& requ
             return Option<bool>(400, error_msg);
         }
 
-        size_uncompressed += (outbuffer.size() - request->zs.avail_out);
+        size_uncompressed = outbuffer.size() - request->zs.avail_out;
     } while (request->zs.avail_out == 0);
 
     if (ret == Z_STREAM_END) {
@@ -230,8 +241,8 @@ Option<bool> ReplicationState::handle_gzip(const std::shared_ptr<http_req>& requ
 
     outbuffer.resize(size_uncompressed);
 
-    request->body = outbuffer;
-    request->chunk_len = outbuffer.size();
+    request->body = std::move(outbuffer);
+    request->chunk_len = request->body.size();
 
     return Option<bool>(true);
 }
@@ -303,6 +314,30 @@ void ReplicationState::write(const std::shared_ptr<http_req>& request, const std
         }
     }
 
+    if(route_found && is_batchable_write(request, rpath)) {
+        // group commit: concurrent small writes are replicated together once the batch window elapses
+        std::unique_lock batch_lock(write_batch_mutex);
+        write_batch.emplace_back(request, response);
+        pending_writes++;
+
+        const bool first_write = (write_batch.size() == 1);
+        const bool batch_full = (write_batch.size() >= MAX_WRITE_BATCH_SIZE);
+        batch_lock.unlock();
+        lock.unlock();
+
+        if(batch_full) {
+            flush_write_batch();
+        } else if(first_write) {
+            const size_t window_us = config->get_write_batch_window_us();
+            thread_pool->enqueue([this, window_us]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(window_us));
+                flush_write_batch();
+            });
+        }
+
+        return ;
+    }
+
     // Serialize request to replicated WAL so that all the nodes in the group receive it as well.
     // NOTE: actual write must be done only on the `on_apply` method to maintain consistency.
 
@@ -331,6 +366,81 @@ void ReplicationState::write(const std::shared_ptr<http_req>& request, const std
     pending_writes++;
 }
 
+bool ReplicationState::is_batchable_write(const std::shared_ptr<http_req>& request, const route_path* rpath) const {
+    // only single document writes whose body has fully arrived are batched
+    return config->get_write_batch_window_us() != 0 && rpath->handler == post_add_document &&
+           request->first_chunk_aggregate && request->last_chunk_aggregate && !request->zstream_initialized &&
+           request->body.size() <= MAX_BATCHED_WRITE_BODY_SIZE;
+}
+
+void ReplicationState::flush_write_batch() {
+    req_res_batch_t req_res_batch;
+
+    {
+        std::unique_lock batch_lock(write_batch_mutex);
+        req_res_batch.swap(write_batch);
+    }
+
+    if(req_res_batch.empty()) {
+        return ;
+    }
+
+    std::shared_lock lock(node_mutex);
+
+    if(!node || !node->is_leader()) {
+        // leadership could have changed while the writes were being batched
+        for(auto& req_res: req_res_batch) {
+            pending_writes--;
+            write_to_leader(req_res.first, req_res.second);
+        }
+
+        return ;
+    }
+
+    butil::IOBufBuilder bufBuilder;
+    bufBuilder << serialize_write_batch(req_res_batch);
+
+    braft::Task task;
+    task.data = &bufBuilder.buf();
+    task.done = new ReplicationBatchClosure(std::move(req_res_batch));
+    task.expected_term = leader_term.load(butil::memory_order_relaxed);
+
+    node->apply(task);
+}
+
+std::string ReplicationState::serialize_write_batch(const req_res_batch_t& req_res_batch) {
+    // a batch is logged as an array of serialized requests, while a single request is logged as an object
+    nlohmann::json batch_json = nlohmann::json::array();
+
+    for(const auto& req_res: req_res_batch) {
+        batch_json.push_back(req_res.first->to_json());
+    }
+
+    return batch_json.dump();
+}
+
+bool ReplicationState::is_write_batch(const std::string& log_data) {
+    return !log_data.empty() && log_data[0] == '[';
+}
+
+std::vector<std::shared_ptr<http_req>> ReplicationState::deserialize_write_batch(const std::string& log_data) {
+    std::vector<std::shared_ptr<http_req>> requests;
+    nlohmann::json batch_json = nlohmann::json::parse(log_data, nullptr, false);
+
+    if(batch_json.is_discarded() || !batch_json.is_array()) {
+        LOG(ERROR) << "Could not parse batch of writes from log entry.";
+        return requests;
+    }
+
+    for(const auto& req_json: batch_json) {
+        auto request = std::make_shared<http_req>();
+        request->load_from_json(req_json.get<std::string>());
+        requests.push_back(request);
+    }
+
+    return requests;
+}
+
 void ReplicationState::write_to_leader(const std::shared_ptr<http_req>& request, const std::shared_ptr<http_res>& response) {
     // no lock on `node` needed as caller uses the lock
     if(!node || node->leader_id().is_empty()) {
@@ -438,12 +548,39 @@ void ReplicationState::on_apply(braft::Iterator& iter) {
     // NOTE: this is executed on a different thread and runs concurrent to http thread
     // A batch of tasks are committed, which must be processed through
     // |iter|
+    int64_t last_applied_index = 0;
+
     for (; iter.valid(); iter.next()) {
         // Guard invokes replication_arg->done->Run() asynchronously to avoid the callback blocking the main thread
         braft::AsyncClosureGuard closure_guard(iter.done());
+        last_applied_index = iter.index();
 
         //LOG(INFO) << "Apply entry";
 
+        auto batch_closure = iter.done() ? dynamic_cast<ReplicationBatchClosure*>(iter.done()) : nullptr;
+
+        if(batch_closure != nullptr) {
+            for(const auto& req_res: batch_closure->get_req_res_batch()) {
+                req_res.first->log_index = iter.index();
+                batched_indexer->enqueue(req_res.first, req_res.second);
+                pending_writes--;
+            }
+
+            continue;
+        }
+
+        const std::string& log_data = iter.done() ? "" : iter.data().to_string();
+
+        if(is_write_batch(log_data)) {
+            // log serialized batch of writes
+            for(const auto& request: deserialize_write_batch(log_data)) {
+                request->log_index = iter.index();
+                batched_indexer->enqueue(request, std::make_shared<http_res>(nullptr));
+            }
+
+            continue;
+        }
+
         const std::shared_ptr<http_req>& request_generated = iter.done() ?
                          dynamic_cast<ReplicationClosure*>(iter.done())->get_request() : std::make_shared<http_req>();
 
@@ -454,7 +591,7 @@ void ReplicationState::on_apply(braft::Iterator& iter) {
 
         if(!iter.done()) {
             // indicates log serialized request
-            request_generated->load_from_json(iter.data().to_string());
+            request_generated->load_from_json(log_data);
         }
 
         request_generated->log_index = iter.index();
@@ -469,6 +606,9 @@ void ReplicationState::on_apply(braft::Iterator& iter) {
             //LOG(INFO) << "pending_writes: " << pending_writes;
         }
     }
+
+    // entries that were not enqueued, e.g. an empty write batch, must not hold back the indexed log index
+    batched_indexer->set_applied_log_index(last_applied_index);
 }
 
 void ReplicationState::read(const std::shared_ptr<http_res>& response) {
@@ -585,11 +725,11 @@ void ReplicationState::on_snapshot_save(braft::SnapshotWriter* writer, braft::Cl
     bthread_start_urgent(&tid, NULL, save_snapshot, arg);
 }
 
-int ReplicationState::init_db() {
+int ReplicationState::init_db(std::vector<Collection*>* built_collections) {
     LOG(INFO) << "Loading collections from disk...";
 
     Option<bool> init_op = CollectionManager::get_instance().load(
-        num_collections_parallel_load, num_documents_parallel_load
+        num_collections_parallel_load, num_documents_parallel_load, built_collections
     );
 
     if(init_op.ok()) {
@@ -634,8 +774,8 @@ int ReplicationState::on_snapshot_load(braft::SnapshotReader* reader) {
 
     LOG(INFO) << "on_snapshot_load";
 
-    // ensures that reads and writes are rejected, as `store->reload()` unique locks the DB handle
-    read_caught_up = false;
+    // a node that is already serving keeps serving reads from its current state while the snapshot is being indexed
+    const bool serving_reads = read_caught_up;
     write_caught_up = false;
 
     // Load snapshot from leader, replacing the running StateMachine
@@ -655,16 +795,67 @@ int ReplicationState::on_snapshot_load(braft::SnapshotReader* reader) {
     std::string db_snapshot_path = reader->get_path();
     db_snapshot_path.append(std::string("/") + db_snapshot_name);
 
+    std::vector<Collection*> built_collections;
+    const bool collections_built = serving_reads && build_snapshot_collections(db_snapshot_path, built_collections);
+
+    // ensures that reads and writes are rejected, as `store->reload()` unique locks the DB handle
+    read_caught_up = false;
+    state_loaded = false;
+
     int reload_store = store->reload(true, db_snapshot_path);
     if(reload_store != 0) {
+        for(auto collection: built_collections) {
+            delete collection;
+        }
         return reload_store;
     }
 
-    bool init_db_status = init_db();
+    bool init_db_status = init_db(collections_built ? &built_collections : nullptr);
+
+    braft::SnapshotMeta snapshot_meta;
+    if(batched_indexer != nullptr && reader->load_meta(&snapshot_meta) == 0) {
+        batched_indexer->set_applied_log_index(snapshot_meta.last_included_index());
+    }
+
+    state_loaded = true;
 
     return init_db_status;
 }
 
+bool ReplicationState::build_snapshot_collections(const std::string& db_snapshot_path,
+                                                  std::vector<Collection*>& built_collections) {
+    const std::string staging_dir_path = store->get_state_dir_path() + "_staging";
+    LOG(INFO) << "Building collections of snapshot from " << staging_dir_path;
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    Option<bool> build_op(true);
+
+    {
+        Store staging_store(staging_dir_path);
+        if(staging_store.reload(true, db_snapshot_path) != 0) {
+            build_op = Option<bool>(500, "Could not open a copy of the snapshot db.");
+        } else {
+            build_op = CollectionManager::get_instance().build_collections(&staging_store,
+                                                                           num_collections_parallel_load,
+                                                                           num_documents_parallel_load,
+                                                                           built_collections);
+        }
+    }
+
+    delete_path(staging_dir_path, true);
+
+    if(!build_op.ok()) {
+        LOG(INFO) << "Collections will be loaded after the snapshot is installed: " << build_op.error();
+        return false;
+    }
+
+    auto time_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - begin).count();
+    LOG(INFO) << "Built " << built_collections.size() << " collection(s) of snapshot in " << time_elapsed << "ms";
+
+    return true;
+}
+
 void ReplicationState::refresh_nodes(const std::string & nodes, const size_t raft_counter,
                                      const std::atomic<bool>& reset_peers_on_error) {
     std::shared_lock lock(node_mutex);
@@ -831,7 +1022,7 @@ ReplicationState::ReplicationState(HttpServer* server, BatchedIndexer* batched_i
         config(config),
         num_collections_parallel_load(num_collections_parallel_load),
         num_documents_parallel_load(num_documents_parallel_load),
-        read_caught_up(false), write_caught_up(false),
+        read_caught_up(false), write_caught_up(false), state_loaded(false),
         ready(false), shutting_down(false), pending_writes(0), snapshot_in_progress(false),
         last_snapshot_ts(std::time(nullptr)), snapshot_interval_s(config->get_snapshot_interval_seconds()) {
 
@@ -1031,11 +1222,70 @@ nlohmann::json ReplicationState::get_status() {
 
     status["state"] = braft::state2str(node_status.state);
     status["committed_index"] = node_status.committed_index;
+    status["indexed_index"] = batched_indexer->get_indexed_log_index();
     status["queued_writes"] = batched_indexer->get_queued_writes();
 
     return status;
 }
 
+void ReplicationState::on_read_index(const std::map<std::string, std::string>& params,
+                                     const std::function<void(const Option<bool>&)>& callback) {
+    int64_t min_index = -1;
+    int64_t max_lag = -1;
+    uint64_t wait_ms = DEFAULT_READ_WAIT_MS;
+
+    auto min_index_it = params.find(READ_MIN_INDEX);
+    if(min_index_it != params.end()) {
+        if(!StringUtils::is_int64_t(min_index_it->second) || std::stoll(min_index_it->second) < 0) {
+            callback(Option<bool>(400, "Parameter `" + std::string(READ_MIN_INDEX) + "` must be a positive integer."));
+            return ;
+        }
+        min_index = std::stoll(min_index_it->second);
+    }
+
+    auto max_lag_it = params.find(READ_MAX_LAG);
+    if(max_lag_it != params.end()) {
+        if(!StringUtils::is_int64_t(max_lag_it->second) || std::stoll(max_lag_it->second) < 0) {
+            callback(Option<bool>(400, "Parameter `" + std::string(READ_MAX_LAG) + "` must be a positive integer."));
+            return ;
+        }
+        max_lag = std::stoll(max_lag_it->second);
+    }
+
+    auto wait_ms_it = params.find(READ_WAIT_MS);
+    if(wait_ms_it != params.end()) {
+        if(!StringUtils::is_uint64_t(wait_ms_it->second)) {
+            callback(Option<bool>(400, "Parameter `" + std::string(READ_WAIT_MS) + "` must be a positive integer."));
+            return ;
+        }
+        wait_ms = std::min<uint64_t>(std::stoull(wait_ms_it->second), MAX_READ_WAIT_MS);
+    }
+
+    int64_t target_index = min_index;
+
+    if(max_lag >= 0) {
+        // lag is measured against the log that this node knows to be committed when the read arrives
+        std::shared_lock lock(node_mutex);
+        if(!node) {
+            callback(Option<bool>(503, "Not Ready or Lagging"));
+            return ;
+        }
+
+        braft::NodeStatus n_status;
+        node->get_status(&n_status);
+        target_index = std::max(target_index, n_status.committed_index - max_lag);
+    }
+
+    if(!state_loaded) {
+        callback(Option<bool>(503, "Not Ready or Lagging"));
+        return ;
+    }
+
+    batched_indexer->on_indexed_log_index(target_index, wait_ms, [callback](bool indexed) {
+        callback(indexed ? Option<bool>(true) : Option<bool>(503, "Not Ready or Lagging"));
+    });
+}
+
 void ReplicationState::do_snapshot(const std::string& nodes) {
     auto current_ts = std::time(nullptr);
     if(current_ts - last_snapshot_ts < snapshot_interval_s) {
@@ -0,0 +1,112 @@
+#include "reference_doc_cache.h"
+
+void ReferenceDocCache::init(size_t capacity) {
+    std::unique_lock lock(mutex);
+    this->capacity = capacity;
+
+    while(entries.size() > capacity) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+bool ReferenceDocCache::is_enabled() const {
+    std::unique_lock lock(mutex);
+    return capacity != 0;
+}
+
+uint64_t ReferenceDocCache::get_generation() const {
+    std::unique_lock lock(mutex);
+    return generation;
+}
+
+bool ReferenceDocCache::get(uint32_t seq_id, const std::string& spec, nlohmann::json& doc) {
+    std::unique_lock lock(mutex);
+
+    if(capacity == 0) {
+        return false;
+    }
+
+    auto seq_id_it = entry_map.find(seq_id);
+    if(seq_id_it == entry_map.end()) {
+        num_misses++;
+        return false;
+    }
+
+    auto spec_it = seq_id_it->second.find(spec);
+    if(spec_it == seq_id_it->second.end()) {
+        num_misses++;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, spec_it->second);
+    doc = spec_it->second->doc;
+    num_hits++;
+    return true;
+}
+
+void ReferenceDocCache::put(uint32_t seq_id, const std::string& spec, const nlohmann::json& doc,
+                            uint64_t fetch_generation) {
+    std::unique_lock lock(mutex);
+
+    if(capacity == 0 || fetch_generation != generation) {
+        return;
+    }
+
+    auto& spec_map = entry_map[seq_id];
+    if(spec_map.count(spec) != 0) {
+        return;
+    }
+
+    entries.emplace_front(seq_id, spec, doc);
+    spec_map.emplace(spec, entries.begin());
+
+    while(entries.size() > capacity) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+void ReferenceDocCache::erase(std::list<entry_t>::iterator entry_it) {
+    auto seq_id_it = entry_map.find(entry_it->seq_id);
+    if(seq_id_it != entry_map.end()) {
+        seq_id_it->second.erase(entry_it->spec);
+        if(seq_id_it->second.empty()) {
+            entry_map.erase(seq_id_it);
+        }
+    }
+
+    entries.erase(entry_it);
+}
+
+void ReferenceDocCache::remove(uint32_t seq_id) {
+    std::unique_lock lock(mutex);
+    generation++;
+
+    auto seq_id_it = entry_map.find(seq_id);
+    if(seq_id_it == entry_map.end()) {
+        return;
+    }
+
+    for(const auto& spec_entry: seq_id_it->second) {
+        entries.erase(spec_entry.second);
+    }
+
+    entry_map.erase(seq_id_it);
+}
+
+void ReferenceDocCache::clear() {
+    std::unique_lock lock(mutex);
+    generation++;
+    entries.clear();
+    entry_map.clear();
+}
+
+size_t ReferenceDocCache::size() const {
+    std::unique_lock lock(mutex);
+    return entries.size();
+}
+
+void ReferenceDocCache::get_stats(uint64_t& hits, uint64_t& misses) const {
+    std::unique_lock lock(mutex);
+    hits = num_hits;
+    misses = num_misses;
+}
@@ -0,0 +1,82 @@
+#include "reference_join.h"
+#include <algorithm>
+
+void ReferenceJoin::group_by_doc(group_strategy_t strategy) {
+    if (is_grouped) {
+        return;
+    }
+
+    if (strategy == automatic) {
+        strategy = (size_t(max_doc_id) + 1) <= pairs.size() * COUNTING_SORT_MAX_SPREAD ? counting_sort : comparison_sort;
+    }
+
+    if (strategy == comparison_sort) {
+        // The reference doc ids of a doc are added in ascending order, so sorting the packed pairs keeps their order.
+        std::sort(pairs.begin(), pairs.end());
+    } else {
+        std::vector<uint32_t> offsets(size_t(max_doc_id) + 2, 0);
+        for (const auto& pair: pairs) {
+            offsets[get_doc_id(pair) + 1]++;
+        }
+
+        for (size_t i = 1; i < offsets.size(); i++) {
+            offsets[i] += offsets[i - 1];
+        }
+
+        std::vector<uint64_t> grouped_pairs(pairs.size());
+        for (const auto& pair: pairs) {
+            grouped_pairs[offsets[get_doc_id(pair)]++] = pair;
+        }
+
+        pairs = std::move(grouped_pairs);
+    }
+
+    is_grouped = true;
+}
+
+void ReferenceJoin::get_doc_ids(std::vector<uint32_t>& doc_ids) {
+    group_by_doc();
+
+    doc_ids.clear();
+    for (const auto& pair: pairs) {
+        auto const doc_id = get_doc_id(pair);
+        if (doc_ids.empty() || doc_ids.back() != doc_id) {
+            doc_ids.push_back(doc_id);
+        }
+    }
+}
+
+void ReferenceJoin::to_filter_result(const std::string& ref_collection_name, const bool is_reference_array_field,
+                                     filter_result_t& filter_result) {
+    if (pairs.empty()) {
+        return;
+    }
+
+    group_by_doc();
+
+    uint32_t num_docs = 0;
+    for (size_t i = 0; i < pairs.size(); i++) {
+        if (i == 0 || get_doc_id(pairs[i]) != get_doc_id(pairs[i - 1])) {
+            num_docs++;
+        }
+    }
+
+    filter_result.count = num_docs;
+    filter_result.docs = new uint32_t[num_docs];
+
+    filter_result.reference_collection_name = ref_collection_name;
+    filter_result.is_reference_array_field = is_reference_array_field;
+    filter_result.reference_offsets.reserve(size_t(num_docs) + 1);
+    filter_result.reference_docs.reserve(pairs.size());
+
+    for (size_t i = 0, result_index = 0; i < pairs.size(); i++) {
+        if (i == 0 || get_doc_id(pairs[i]) != get_doc_id(pairs[i - 1])) {
+            filter_result.docs[result_index++] = get_doc_id(pairs[i]);
+            filter_result.reference_offsets.push_back(i);
+        }
+
+        filter_result.reference_docs.push_back(get_reference_doc_id(pairs[i]));
+    }
+
+    filter_result.reference_offsets.push_back(pairs.size());
+}
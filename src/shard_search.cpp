@@ -0,0 +1,518 @@
+#include "shard_search.h"
+#include "collection_manager.h"
+#include "http_client.h"
+#include "string_utils.h"
+#include "threadpool.h"
+#include "tsconfig.h"
+
+static constexpr long SHARD_SEARCH_TIMEOUT_MS = 10 * 1000;
+
+ThreadPool* ShardSearch::thread_pool = nullptr;
+
+void ShardSearch::set_thread_pool(ThreadPool* pool) {
+    thread_pool = pool;
+}
+
+std::vector<std::string> ShardSearch::get_shard_nodes() {
+    std::vector<std::string> node_urls;
+    StringUtils::split(Config::get_instance().get_shard_nodes(), node_urls, ",");
+
+    for(auto& node_url: node_urls) {
+        if(!node_url.empty() && node_url.back() == '/') {
+            node_url.pop_back();
+        }
+    }
+
+    return node_urls;
+}
+
+Option<bool> ShardSearch::get_merge_sort_fields(const std::map<std::string, std::string>& req_params,
+                                                std::vector<sort_by>& sort_fields) {
+    auto get_param = [&req_params](const std::string& name) {
+        auto it = req_params.find(name);
+        return (it == req_params.end()) ? std::string() : it->second;
+    };
+
+    if(!get_param(collection_search_args_t::GROUP_BY).empty()) {
+        return Option<bool>(400, "Parameter `group_by` is not supported in a search across shards.");
+    }
+
+    const bool text_query = (get_param(collection_search_args_t::QUERY) != "*");
+    const bool vector_query = !get_param(collection_search_args_t::VECTOR_QUERY).empty();
+
+    if(text_query && vector_query) {
+        // rank fusion scores are relative to the results of each shard
+        return Option<bool>(400, "Hybrid search is not supported in a search across shards.");
+    }
+
+    const std::string& sort_by_str = get_param(collection_search_args_t::SORT_BY);
+
+    if(sort_by_str.empty()) {
+        if(vector_query) {
+            sort_fields.emplace_back(sort_field_const::vector_distance, sort_field_const::asc);
+            return Option<bool>(true);
+        }
+
+        if(text_query) {
+            sort_fields.emplace_back(sort_field_const::text_match, sort_field_const::desc);
+        }
+
+        auto collection = CollectionManager::get_instance().get_collection(get_param("collection"));
+        if(collection != nullptr && !collection->get_default_sorting_field().empty()) {
+            sort_fields.emplace_back(collection->get_default_sorting_field(), sort_field_const::desc);
+        }
+
+        return Option<bool>(true);
+    }
+
+    if(!CollectionManager::parse_sort_by_str(sort_by_str, sort_fields)) {
+        return Option<bool>(400, "Parameter `sort_by` is malformed.");
+    }
+
+    bool found_text_match = false;
+
+    for(auto& sort_field: sort_fields) {
+        if(sort_field.name.rfind(sort_field_const::text_match, 0) == 0) {
+            // text match buckets are ignored: hits are merged on their raw text match scores
+            sort_field.name = sort_field_const::text_match;
+            found_text_match = true;
+        } else if(sort_field.name == sort_field_const::vector_distance) {
+            continue;
+        } else if(sort_field.name[0] == '_' || sort_field.name[0] == '$') {
+            return Option<bool>(400, "Sorting on `" + sort_field.name + "` is not supported in a search across shards.");
+        } else if(sort_field.name.find('(') != std::string::npos) {
+            // geo sort: hits are merged on the distances that every shard returns for the field
+            sort_field.name = sort_field.name.substr(0, sort_field.name.find('('));
+            StringUtils::trim(sort_field.name);
+            sort_field.geopoint = 1;
+        }
+    }
+
+    if(text_query && !found_text_match) {
+        sort_fields.emplace_back(sort_field_const::text_match, sort_field_const::desc);
+    }
+
+    return Option<bool>(true);
+}
+
+Option<bool> ShardSearch::search_shard(const std::string& node_url, const std::string& api_key,
+                                       const std::map<std::string, std::string>& req_params,
+                                       nlohmann::json& result) {
+    // the search is sent as a multi search, which is always answered from the shard's own documents
+    nlohmann::json search = nlohmann::json::object();
+    for(const auto& kv: req_params) {
+        search[kv.first] = kv.second;
+    }
+
+    nlohmann::json body;
+    body["searches"] = nlohmann::json::array();
+    body["searches"].push_back(search);
+
+    std::string response;
+    std::map<std::string, std::string> res_headers;
+    std::unordered_map<std::string, std::string> headers = {
+        {"x-typesense-api-key", api_key},
+        {"Content-Type", "application/json"}
+    };
+
+    long status_code = HttpClient::post_response(node_url + "/multi_search", body.dump(), response, res_headers,
+                                                 headers, SHARD_SEARCH_TIMEOUT_MS);
+
+    if(status_code != 200) {
+        LOG(ERROR) << "Search on shard " << node_url << " failed, status_code: " << status_code
+                   << ", response: " << response;
+        return Option<bool>(status_code >= 400 && status_code < 500 ? status_code : 500,
+                            "Search on shard `" + node_url + "` failed.");
+    }
+
+    nlohmann::json response_json = nlohmann::json::parse(response, nullptr, false);
+    if(response_json.is_discarded() || !response_json.contains("results") || !response_json["results"].is_array() ||
+       response_json["results"].empty()) {
+        return Option<bool>(500, "Search on shard `" + node_url + "` returned a malformed response.");
+    }
+
+    result = std::move(response_json["results"][0]);
+
+    if(result.contains("error")) {
+        const uint32_t code = result.contains("code") ? result["code"].get<uint32_t>() : 500;
+        return Option<bool>(code, result["error"].get<std::string>());
+    }
+
+    return Option<bool>(true);
+}
+
+Option<size_t> ShardSearch::get_fetch_depth(const size_t offset, const size_t per_page, const size_t limit_hits) {
+    const size_t depth = std::min(offset + per_page, limit_hits);
+    const size_t max_hits = Config::get_instance().get_shard_search_max_hits();
+
+    if(depth > max_hits) {
+        return Option<size_t>(422, "Only upto " + std::to_string(max_hits) + " hits can be fetched in a search "
+                                   "across shards.");
+    }
+
+    return Option<size_t>(depth);
+}
+
+Option<bool> ShardSearch::fetch_shard_hits(const std::map<std::string, std::string>& shard_params, size_t depth,
+                                           const search_page_t& search_page, nlohmann::json& result) {
+    const size_t max_per_page = std::max<int>(1, Config::get_instance().get_max_per_page());
+    const size_t page_size = std::min(depth, max_per_page);
+    const size_t num_pages = (page_size == 0) ? 1 : (depth + page_size - 1) / page_size;
+
+    for(size_t page = 1; page <= num_pages; page++) {
+        std::map<std::string, std::string> page_params = shard_params;
+        page_params[collection_search_args_t::PAGE] = std::to_string(page);
+        page_params[collection_search_args_t::PER_PAGE] = std::to_string(page_size);
+
+        nlohmann::json page_result;
+        auto page_op = search_page(page_params, page_result);
+        if(!page_op.ok()) {
+            return page_op;
+        }
+
+        const size_t num_page_hits = page_result.contains("hits") ? page_result["hits"].size() : 0;
+
+        if(page == 1) {
+            result = std::move(page_result);
+        } else {
+            for(auto& hit: page_result["hits"]) {
+                result["hits"].push_back(std::move(hit));
+            }
+        }
+
+        if(num_page_hits < page_size) {
+            // the shard has no more hits
+            break;
+        }
+    }
+
+    return Option<bool>(true);
+}
+
+Option<bool> ShardSearch::search(std::map<std::string, std::string>& req_params, nlohmann::json& embedded_params,
+                                 const std::string& api_key, std::string& results_json_str, uint64_t start_ts) {
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    std::vector<sort_by> sort_fields;
+    auto sort_fields_op = get_merge_sort_fields(req_params, sort_fields);
+    if(!sort_fields_op.ok()) {
+        return sort_fields_op;
+    }
+
+    // params embedded in a scoped API key override the params of the request
+    std::map<std::string, std::string> params = req_params;
+    nlohmann::json key_params = embedded_params;
+    auto embedded_params_op = CollectionManager::apply_embedded_params(key_params, params);
+    if(!embedded_params_op.ok()) {
+        return embedded_params_op;
+    }
+
+    auto get_size_param = [&params](const char* name, size_t default_value) {
+        auto it = params.find(name);
+        return (it != params.end() && StringUtils::is_uint32_t(it->second)) ? std::stoul(it->second) : default_value;
+    };
+
+    const bool offset_given = (params.count(collection_search_args_t::OFFSET) != 0);
+    const size_t per_page = get_size_param(collection_search_args_t::LIMIT,
+                                           get_size_param(collection_search_args_t::PER_PAGE, 10));
+    const size_t page = std::max<size_t>(1, get_size_param(collection_search_args_t::PAGE, 1));
+    const size_t offset = offset_given ? get_size_param(collection_search_args_t::OFFSET, 0) : (page - 1) * per_page;
+    const size_t max_facet_values = get_size_param(collection_search_args_t::MAX_FACET_VALUES, 10);
+    const size_t limit_hits = get_size_param(collection_search_args_t::LIMIT_HITS, 1000000);
+
+    auto depth_op = get_fetch_depth(offset, per_page, limit_hits);
+    if(!depth_op.ok()) {
+        return Option<bool>(depth_op.code(), depth_op.error());
+    }
+
+    // every shard returns all the hits up to the requested page
+    std::map<std::string, std::string> shard_params = req_params;
+    shard_params.erase(collection_search_args_t::OFFSET);
+    shard_params.erase(collection_search_args_t::LIMIT);
+    const size_t depth = depth_op.get();
+
+    const std::vector<std::string> node_urls = get_shard_nodes();
+    std::vector<nlohmann::json> shard_results(node_urls.size() + 1);
+    std::vector<Option<bool>> shard_ops(node_urls.size() + 1, Option<bool>(true));
+
+    size_t num_processed = 0;
+    size_t num_queued = 0;
+    std::mutex m_process;
+    std::condition_variable cv_process;
+
+    auto search_remote_shard = [&](size_t i) {
+        return fetch_shard_hits(shard_params, depth,
+                                [&](std::map<std::string, std::string>& page_params, nlohmann::json& page_result) {
+            return search_shard(node_urls[i], api_key, page_params, page_result);
+        }, shard_results[i + 1]);
+    };
+
+    for(size_t i = 0; i < node_urls.size(); i++) {
+        if(thread_pool == nullptr) {
+            shard_ops[i + 1] = search_remote_shard(i);
+            continue;
+        }
+
+        num_queued++;
+
+        thread_pool->enqueue([&, i]() {
+            shard_ops[i + 1] = search_remote_shard(i);
+
+            std::unique_lock<std::mutex> lock(m_process);
+            num_processed++;
+            cv_process.notify_one();
+        });
+    }
+
+    // the local shard is searched while the other shards are being waited on
+    shard_ops[0] = fetch_shard_hits(shard_params, depth,
+                                    [&](std::map<std::string, std::string>& page_params, nlohmann::json& page_result) {
+        std::string page_results_json_str;
+        auto page_op = CollectionManager::do_search(page_params, embedded_params, page_results_json_str, start_ts);
+        if(page_op.ok()) {
+            page_result = nlohmann::json::parse(page_results_json_str);
+        }
+        return page_op;
+    }, shard_results[0]);
+
+    {
+        std::unique_lock<std::mutex> lock_process(m_process);
+        cv_process.wait(lock_process, [&](){ return num_processed == num_queued; });
+    }
+
+    for(const auto& shard_op: shard_ops) {
+        if(!shard_op.ok()) {
+            return Option<bool>(shard_op.code(), shard_op.error());
+        }
+    }
+
+    // the merged hits are cut at `limit_hits` as well
+    const size_t limit = (depth > offset) ? std::min(per_page, depth - offset) : 0;
+
+    nlohmann::json result;
+    merge_results(shard_results, sort_fields, offset, limit, max_facet_values, result);
+
+    if(result.contains("request_params")) {
+        result["request_params"]["per_page"] = per_page;
+    }
+
+    if(offset_given) {
+        result["offset"] = offset;
+    } else {
+        result["page"] = page;
+    }
+
+    result["search_time_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - begin).count();
+
+    results_json_str = result.dump(-1, ' ', false, nlohmann::detail::error_handler_t::ignore);
+    return Option<bool>(true);
+}
+
+static nlohmann::json get_sort_value(const nlohmann::json& hit, const sort_by& sort_field) {
+    const nlohmann::json* value = nullptr;
+
+    if(sort_field.name == sort_field_const::text_match) {
+        value = hit.contains("text_match") ? &hit["text_match"] : nullptr;
+    } else if(sort_field.name == sort_field_const::vector_distance) {
+        value = hit.contains("vector_distance") ? &hit["vector_distance"] : nullptr;
+    } else if(sort_field.geopoint != 0) {
+        if(hit.contains("geo_distance_meters") && hit["geo_distance_meters"].contains(sort_field.name)) {
+            value = &hit["geo_distance_meters"][sort_field.name];
+        }
+    } else if(hit.contains("document")) {
+        // nested fields are looked up along their path
+        std::vector<std::string> path;
+        StringUtils::split(sort_field.name, path, ".");
+        value = &hit["document"];
+
+        for(const auto& key: path) {
+            if(!value->is_object() || !value->contains(key)) {
+                value = nullptr;
+                break;
+            }
+
+            value = &(*value)[key];
+        }
+    }
+
+    return value == nullptr ? nlohmann::json() : *value;
+}
+
+// returns a negative value when `a` should be placed before `b`
+static int compare_sort_values(const nlohmann::json& a, const nlohmann::json& b, const bool asc) {
+    if(a.is_null() || b.is_null()) {
+        // hits without a value are placed last, regardless of the order
+        return (a.is_null() == b.is_null()) ? 0 : (a.is_null() ? 1 : -1);
+    }
+
+    int cmp = 0;
+
+    if(a.is_number_unsigned() && b.is_number_unsigned()) {
+        // text match scores do not fit into a double without losing precision
+        const auto x = a.get<uint64_t>(), y = b.get<uint64_t>();
+        cmp = (x < y) ? -1 : (x > y ? 1 : 0);
+    } else if(a.is_number_integer() && b.is_number_integer()) {
+        const auto x = a.get<int64_t>(), y = b.get<int64_t>();
+        cmp = (x < y) ? -1 : (x > y ? 1 : 0);
+    } else if((a.is_number() || a.is_boolean()) && (b.is_number() || b.is_boolean())) {
+        const double x = a.is_boolean() ? a.get<bool>() : a.get<double>();
+        const double y = b.is_boolean() ? b.get<bool>() : b.get<double>();
+        cmp = (x < y) ? -1 : (x > y ? 1 : 0);
+    } else if(a.is_string() && b.is_string()) {
+        cmp = a.get_ref<const std::string&>().compare(b.get_ref<const std::string&>());
+        cmp = (cmp < 0) ? -1 : (cmp > 0 ? 1 : 0);
+    }
+
+    return asc ? cmp : -cmp;
+}
+
+void ShardSearch::merge_results(const std::vector<nlohmann::json>& shard_results,
+                                const std::vector<sort_by>& sort_fields,
+                                size_t offset, size_t limit, size_t max_facet_values,
+                                nlohmann::json& merged) {
+    struct shard_hit_t {
+        const nlohmann::json* hit;
+        std::vector<nlohmann::json> sort_values;
+        bool curated;
+        size_t rank;
+        size_t shard_index;
+    };
+
+    std::vector<shard_hit_t> shard_hits;
+    size_t found = 0;
+    size_t out_of = 0;
+
+    for(size_t shard_index = 0; shard_index < shard_results.size(); shard_index++) {
+        const auto& shard_result = shard_results[shard_index];
+        found += shard_result.value("found", size_t(0));
+        out_of += shard_result.value("out_of", size_t(0));
+
+        if(!shard_result.contains("hits")) {
+            continue;
+        }
+
+        const auto& hits = shard_result["hits"];
+        for(size_t rank = 0; rank < hits.size(); rank++) {
+            shard_hit_t shard_hit{&hits[rank], {}, hits[rank].value("curated", false), rank, shard_index};
+            for(const auto& sort_field: sort_fields) {
+                shard_hit.sort_values.push_back(get_sort_value(hits[rank], sort_field));
+            }
+            shard_hits.push_back(std::move(shard_hit));
+        }
+    }
+
+    std::sort(shard_hits.begin(), shard_hits.end(), [&sort_fields](const shard_hit_t& a, const shard_hit_t& b) {
+        if(a.curated != b.curated) {
+            return a.curated;
+        }
+
+        for(size_t i = 0; i < sort_fields.size(); i++) {
+            const bool asc = (sort_fields[i].order == sort_field_const::asc);
+            const int cmp = compare_sort_values(a.sort_values[i], b.sort_values[i], asc);
+            if(cmp != 0) {
+                return cmp < 0;
+            }
+        }
+
+        // ties are interleaved across shards in the order that each shard ranked them
+        return (a.rank != b.rank) ? (a.rank < b.rank) : (a.shard_index < b.shard_index);
+    });
+
+    merged = nlohmann::json::object();
+    merged["found"] = found;
+    merged["out_of"] = out_of;
+    merged["hits"] = nlohmann::json::array();
+
+    for(size_t i = offset; i < shard_hits.size() && i < offset + limit; i++) {
+        merged["hits"].push_back(*shard_hits[i].hit);
+    }
+
+    if(!shard_results.empty() && shard_results[0].contains("request_params")) {
+        merged["request_params"] = shard_results[0]["request_params"];
+        merged["request_params"]["per_page"] = limit;
+    }
+
+    // facet counts are summed per value, and the facets are kept in the order of the first shard
+    std::vector<std::string> facet_field_names;
+    std::unordered_map<std::string, nlohmann::json> facet_field_counts;
+
+    for(const auto& shard_result: shard_results) {
+        if(!shard_result.contains("facet_counts")) {
+            continue;
+        }
+
+        for(const auto& facet_count: shard_result["facet_counts"]) {
+            const std::string& field_name = facet_count["field_name"].get<std::string>();
+            auto facet_it = facet_field_counts.find(field_name);
+
+            if(facet_it == facet_field_counts.end()) {
+                facet_field_names.push_back(field_name);
+                facet_field_counts.emplace(field_name, facet_count);
+                continue;
+            }
+
+            auto& merged_facet = facet_it->second;
+            auto& merged_counts = merged_facet["counts"];
+
+            for(const auto& count: facet_count["counts"]) {
+                bool found_value = false;
+                for(auto& merged_count: merged_counts) {
+                    if(merged_count["value"] == count["value"]) {
+                        merged_count["count"] = merged_count["count"].get<size_t>() + count["count"].get<size_t>();
+                        found_value = true;
+                        break;
+                    }
+                }
+
+                if(!found_value) {
+                    merged_counts.push_back(count);
+                }
+            }
+
+            if(facet_count.contains("stats") && merged_facet.contains("stats")) {
+                auto& merged_stats = merged_facet["stats"];
+                const auto& stats = facet_count["stats"];
+
+                if(stats.contains("min") && merged_stats.contains("min")) {
+                    merged_stats["min"] = std::min(merged_stats["min"].get<double>(), stats["min"].get<double>());
+                }
+
+                if(stats.contains("max") && merged_stats.contains("max")) {
+                    merged_stats["max"] = std::max(merged_stats["max"].get<double>(), stats["max"].get<double>());
+                }
+
+                if(stats.contains("sum") && merged_stats.contains("sum")) {
+                    merged_stats["sum"] = merged_stats["sum"].get<double>() + stats["sum"].get<double>();
+                }
+
+                // averages and distinct counts cannot be derived from the per shard values
+                merged_stats.erase("avg");
+                merged_stats.erase("total_values");
+            }
+
+            if(facet_count.value("sampled", false)) {
+                merged_facet["sampled"] = true;
+            }
+        }
+    }
+
+    merged["facet_counts"] = nlohmann::json::array();
+
+    for(const auto& field_name: facet_field_names) {
+        auto& merged_facet = facet_field_counts[field_name];
+        auto& merged_counts = merged_facet["counts"];
+
+        std::vector<nlohmann::json> counts(merged_counts.begin(), merged_counts.end());
+        std::stable_sort(counts.begin(), counts.end(), [](const nlohmann::json& a, const nlohmann::json& b) {
+            return a["count"].get<size_t>() > b["count"].get<size_t>();
+        });
+
+        if(counts.size() > max_facet_values) {
+            counts.resize(max_facet_values);
+        }
+
+        merged_counts = counts;
+        merged["facet_counts"].push_back(merged_facet);
+    }
+}
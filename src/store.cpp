@@ -113,6 +113,33 @@ StoreStatus Store::get(const std::string& key, std::string& value) const {
     return StoreStatus::ERROR;
 }
 
+void Store::multi_get(const std::vector<std::string>& keys, std::vector<std::string>& values,
+                      std::vector<StoreStatus>& statuses) const {
+    std::vector<rocksdb::Slice> key_slices;
+    key_slices.reserve(keys.size());
+    for(const auto& key: keys) {
+        key_slices.emplace_back(key);
+    }
+
+    values.clear();
+    statuses.clear();
+    statuses.reserve(keys.size());
+
+    std::shared_lock lock(mutex);
+    const std::vector<rocksdb::Status>& key_statuses = db->MultiGet(rocksdb::ReadOptions(), key_slices, &values);
+
+    for(size_t i = 0; i < key_statuses.size(); i++) {
+        if(key_statuses[i].ok()) {
+            statuses.push_back(StoreStatus::FOUND);
+        } else if(key_statuses[i].IsNotFound()) {
+            statuses.push_back(StoreStatus::NOT_FOUND);
+        } else {
+            LOG(ERROR) << "Error while fetching the key: " << keys[i] << " - status is: " << key_statuses[i].ToString();
+            statuses.push_back(StoreStatus::ERROR);
+        }
+    }
+}
+
 bool Store::remove(const std::string& key) {
     std::shared_lock lock(mutex);
     rocksdb::Status status = db->Delete(write_options, key);
@@ -33,6 +33,7 @@ TextEmbedder::TextEmbedder(const std::string& model_name, const bool is_public_m
     LOG(INFO) << "Loading model from disk: " << abs_path;
     env_ = std::make_shared<Ort::Env>();
     session_ = std::make_shared<Ort::Session>(*env_, abs_path.c_str(), session_options);
+    num_free_runs_ = EmbedderManager::get_model_concurrency();
     std::ifstream config_file(EmbedderManager::get_absolute_config_path(model_name, is_public_model));
     nlohmann::json config;
     config_file >> config;
@@ -120,201 +121,220 @@ std::vector<float> TextEmbedder::mean_pooling(const std::vector<std::vector<floa
 embedding_res_t TextEmbedder::Embed(const std::string& text, const size_t remote_embedder_timeout_ms, const size_t remote_embedding_num_tries) {
     if(is_remote()) {
         return remote_embedder_->Embed(text, remote_embedder_timeout_ms, remote_embedding_num_tries);
+    } else if(tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
+        // the dummy pixel values input of clip has a batch size of 1, so its text input is not batched
+        run_guard_t run(*this);
+        return run_batch({text})[0];
     } else {
-        std::unique_lock<std::mutex> lock(mutex_);
-        auto encoded_input = tokenizer_->Encode(text);
-        lock.unlock();
-        // create input tensor object from data values
-        Ort::AllocatorWithDefaultOptions allocator;
-        Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-        std::vector<Ort::Value> input_tensors;
-        std::vector<std::vector<int64_t>> input_shapes;
-        std::vector<const char*> input_node_names = {"input_ids", "attention_mask"};
-        // If model is DistilBERT or sentencepiece, it has 2 inputs, else it has 3 inputs
-        if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
-            input_node_names.push_back("token_type_ids");
-        } else if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-            input_node_names.push_back("pixel_values");
-        }
-        input_shapes.push_back({1, static_cast<int64_t>(encoded_input.input_ids.size())});
-        input_shapes.push_back({1, static_cast<int64_t>(encoded_input.attention_mask.size())});
-        if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
-            // edge case: xlm_roberta does not have token_type_ids, but if the model has it as input, we need to fill it with 0s
-            if(encoded_input.token_type_ids.size() == 0) {
-                encoded_input.token_type_ids.resize(encoded_input.input_ids.size(), 0);
-            }
+        return batched_embed(text);
+    }
+}
 
-            input_shapes.push_back({1, static_cast<int64_t>(encoded_input.token_type_ids.size())});
-        } else if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-            // dummy input for clip
-            input_shapes.push_back({1, 3, 224, 224});
-        }
-        input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, encoded_input.input_ids.data(), encoded_input.input_ids.size(), input_shapes[0].data(), input_shapes[0].size()));
-        input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, encoded_input.attention_mask.data(), encoded_input.attention_mask.size(), input_shapes[1].data(), input_shapes[1].size()));
-        if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
-            input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, encoded_input.token_type_ids.data(), encoded_input.token_type_ids.size(), input_shapes[2].data(), input_shapes[2].size()));
-        } else if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-            // dummy input for clip
-            std::vector<float> pixel_values(3 * 224 * 224, 0.5);
-            input_tensors.push_back(Ort::Value::CreateTensor<float>(memory_info, pixel_values.data(), pixel_values.size(), input_shapes[2].data(), input_shapes[2].size()));
+embedding_res_t TextEmbedder::batched_embed(const std::string& text) {
+    pending_embed_t pending(text);
+
+    std::unique_lock<std::mutex> lock(batch_mutex_);
+    pending_embeds_.push_back(&pending);
+
+    while(!pending.done) {
+        if(pending.taken || batch_leader_active_) {
+            batch_cv_.wait(lock, [&]() { return pending.done || (!pending.taken && !batch_leader_active_); });
+            continue;
         }
 
-        //LOG(INFO) << "Running model";
-        // create output tensor object
-        std::vector<const char*> output_node_names = {output_tensor_name.c_str()};
-        // Cannot run same model in parallel, so lock the mutex
-        lock.lock();
-        auto output_tensor = session_->Run(Ort::RunOptions{nullptr}, input_node_names.data(), input_tensors.data(), input_tensors.size(), output_node_names.data(), output_node_names.size());
+        // Lead the next batch: while we wait for a free run, concurrent calls queue up behind us and are run
+        // along with our input. When a run is free right away, the input is run without any added latency.
+        batch_leader_active_ = true;
         lock.unlock();
-        std::vector<std::vector<float>> output;
-        float* data = output_tensor[0].GetTensorMutableData<float>();
-        // print output tensor shape
-        auto shape = output_tensor[0].GetTensorTypeAndShapeInfo().GetShape();
-        // edge case for clip model
-        if(shape.size() == 2) {
-            // insert 1 to index 0
-            shape.insert(shape.begin(), 1);
-        }
 
-        for (int i = 0; i < shape[1]; i++) {
-            std::vector<float> temp;
-            for (int j = 0; j < shape[2]; j++) {
-                temp.push_back(data[i * shape[2] + j]);
+        std::vector<pending_embed_t*> batch;
+        std::vector<embedding_res_t> outputs;
+
+        {
+            run_guard_t run(*this);
+            lock.lock();
+
+            std::vector<std::string> input_batch;
+            while(!pending_embeds_.empty() && batch.size() < MAX_BATCH_SIZE) {
+                batch.push_back(pending_embeds_.front());
+                batch.back()->taken = true;
+                input_batch.push_back(batch.back()->text);
+                pending_embeds_.pop_front();
             }
-            // edge case for clip model
-            if(tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-                return embedding_res_t(temp);
+
+            // the next batch can be gathered while this one runs
+            batch_leader_active_ = false;
+            batch_cv_.notify_all();
+            lock.unlock();
+
+            try {
+                outputs = run_batch(input_batch);
+            } catch(const std::exception& e) {
+                LOG(ERROR) << "Error while running embedding model: " << e.what();
             }
-            output.push_back(temp);
         }
-        auto pooled_output = mean_pooling(output, encoded_input.attention_mask);
-        return embedding_res_t(pooled_output);
+
+        lock.lock();
+        for(size_t i = 0; i < batch.size(); i++) {
+            if(outputs.size() == batch.size()) {
+                batch[i]->result = std::move(outputs[i]);
+            } else {
+                batch[i]->result = embedding_res_t(500, nlohmann::json({{"error", "Error while running embedding model."}}));
+            }
+            batch[i]->done = true;
+        }
+        batch_cv_.notify_all();
     }
+
+    return std::move(pending.result);
 }
 
 std::vector<embedding_res_t> TextEmbedder::batch_embed(const std::vector<std::string>& inputs, const size_t remote_embedding_batch_size,
                                                        const size_t remote_embedding_timeout_ms, const size_t remote_embedding_num_tries) {
     std::vector<embedding_res_t> outputs;
     if(!is_remote()) {
-        for(int i = 0; i < inputs.size(); i += 8) {
-            auto input_batch = std::vector<std::string>(inputs.begin() + i, inputs.begin() + std::min(i + 8, static_cast<int>(inputs.size())));
-            auto encoded_inputs = batch_encode(input_batch);
-            
-            // create input tensor object from data values
-            Ort::AllocatorWithDefaultOptions allocator;
-            Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-            std::vector<Ort::Value> input_tensors;
-            std::vector<std::vector<int64_t>> input_shapes;
-            std::vector<const char*> input_node_names = {"input_ids", "attention_mask"};
-            // If model is DistilBERT or sentencepiece, it has 2 inputs, else it has 3 inputs
-            if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
-                input_node_names.push_back("token_type_ids");
-            } else if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-                input_node_names.push_back("pixel_values");
-            }
+        for(size_t i = 0; i < inputs.size(); i += MAX_BATCH_SIZE) {
+            auto input_batch = std::vector<std::string>(inputs.begin() + i, inputs.begin() + std::min(i + MAX_BATCH_SIZE, inputs.size()));
+            run_guard_t run(*this);
+            auto batch_outputs = run_batch(input_batch);
+            outputs.insert(outputs.end(), std::make_move_iterator(batch_outputs.begin()),
+                           std::make_move_iterator(batch_outputs.end()));
+        }
+    } else {
+        outputs = std::move(remote_embedder_->batch_embed(inputs, remote_embedding_batch_size, remote_embedding_timeout_ms, remote_embedding_num_tries));
+    }
+    
+    return outputs;
+}
 
-            input_shapes.push_back({static_cast<int64_t>(encoded_inputs.input_ids.size()), static_cast<int64_t>(encoded_inputs.input_ids[0].size())});
-            input_shapes.push_back({static_cast<int64_t>(encoded_inputs.attention_mask.size()), static_cast<int64_t>(encoded_inputs.attention_mask[0].size())});
-            if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
-                input_shapes.push_back({static_cast<int64_t>(encoded_inputs.token_type_ids.size()), static_cast<int64_t>(encoded_inputs.token_type_ids[0].size())});
-            } else if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-                // dummy input for clip
-                input_shapes.push_back({1, 3, 224, 224});
-            }
+std::vector<embedding_res_t> TextEmbedder::run_batch(const std::vector<std::string>& input_batch) {
+    Ort::Session& session = *session_;
+    std::vector<embedding_res_t> outputs;
+    auto encoded_inputs = batch_encode(input_batch);
+    
+    // create input tensor object from data values
+    Ort::AllocatorWithDefaultOptions allocator;
+    Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+    std::vector<Ort::Value> input_tensors;
+    std::vector<std::vector<int64_t>> input_shapes;
+    std::vector<const char*> input_node_names = {"input_ids", "attention_mask"};
+    // If model is DistilBERT or sentencepiece, it has 2 inputs, else it has 3 inputs
+    if(session.GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
+        input_node_names.push_back("token_type_ids");
+    } else if(session.GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
+        input_node_names.push_back("pixel_values");
+    }
 
-            std::vector<int64_t> input_ids_flatten;
-            std::vector<int64_t> attention_mask_flatten;
-            std::vector<int64_t> token_type_ids_flatten;
+    input_shapes.push_back({static_cast<int64_t>(encoded_inputs.input_ids.size()), static_cast<int64_t>(encoded_inputs.input_ids[0].size())});
+    input_shapes.push_back({static_cast<int64_t>(encoded_inputs.attention_mask.size()), static_cast<int64_t>(encoded_inputs.attention_mask[0].size())});
+    if(session.GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
+        input_shapes.push_back({static_cast<int64_t>(encoded_inputs.token_type_ids.size()), static_cast<int64_t>(encoded_inputs.token_type_ids[0].size())});
+    } else if(session.GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
+        // dummy input for clip
+        input_shapes.push_back({1, 3, 224, 224});
+    }
 
-            for (int i = 0; i < encoded_inputs.input_ids.size(); i++) {
-                for (int j = 0; j < encoded_inputs.input_ids[i].size(); j++) {
-                    input_ids_flatten.push_back(encoded_inputs.input_ids[i][j]);
-                }
-            }
+    std::vector<int64_t> input_ids_flatten;
+    std::vector<int64_t> attention_mask_flatten;
+    std::vector<int64_t> token_type_ids_flatten;
 
-            for (int i = 0; i < encoded_inputs.attention_mask.size(); i++) {
-                for (int j = 0; j < encoded_inputs.attention_mask[i].size(); j++) {
-                    attention_mask_flatten.push_back(encoded_inputs.attention_mask[i][j]);
-                }
-            }
+    for (int i = 0; i < encoded_inputs.input_ids.size(); i++) {
+        for (int j = 0; j < encoded_inputs.input_ids[i].size(); j++) {
+            input_ids_flatten.push_back(encoded_inputs.input_ids[i][j]);
+        }
+    }
 
-            if(session_->GetInputCount() == 3) {
-                for (int i = 0; i < encoded_inputs.token_type_ids.size(); i++) {
-                    for (int j = 0; j < encoded_inputs.token_type_ids[i].size(); j++) {
-                        token_type_ids_flatten.push_back(encoded_inputs.token_type_ids[i][j]);
-                    }
-                }
-            }
+    for (int i = 0; i < encoded_inputs.attention_mask.size(); i++) {
+        for (int j = 0; j < encoded_inputs.attention_mask[i].size(); j++) {
+            attention_mask_flatten.push_back(encoded_inputs.attention_mask[i][j]);
+        }
+    }
 
-            input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, input_ids_flatten.data(), input_ids_flatten.size(), input_shapes[0].data(), input_shapes[0].size()));
-            input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, attention_mask_flatten.data(), attention_mask_flatten.size(), input_shapes[1].data(), input_shapes[1].size()));
-            if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
-                input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, token_type_ids_flatten.data(), token_type_ids_flatten.size(), input_shapes[2].data(), input_shapes[2].size()));
-            } else if(session_->GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-                // dummy input for clip
-                std::vector<float> pixel_values(3 * 224 * 224, 0.5);
-                input_tensors.push_back(Ort::Value::CreateTensor<float>(memory_info, pixel_values.data(), pixel_values.size(), input_shapes[2].data(), input_shapes[2].size()));
+    if(session.GetInputCount() == 3) {
+        for (int i = 0; i < encoded_inputs.token_type_ids.size(); i++) {
+            for (int j = 0; j < encoded_inputs.token_type_ids[i].size(); j++) {
+                token_type_ids_flatten.push_back(encoded_inputs.token_type_ids[i][j]);
             }
+        }
+    }
 
-            //LOG(INFO) << "Running model";
-            // create output tensor object
-            std::vector<const char*> output_node_names = {output_tensor_name.c_str()};
+    input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, input_ids_flatten.data(), input_ids_flatten.size(), input_shapes[0].data(), input_shapes[0].size()));
+    input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, attention_mask_flatten.data(), attention_mask_flatten.size(), input_shapes[1].data(), input_shapes[1].size()));
+    if(session.GetInputCount() == 3 && tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
+        input_tensors.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, token_type_ids_flatten.data(), token_type_ids_flatten.size(), input_shapes[2].data(), input_shapes[2].size()));
+    } else if(session.GetInputCount() == 3 && tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
+        // dummy input for clip
+        std::vector<float> pixel_values(3 * 224 * 224, 0.5);
+        input_tensors.push_back(Ort::Value::CreateTensor<float>(memory_info, pixel_values.data(), pixel_values.size(), input_shapes[2].data(), input_shapes[2].size()));
+    }
 
-            // if seq length is 0, return empty vector
-            if(input_shapes[0][1] == 0) {
-                for(int i = 0; i < input_batch.size(); i++) {
-                    outputs.push_back(embedding_res_t(400, nlohmann::json({{"error", "Invalid input: empty sequence"}})));
-                }
-                continue;
-            }
+    //LOG(INFO) << "Running model";
+    // create output tensor object
+    std::vector<const char*> output_node_names = {output_tensor_name.c_str()};
 
-            std::unique_lock<std::mutex> lock(mutex_);
-            auto output_tensor = session_->Run(Ort::RunOptions{nullptr}, input_node_names.data(), input_tensors.data(), input_tensors.size(), output_node_names.data(), output_node_names.size());
-            lock.unlock();
-            float* data = output_tensor[0].GetTensorMutableData<float>();
-            // print output tensor shape
-            auto shape = output_tensor[0].GetTensorTypeAndShapeInfo().GetShape();
-            // edge case for clip model
-            if(shape.size() == 2) {
-                // insert 1 to index 0
-                shape.insert(shape.begin(), 1);
+    // if seq length is 0, return empty vector
+    if(input_shapes[0][1] == 0) {
+        for(int i = 0; i < input_batch.size(); i++) {
+            outputs.push_back(embedding_res_t(400, nlohmann::json({{"error", "Invalid input: empty sequence"}})));
+        }
+        return outputs;
+    }
+
+    auto output_tensor = session.Run(Ort::RunOptions{nullptr}, input_node_names.data(), input_tensors.data(), input_tensors.size(), output_node_names.data(), output_node_names.size());
+    float* data = output_tensor[0].GetTensorMutableData<float>();
+    // print output tensor shape
+    auto shape = output_tensor[0].GetTensorTypeAndShapeInfo().GetShape();
+    // edge case for clip model
+    if(shape.size() == 2) {
+        // insert 1 to index 0
+        shape.insert(shape.begin(), 1);
+    }
+    for (int i = 0; i < shape[0]; i++) {
+        std::vector<std::vector<float>> output;
+        for (int j = 0; j < shape[1]; j++) {
+            std::vector<float> output_row;
+            for (int k = 0; k < shape[2]; k++) {
+                output_row.push_back(data[i * shape[1] * shape[2] + j * shape[2] + k]);
             }
-            for (int i = 0; i < shape[0]; i++) {
-                std::vector<std::vector<float>> output;
-                for (int j = 0; j < shape[1]; j++) {
-                    std::vector<float> output_row;
-                    for (int k = 0; k < shape[2]; k++) {
-                        output_row.push_back(data[i * shape[1] * shape[2] + j * shape[2] + k]);
-                    }
-                    if(tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
-                        // no mean pooling for clip
-                        outputs.push_back(embedding_res_t(output_row));
-                        continue;
-                    }
-                    output.push_back(output_row);
-                }
-                if(tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
-                    outputs.push_back(embedding_res_t(mean_pooling(output, encoded_inputs.attention_mask[i])));
-                }
+            if(tokenizer_->get_tokenizer_type() == TokenizerType::clip) {
+                // no mean pooling for clip
+                outputs.push_back(embedding_res_t(output_row));
+                continue;
             }
+            output.push_back(output_row);
+        }
+        if(tokenizer_->get_tokenizer_type() != TokenizerType::clip) {
+            outputs.push_back(embedding_res_t(mean_pooling(output, encoded_inputs.attention_mask[i])));
         }
-    } else {
-        outputs = std::move(remote_embedder_->batch_embed(inputs, remote_embedding_batch_size, remote_embedding_timeout_ms, remote_embedding_num_tries));
     }
-    
+
     return outputs;
 }
 
+void TextEmbedder::acquire_run() {
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    run_cv_.wait(lock, [&]() { return num_free_runs_ != 0; });
+    num_free_runs_--;
+}
+
+void TextEmbedder::release_run() {
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    num_free_runs_++;
+    run_cv_.notify_one();
+}
+
 TextEmbedder::~TextEmbedder() { }
 
 batch_encoded_input_t TextEmbedder::batch_encode(const std::vector<std::string>& inputs) {
     batch_encoded_input_t encoded_inputs;
+    std::unique_lock<std::mutex> lock(mutex_);
     for(auto& input : inputs) {
         auto encoded_input = tokenizer_->Encode(input);
         encoded_inputs.input_ids.push_back(encoded_input.input_ids);
         encoded_inputs.attention_mask.push_back(encoded_input.attention_mask);
         encoded_inputs.token_type_ids.push_back(encoded_input.token_type_ids);
     }
+    lock.unlock();
 
     // Pad inputs
     size_t max_input_len = 0;
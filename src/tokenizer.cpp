@@ -370,6 +370,57 @@ bool Tokenizer::next(std::string &token, size_t &token_index) {
     return next(token, token_index, start_index, end_index);
 }
 
+size_t Tokenizer::skip_tokens(size_t num_tokens) {
+    if(no_op || bi != nullptr || !out.empty()) {
+        return 0;
+    }
+
+    size_t num_skipped = 0;
+
+    while(num_skipped < num_tokens) {
+        size_t j = i;
+        while(j < text.size() && is_ascii_char(text[j]) && get_stream_mode(text[j]) == SEPARATE) {
+            j++;
+        }
+
+        size_t segment_start = j;
+        bool has_index_char = false, has_unicode_char = false;
+
+        while(j < text.size() && !(is_ascii_char(text[j]) && get_stream_mode(text[j]) == SEPARATE)) {
+            if(!is_ascii_char(text[j])) {
+                has_unicode_char = true;
+            } else if(get_stream_mode(text[j]) == INDEX) {
+                has_index_char = true;
+            }
+            j++;
+        }
+
+        if(j == text.size()) {
+            // the last segment is left to `next()`, since it ends the text rather than at a separator
+            i = segment_start;
+            break;
+        }
+
+        if(!has_index_char) {
+            if(has_unicode_char) {
+                // whether unicode symbols form a token depends on their normalized form
+                i = segment_start;
+                break;
+            }
+
+            // segment of skipped characters
+            i = j + 1;
+            continue;
+        }
+
+        num_skipped++;
+        i = j + 1;
+    }
+
+    token_counter += num_skipped;
+    return num_skipped;
+}
+
 bool Tokenizer::is_cyrillic(const std::string& locale) {
     return locale == "el" || locale == "bg" ||
            locale == "ru" || locale == "sr" || locale == "uk" || locale == "be";
@@ -192,6 +192,34 @@ void Config::load_config_env() {
         this->healthy_write_lag = std::stoi(get_env("TYPESENSE_HEALTHY_WRITE_LAG"));
     }
 
+    if(!get_env("TYPESENSE_WRITE_BATCH_WINDOW_US").empty()) {
+        this->write_batch_window_us = std::stoi(get_env("TYPESENSE_WRITE_BATCH_WINDOW_US"));
+    }
+
+    if(!get_env("TYPESENSE_SHARD_NODES").empty()) {
+        this->shard_nodes = get_env("TYPESENSE_SHARD_NODES");
+    }
+
+    if(!get_env("TYPESENSE_SHARD_SEARCH_MAX_HITS").empty()) {
+        this->shard_search_max_hits = std::stoul(get_env("TYPESENSE_SHARD_SEARCH_MAX_HITS"));
+    }
+
+    if(!get_env("TYPESENSE_MAX_INFLIGHT_QUERY_COST").empty()) {
+        this->max_inflight_query_cost = std::stoull(get_env("TYPESENSE_MAX_INFLIGHT_QUERY_COST"));
+    }
+
+    if(!get_env("TYPESENSE_EMBEDDING_MODEL_CONCURRENCY").empty()) {
+        this->embedding_model_concurrency = std::stoul(get_env("TYPESENSE_EMBEDDING_MODEL_CONCURRENCY"));
+    }
+
+    if(!get_env("TYPESENSE_QUERY_EMBEDDING_CACHE_MB").empty()) {
+        this->query_embedding_cache_mb = std::stoul(get_env("TYPESENSE_QUERY_EMBEDDING_CACHE_MB"));
+    }
+
+    if(!get_env("TYPESENSE_REFERENCE_DOC_CACHE_SIZE").empty()) {
+        this->reference_doc_cache_size = std::stoul(get_env("TYPESENSE_REFERENCE_DOC_CACHE_SIZE"));
+    }
+
     if(!get_env("TYPESENSE_LOG_SLOW_REQUESTS_TIME_MS").empty()) {
         this->log_slow_requests_time_ms = std::stoi(get_env("TYPESENSE_LOG_SLOW_REQUESTS_TIME_MS"));
     }
@@ -228,6 +256,10 @@ void Config::load_config_env() {
         this->thread_pool_size = std::stoi(get_env("TYPESENSE_THREAD_POOL_SIZE"));
     }
 
+    if(!get_env("TYPESENSE_NUM_HTTP_EVENT_LOOPS").empty()) {
+        this->num_http_event_loops = std::stoi(get_env("TYPESENSE_NUM_HTTP_EVENT_LOOPS"));
+    }
+
     if(!get_env("TYPESENSE_SSL_REFRESH_INTERVAL_SECONDS").empty()) {
         this->ssl_refresh_interval_seconds = std::stoi(get_env("TYPESENSE_SSL_REFRESH_INTERVAL_SECONDS"));
     }
@@ -401,6 +433,34 @@ void Config::load_config_file(cmdline::parser& options) {
         this->healthy_write_lag = (size_t) reader.GetInteger("server", "healthy-write-lag", 100);
     }
 
+    if(reader.Exists("server", "write-batch-window-us")) {
+        this->write_batch_window_us = (int) reader.GetInteger("server", "write-batch-window-us", 0);
+    }
+
+    if(reader.Exists("server", "shard-nodes")) {
+        this->shard_nodes = reader.Get("server", "shard-nodes", "");
+    }
+
+    if(reader.Exists("server", "shard-search-max-hits")) {
+        this->shard_search_max_hits = (int) reader.GetInteger("server", "shard-search-max-hits", 10000);
+    }
+
+    if(reader.Exists("server", "max-inflight-query-cost")) {
+        this->max_inflight_query_cost = (uint64_t) reader.GetInteger("server", "max-inflight-query-cost", 0);
+    }
+
+    if(reader.Exists("server", "embedding-model-concurrency")) {
+        this->embedding_model_concurrency = (uint32_t) reader.GetInteger("server", "embedding-model-concurrency", 1);
+    }
+
+    if(reader.Exists("server", "query-embedding-cache-mb")) {
+        this->query_embedding_cache_mb = (uint32_t) reader.GetInteger("server", "query-embedding-cache-mb", 64);
+    }
+
+    if(reader.Exists("server", "reference-doc-cache-size")) {
+        this->reference_doc_cache_size = (uint32_t) reader.GetInteger("server", "reference-doc-cache-size", 0);
+    }
+
     if(reader.Exists("server", "log-slow-requests-time-ms")) {
         this->log_slow_requests_time_ms = (int) reader.GetInteger("server", "log-slow-requests-time-ms", -1);
     }
@@ -437,6 +497,10 @@ void Config::load_config_file(cmdline::parser& options) {
         this->thread_pool_size = (int) reader.GetInteger("server", "thread-pool-size", 0);
     }
 
+    if(reader.Exists("server", "num-http-event-loops")) {
+        this->num_http_event_loops = (int) reader.GetInteger("server", "num-http-event-loops", 1);
+    }
+
     if(reader.Exists("server", "ssl-refresh-interval-seconds")) {
         this->ssl_refresh_interval_seconds = (int) reader.GetInteger("server", "ssl-refresh-interval-seconds", 8 * 60 * 60);
     }
@@ -595,6 +659,34 @@ void Config::load_config_cmd_args(cmdline::parser& options)  {
         this->healthy_write_lag = options.get<size_t>("healthy-write-lag");
     }
 
+    if(options.exist("write-batch-window-us")) {
+        this->write_batch_window_us = options.get<uint32_t>("write-batch-window-us");
+    }
+
+    if(options.exist("shard-nodes")) {
+        this->shard_nodes = options.get<std::string>("shard-nodes");
+    }
+
+    if(options.exist("shard-search-max-hits")) {
+        this->shard_search_max_hits = options.get<uint32_t>("shard-search-max-hits");
+    }
+
+    if(options.exist("max-inflight-query-cost")) {
+        this->max_inflight_query_cost = options.get<uint64_t>("max-inflight-query-cost");
+    }
+
+    if(options.exist("embedding-model-concurrency")) {
+        this->embedding_model_concurrency = options.get<uint32_t>("embedding-model-concurrency");
+    }
+
+    if(options.exist("query-embedding-cache-mb")) {
+        this->query_embedding_cache_mb = options.get<uint32_t>("query-embedding-cache-mb");
+    }
+
+    if(options.exist("reference-doc-cache-size")) {
+        this->reference_doc_cache_size = options.get<uint32_t>("reference-doc-cache-size");
+    }
+
     if(options.exist("log-slow-requests-time-ms")) {
         this->log_slow_requests_time_ms = options.get<int>("log-slow-requests-time-ms");
     }
@@ -631,6 +723,10 @@ void Config::load_config_cmd_args(cmdline::parser& options)  {
         this->thread_pool_size = options.get<uint32_t>("thread-pool-size");
     }
 
+    if(options.exist("num-http-event-loops")) {
+        this->num_http_event_loops = options.get<uint32_t>("num-http-event-loops");
+    }
+
     if(options.exist("ssl-refresh-interval-seconds")) {
         this->ssl_refresh_interval_seconds = options.get<uint32_t>("ssl-refresh-interval-seconds");
     }
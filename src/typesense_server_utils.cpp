@@ -19,6 +19,8 @@
 
 #include "core_api.h"
 #include "ratelimit_manager.h"
+#include "query_admission.h"
+#include "query_embedding_cache.h"
 #include "embedder_manager.h"
 #include "typesense_server_utils.h"
 #include "threadpool.h"
@@ -26,6 +28,7 @@
 #include "conversation_manager.h"
 #include "vq_model_manager.h"
 #include "stemmer_manager.h"
+#include "shard_search.h"
 
 #ifndef ASAN_BUILD
 #include "jemalloc.h"
@@ -92,12 +95,20 @@ void init_cmdline_options(cmdline::parser & options, int argc, char **argv) {
     options.add<int>("snapshot-max-byte-count-per-rpc", '\0', "Maximum snapshot file size in bytes transferred for each RPC.", false, 4194304);
     options.add<size_t>("healthy-read-lag", '\0', "Reads are rejected if the updates lag behind this threshold.", false, 1000);
     options.add<size_t>("healthy-write-lag", '\0', "Writes are rejected if the updates lag behind this threshold.", false, 500);
+    options.add<uint32_t>("write-batch-window-us", '\0', "When > 0, concurrent single document writes arriving within this window are replicated as one log entry.", false, 0);
+    options.add<std::string>("shard-nodes", '\0', "Comma separated base URLs of the other shards of a partitioned cluster, e.g. http://10.0.0.2:8108. Searches are fanned out to them and merged. Documents must be written to the shard that holds them.", false, "");
+    options.add<uint32_t>("shard-search-max-hits", '\0', "Max number of hits up to which a search across shards can page, since every shard returns all the hits up to the requested page.", false, 10000);
+    options.add<uint64_t>("max-inflight-query-cost", '\0', "When > 0, searches are queued or shed once the estimated cost of in-flight searches exceeds this budget. The cost is roughly the number of documents a search has to scan.", false, 0);
+    options.add<uint32_t>("embedding-model-concurrency", '\0', "Number of inferences that each local embedding model runs in parallel. The model is loaded once and shared by all of them.", false, 1);
+    options.add<uint32_t>("query-embedding-cache-mb", '\0', "Memory budget of the cache of search query embeddings, shared by all collections. Set to 0 to disable the cache.", false, 64);
+    options.add<uint32_t>("reference-doc-cache-size", '\0', "Number of referenced documents, pruned to the fields included through a join, that are cached per collection. Set to 0 to disable the cache.", false, 0);
     options.add<int>("log-slow-requests-time-ms", '\0', "When >= 0, requests that take longer than this duration are logged.", false, -1);
 
     options.add<uint32_t>("num-collections-parallel-load", '\0', "Number of collections that are loaded in parallel during start up.", false, 4);
     options.add<uint32_t>("num-documents-parallel-load", '\0', "Number of documents per collection that are indexed in parallel during start up.", false, 1000);
 
     options.add<uint32_t>("thread-pool-size", '\0', "Number of threads used for handling concurrent requests.", false, 4);
+    options.add<uint32_t>("num-http-event-loops", '\0', "Number of event loops that accept and serve HTTP connections.", false, 1);
 
     options.add<std::string>("log-dir", '\0', "Path to the log directory.", false, "");
 
@@ -414,6 +425,8 @@ int run_server(const Config & config, const std::string & version, void (*master
     ThreadPool app_thread_pool(num_threads);
     ThreadPool server_thread_pool(num_threads);
     ThreadPool replication_thread_pool(num_threads);
+    ThreadPool search_thread_pool(num_threads);
+    ThreadPool shard_search_thread_pool(num_threads);
 
     // primary DB used for storing the documents: we will not use WAL since Raft provides that
     Store store(db_dir, 24*60*60, 1024, true);
@@ -456,7 +469,8 @@ int run_server(const Config & config, const std::string & version, void (*master
         config.get_ssl_refresh_interval_seconds() * 1000,
         config.get_enable_cors(),
         config.get_cors_domains(),
-        &server_thread_pool
+        &server_thread_pool,
+        std::max<size_t>(1, config.get_num_http_event_loops())
     );
 
     server->set_auth_handler(handle_authentication);
@@ -473,6 +487,8 @@ int run_server(const Config & config, const std::string & version, void (*master
     CollectionManager & collectionManager = CollectionManager::get_instance();
     collectionManager.init(&store, &app_thread_pool, config.get_max_memory_ratio(),
                            config.get_api_key(), quit_raft_service, config.get_filter_by_max_ops());
+    collectionManager.set_search_thread_pool(&search_thread_pool);
+    ShardSearch::set_thread_pool(&shard_search_thread_pool);
 
     StopwordsManager& stopwordsManager = StopwordsManager::get_instance();
     stopwordsManager.init(&store);
@@ -487,7 +503,11 @@ int run_server(const Config & config, const std::string & version, void (*master
         LOG(INFO) << "Failed to initialize rate limit manager: " << rate_limit_manager_init.error();
     }
 
+    QueryAdmission::get_instance().init(config.get_max_inflight_query_cost());
+
     EmbedderManager::set_model_dir(config.get_data_dir() + "/models");
+    EmbedderManager::set_model_concurrency(config.get_embedding_model_concurrency());
+    QueryEmbeddingCache::get_instance().init(size_t(config.get_query_embedding_cache_mb()) * 1024 * 1024);
 
     EmbedderManager::get_instance().migrate_public_models();
 
@@ -507,7 +527,8 @@ int run_server(const Config & config, const std::string & version, void (*master
     }
 
     std::thread raft_thread([&replication_state, &store, &config, &state_dir,
-                             &app_thread_pool, &server_thread_pool, &replication_thread_pool, batch_indexer]() {
+                             &app_thread_pool, &server_thread_pool, &replication_thread_pool,
+                             &search_thread_pool, &shard_search_thread_pool, batch_indexer]() {
 
         std::thread batch_indexing_thread([batch_indexer]() {
             batch_indexer->run();
@@ -565,6 +586,14 @@ int run_server(const Config & config, const std::string & version, void (*master
 
         server_thread_pool.shutdown();
 
+        LOG(INFO) << "Shutting down search_thread_pool.";
+
+        search_thread_pool.shutdown();
+
+        LOG(INFO) << "Shutting down shard_search_thread_pool.";
+
+        shard_search_thread_pool.shutdown();
+
         LOG(INFO) << "Shutting down app_thread_pool.";
 
         app_thread_pool.shutdown();
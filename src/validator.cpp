@@ -105,6 +105,23 @@ Option<uint32_t> validator_t::coerce_element(const field& a_field, nlohmann::jso
             return Option<uint32_t>(200);
         }
 
+        if(a_field.type == field_types::FLOAT_ARRAY && a_field.multi_vector) {
+            for(const auto& vector: doc_ele) {
+                if(!vector.is_array() || vector.size() != a_field.num_dim) {
+                    return Option<uint32_t>(400, "Field `" + a_field.name + "` must be an array of vectors of " +
+                                            std::to_string(a_field.num_dim)  + " dimensions.");
+                }
+
+                for(const auto& value: vector) {
+                    if(!value.is_number()) {
+                        return Option<uint32_t>(400, "Field `" + a_field.name + "` must contain only float values.");
+                    }
+                }
+            }
+
+            return Option<uint32_t>(200);
+        }
+
         if(a_field.type == field_types::FLOAT_ARRAY && a_field.num_dim != 0 && a_field.num_dim != doc_ele.size()) {
             return Option<uint32_t>(400, "Field `" + a_field.name + "` must have " +
                                     std::to_string(a_field.num_dim)  + " dimensions.");
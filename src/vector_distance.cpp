@@ -0,0 +1,193 @@
+#include "vector_distance.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define VECTOR_DISTANCE_SSE
+#define VECTOR_DISTANCE_AVX
+#elif defined(__aarch64__)
+#include <sse2neon.h>
+#define VECTOR_DISTANCE_SSE
+#endif
+
+// hnswlib sums the products of the leading dimensions in 4 interleaved partial sums when it's built with SSE, and
+// picks the number of those dimensions based on the dimension of the space (see `InnerProductSpace`).
+size_t VectorDistance::get_num_simd_dims(size_t dim) {
+#if defined(__SSE__) && !defined(NO_MANUAL_VECTORIZATION)
+    if(dim % 4 == 0) {
+        return dim;
+    }
+
+    if(dim > 16) {
+        return dim / 16 * 16;
+    }
+
+    if(dim > 4) {
+        return dim / 4 * 4;
+    }
+#endif
+
+    return 0;
+}
+
+// Every lane computes: 1 - ((((p[0] + p[4] + ...) + (p[1] + p[5] + ...)) + (p[2] + ...)) + (p[3] + ...) + tail),
+// where the `tail` sums the products of the remaining dimensions one by one.
+static void inner_product_distances_scalar(const float* query, const float* block, size_t dim, size_t simd_dims,
+                                           float* distances) {
+    for(size_t lane = 0; lane < VectorDistance::BLOCK_SIZE; lane++) {
+        float sums[4] = {0, 0, 0, 0};
+        for(size_t i = 0; i < simd_dims; i++) {
+            sums[i % 4] += query[i] * block[i * VectorDistance::BLOCK_SIZE + lane];
+        }
+
+        float tail = 0;
+        for(size_t i = simd_dims; i < dim; i++) {
+            tail += query[i] * block[i * VectorDistance::BLOCK_SIZE + lane];
+        }
+
+        distances[lane] = 1.0f - ((((sums[0] + sums[1]) + sums[2]) + sums[3]) + tail);
+    }
+}
+
+#if defined(VECTOR_DISTANCE_SSE)
+static void inner_product_distances_sse(const float* query, const float* block, size_t dim, size_t simd_dims,
+                                        float* distances) {
+    constexpr size_t NUM_REGS = VectorDistance::BLOCK_SIZE / 4;
+
+    __m128 sums[4][NUM_REGS];
+    __m128 tails[NUM_REGS];
+
+    for(size_t r = 0; r < NUM_REGS; r++) {
+        sums[0][r] = sums[1][r] = sums[2][r] = sums[3][r] = tails[r] = _mm_set1_ps(0);
+    }
+
+    for(size_t i = 0; i < simd_dims; i++) {
+        const __m128 q = _mm_set1_ps(query[i]);
+        const float* values = block + i * VectorDistance::BLOCK_SIZE;
+        for(size_t r = 0; r < NUM_REGS; r++) {
+            sums[i % 4][r] = _mm_add_ps(sums[i % 4][r], _mm_mul_ps(q, _mm_loadu_ps(values + r * 4)));
+        }
+    }
+
+    for(size_t i = simd_dims; i < dim; i++) {
+        const __m128 q = _mm_set1_ps(query[i]);
+        const float* values = block + i * VectorDistance::BLOCK_SIZE;
+        for(size_t r = 0; r < NUM_REGS; r++) {
+            tails[r] = _mm_add_ps(tails[r], _mm_mul_ps(q, _mm_loadu_ps(values + r * 4)));
+        }
+    }
+
+    const __m128 ones = _mm_set1_ps(1.0f);
+    for(size_t r = 0; r < NUM_REGS; r++) {
+        __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(sums[0][r], sums[1][r]), sums[2][r]), sums[3][r]);
+        _mm_storeu_ps(distances + r * 4, _mm_sub_ps(ones, _mm_add_ps(sum, tails[r])));
+    }
+}
+#endif
+
+#if defined(VECTOR_DISTANCE_AVX)
+__attribute__((target("avx2")))
+static void inner_product_distances_avx2(const float* query, const float* block, size_t dim, size_t simd_dims,
+                                         float* distances) {
+    constexpr size_t NUM_REGS = VectorDistance::BLOCK_SIZE / 8;
+
+    __m256 sums[4][NUM_REGS];
+    __m256 tails[NUM_REGS];
+
+    for(size_t r = 0; r < NUM_REGS; r++) {
+        sums[0][r] = sums[1][r] = sums[2][r] = sums[3][r] = tails[r] = _mm256_setzero_ps();
+    }
+
+    for(size_t i = 0; i < simd_dims; i++) {
+        const __m256 q = _mm256_set1_ps(query[i]);
+        const float* values = block + i * VectorDistance::BLOCK_SIZE;
+        for(size_t r = 0; r < NUM_REGS; r++) {
+            sums[i % 4][r] = _mm256_add_ps(sums[i % 4][r], _mm256_mul_ps(q, _mm256_loadu_ps(values + r * 8)));
+        }
+    }
+
+    for(size_t i = simd_dims; i < dim; i++) {
+        const __m256 q = _mm256_set1_ps(query[i]);
+        const float* values = block + i * VectorDistance::BLOCK_SIZE;
+        for(size_t r = 0; r < NUM_REGS; r++) {
+            tails[r] = _mm256_add_ps(tails[r], _mm256_mul_ps(q, _mm256_loadu_ps(values + r * 8)));
+        }
+    }
+
+    const __m256 ones = _mm256_set1_ps(1.0f);
+    for(size_t r = 0; r < NUM_REGS; r++) {
+        __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(sums[0][r], sums[1][r]), sums[2][r]), sums[3][r]);
+        _mm256_storeu_ps(distances + r * 8, _mm256_sub_ps(ones, _mm256_add_ps(sum, tails[r])));
+    }
+}
+
+// AVX-512 comes with fused multiply-adds, so the explicitly rounded operations keep the compiler from contracting
+// the products and sums, which would round differently from hnswlib.
+__attribute__((target("avx512f")))
+static void inner_product_distances_avx512(const float* query, const float* block, size_t dim, size_t simd_dims,
+                                           float* distances) {
+    static_assert(VectorDistance::BLOCK_SIZE == 16, "A block must fit a single AVX-512 register.");
+    constexpr int ROUNDING = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+    __m512 sums[4];
+    sums[0] = sums[1] = sums[2] = sums[3] = _mm512_setzero_ps();
+    __m512 tail = _mm512_setzero_ps();
+
+    for(size_t i = 0; i < simd_dims; i++) {
+        const __m512 product = _mm512_mul_round_ps(_mm512_set1_ps(query[i]),
+                                                   _mm512_loadu_ps(block + i * VectorDistance::BLOCK_SIZE), ROUNDING);
+        sums[i % 4] = _mm512_add_round_ps(sums[i % 4], product, ROUNDING);
+    }
+
+    for(size_t i = simd_dims; i < dim; i++) {
+        const __m512 product = _mm512_mul_round_ps(_mm512_set1_ps(query[i]),
+                                                   _mm512_loadu_ps(block + i * VectorDistance::BLOCK_SIZE), ROUNDING);
+        tail = _mm512_add_round_ps(tail, product, ROUNDING);
+    }
+
+    __m512 sum = _mm512_add_round_ps(sums[0], sums[1], ROUNDING);
+    sum = _mm512_add_round_ps(sum, sums[2], ROUNDING);
+    sum = _mm512_add_round_ps(sum, sums[3], ROUNDING);
+    sum = _mm512_add_round_ps(sum, tail, ROUNDING);
+
+    _mm512_storeu_ps(distances, _mm512_sub_round_ps(_mm512_set1_ps(1.0f), sum, ROUNDING));
+}
+#endif
+
+VectorDistance::kernel_t VectorDistance::get_supported_kernel() {
+#if defined(VECTOR_DISTANCE_AVX)
+    static const kernel_t supported_kernel = __builtin_cpu_supports("avx512f") ? avx512 :
+                                             __builtin_cpu_supports("avx2") ? avx2 : sse;
+    return supported_kernel;
+#elif defined(VECTOR_DISTANCE_SSE)
+    return sse;
+#else
+    return scalar;
+#endif
+}
+
+void VectorDistance::inner_product_distances(const float* query, const float* block, size_t dim, float* distances) {
+    inner_product_distances(get_supported_kernel(), query, block, dim, distances);
+}
+
+void VectorDistance::inner_product_distances(kernel_t kernel, const float* query, const float* block, size_t dim,
+                                             float* distances) {
+    const size_t simd_dims = get_num_simd_dims(dim);
+
+    switch(kernel) {
+#if defined(VECTOR_DISTANCE_AVX)
+        case avx512:
+            inner_product_distances_avx512(query, block, dim, simd_dims, distances);
+            return;
+        case avx2:
+            inner_product_distances_avx2(query, block, dim, simd_dims, distances);
+            return;
+#endif
+#if defined(VECTOR_DISTANCE_SSE)
+        case sse:
+            inner_product_distances_sse(query, block, dim, simd_dims, distances);
+            return;
+#endif
+        default:
+            inner_product_distances_scalar(query, block, dim, simd_dims, distances);
+    }
+}
@@ -134,6 +134,20 @@ Option<bool> VectorQueryOps::parse_vector_query_str(const std::string& vector_qu
                     }
 
                     for(auto& fvalue: document[vector_query.field_name]) {
+                        if(fvalue.is_array()) {
+                            // all the vectors of a multi-vector field make up the query
+                            for(auto& vector_value: fvalue) {
+                                if(!vector_value.is_number()) {
+                                    return Option<bool>(400, "Document referenced in vector query does not contain "
+                                                             "a valid vector field.");
+                                }
+
+                                vector_query.values.push_back(vector_value.get<float>());
+                            }
+
+                            continue;
+                        }
+
                         if(!fvalue.is_number()) {
                             return Option<bool>(400, "Document referenced in vector query does not contain a valid "
                                                      "vector field.");
@@ -161,6 +175,7 @@ Option<bool> VectorQueryOps::parse_vector_query_str(const std::string& vector_qu
                     }
 
                     vector_query.flat_search_cutoff = std::stoi(param_kv[1]);
+                    vector_query.flat_search_cutoff_given = true;
                 }
 
                 if(param_kv[0] == "distance_threshold") {
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include "batched_indexer.h"
+
+class BatchedIndexerTest : public ::testing::Test {
+protected:
+    Store *store;
+    Store *meta_store;
+    std::atomic<bool> skip_writes = false;
+
+    virtual void SetUp() {
+        std::string state_dir_path = "/tmp/typesense_test/batched_indexer";
+        LOG(INFO) << "Truncating and creating: " << state_dir_path;
+        system(("rm -rf "+state_dir_path+" && mkdir -p "+state_dir_path+"/db "+state_dir_path+"/meta").c_str());
+
+        store = new Store(state_dir_path + "/db");
+        meta_store = new Store(state_dir_path + "/meta");
+    }
+
+    virtual void TearDown() {
+        delete store;
+        delete meta_store;
+    }
+};
+
+TEST_F(BatchedIndexerTest, IndexedLogIndex) {
+    BatchedIndexer batched_indexer(nullptr, store, meta_store, 1, Config::get_instance(), skip_writes);
+    ASSERT_EQ(0, batched_indexer.get_indexed_log_index());
+
+    // entries without anything to index, like configuration entries, move the indexed log index forward
+    batched_indexer.set_applied_log_index(5);
+    ASSERT_EQ(5, batched_indexer.get_indexed_log_index());
+
+    batched_indexer.set_applied_log_index(3);
+    ASSERT_EQ(5, batched_indexer.get_indexed_log_index());
+
+    // a request with chunks still to arrive holds back the indexed log index
+    auto req = std::make_shared<http_req>();
+    req->start_ts = 100;
+    req->log_index = 6;
+    req->body = "{}";
+    batched_indexer.enqueue(req, std::make_shared<http_res>(nullptr));
+
+    batched_indexer.set_applied_log_index(8);
+    ASSERT_EQ(5, batched_indexer.get_indexed_log_index());
+}
+
+TEST_F(BatchedIndexerTest, WaitOnIndexedLogIndex) {
+    BatchedIndexer batched_indexer(nullptr, store, meta_store, 1, Config::get_instance(), skip_writes);
+    batched_indexer.set_applied_log_index(5);
+
+    std::vector<std::pair<int64_t, bool>> callbacks;
+    auto on_indexed = [&callbacks](int64_t log_index) {
+        return [&callbacks, log_index](bool indexed) {
+            callbacks.emplace_back(log_index, indexed);
+        };
+    };
+
+    // called back right away when already indexed
+    batched_indexer.on_indexed_log_index(4, 10000, on_indexed(4));
+    ASSERT_EQ(std::vector<std::pair<int64_t, bool>>({{4, true}}), callbacks);
+
+    // the calling thread is not blocked while the log index is not indexed
+    callbacks.clear();
+    batched_indexer.on_indexed_log_index(7, 10000, on_indexed(7));
+    batched_indexer.on_indexed_log_index(9, 10000, on_indexed(9));
+    ASSERT_TRUE(callbacks.empty());
+
+    batched_indexer.set_applied_log_index(8);
+    ASSERT_EQ(std::vector<std::pair<int64_t, bool>>({{7, true}}), callbacks);
+
+    // a pending request holds back the waits beyond it
+    auto req = std::make_shared<http_req>();
+    req->start_ts = 100;
+    req->log_index = 9;
+    req->body = "{}";
+    batched_indexer.enqueue(req, std::make_shared<http_res>(nullptr));
+    batched_indexer.set_applied_log_index(10);
+    ASSERT_EQ(1, callbacks.size());
+
+    // waits are timed out once their time elapses
+    callbacks.clear();
+    batched_indexer.on_indexed_log_index(10, 10, on_indexed(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    batched_indexer.expire_indexed_waits();
+    ASSERT_EQ(std::vector<std::pair<int64_t, bool>>({{10, false}}), callbacks);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "bm25.h"
+
+TEST(BM25Test, FieldLengthStats) {
+    field_length_stats_t stats;
+    ASSERT_EQ(0, stats.num_docs());
+    ASSERT_FLOAT_EQ(0, stats.avg_length());
+
+    stats.upsert(0, 4);
+    stats.upsert(1, 8);
+    ASSERT_EQ(2, stats.num_docs());
+    ASSERT_EQ(12, stats.get_total_length());
+    ASSERT_FLOAT_EQ(6, stats.avg_length());
+    ASSERT_EQ(8, stats.get_length(1));
+
+    // update of an existing document must replace its previous length
+    stats.upsert(1, 2);
+    ASSERT_EQ(2, stats.num_docs());
+    ASSERT_EQ(6, stats.get_total_length());
+
+    stats.remove(0);
+    stats.remove(100);
+    ASSERT_EQ(1, stats.num_docs());
+    ASSERT_EQ(0, stats.get_length(0));
+    ASSERT_FLOAT_EQ(2, stats.avg_length());
+}
+
+TEST(BM25Test, Scoring) {
+    // rare tokens must have a higher IDF than common tokens, and IDF must never be negative
+    ASSERT_GT(bm25_t::idf(1000, 1), bm25_t::idf(1000, 100));
+    ASSERT_GT(bm25_t::idf(1000, 1000), 0);
+    ASSERT_GT(bm25_t::idf(10, 20), 0);
+
+    // shorter fields get a boost for the same term frequency
+    ASSERT_GT(bm25_t::normalized_tf(1, 2, 4), bm25_t::normalized_tf(1, 8, 4));
+    ASSERT_FLOAT_EQ(1, bm25_t::normalized_tf(1, 4, 4));
+    ASSERT_FLOAT_EQ(0, bm25_t::normalized_tf(0, 4, 4));
+
+    // term frequency saturates
+    float idf = bm25_t::idf(100, 10);
+    ASSERT_GT(bm25_t::token_score(idf, 2), bm25_t::token_score(idf, 1));
+    ASSERT_LT(bm25_t::token_score(idf, 1000), idf * (bm25_t::K1 + 1));
+    ASSERT_FLOAT_EQ(0, bm25_t::token_score(idf, 0));
+
+    // a token found in almost every document of a large collection still yields a non-zero score
+    float common_idf = bm25_t::idf(10*1000*1000, 10*1000*1000 - 1);
+    ASSERT_EQ(0, int64_t(bm25_t::token_score(common_idf, 1) * bm25_t::SCORE_SCALE));
+    ASSERT_EQ(1, bm25_t::scaled_score(bm25_t::token_score(common_idf, 1)));
+    ASSERT_EQ(150000, bm25_t::scaled_score(1.5f));
+    ASSERT_EQ((int64_t(1) << 56) - 1, bm25_t::scaled_score(1e20f));
+}
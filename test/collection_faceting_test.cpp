@@ -3614,3 +3614,364 @@ TEST_F(CollectionFacetingTest, IgnoreMissingFacetByFields) {
     ASSERT_EQ(1, res["hits"].size());
     ASSERT_EQ(0, res["facet_counts"].size());
 }
+
+TEST_F(CollectionFacetingTest, DenseFacetCounts) {
+    nlohmann::json schema = R"({
+            "name": "coll1",
+            "fields": [
+                {"name": "brands", "type": "string[]", "facet": true},
+                {"name": "price", "type": "int64", "facet": true},
+                {"name": "in_stock", "type": "bool"}
+            ]
+        })"_json;
+
+    Collection* coll1 = collectionManager.create_collection(schema).get();
+
+    std::map<std::string, size_t> brand_counts, in_stock_brand_counts;
+    int64_t price_sum = 0;
+
+    for(size_t i = 0; i < 2000; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        // same value may appear twice in the array, but should be counted only once
+        doc["brands"] = {"brand_" + std::to_string(i % 50), "brand_" + std::to_string(i % 7)};
+        doc["price"] = int64_t(i % 20) * 1000000000LL;
+        doc["in_stock"] = (i % 3 == 0);
+
+        std::set<std::string> unique_brands(doc["brands"].begin(), doc["brands"].end());
+        for(const auto& brand: unique_brands) {
+            brand_counts[brand]++;
+            if(i % 3 == 0) {
+                in_stock_brand_counts[brand]++;
+            }
+        }
+
+        price_sum += doc["price"].get<int64_t>();
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    std::vector<size_t> expected_counts;
+    for(const auto& kv: brand_counts) {
+        expected_counts.push_back(kv.second);
+    }
+    std::sort(expected_counts.begin(), expected_counts.end(), std::greater<>());
+
+    auto results = coll1->search("*", {}, "", {"brands", "price"}, {}, {0}, 10, 1,
+                                 token_ordering::FREQUENCY, {true}, 10, spp::sparse_hash_set<std::string>(),
+                                 spp::sparse_hash_set<std::string>(), 5, "", 30UL, 4UL,
+                                 "", 1UL, "", "", {}, 3UL, "<mark>", "</mark>", {},
+                                 4294967295UL, true, false, true, "", false, 6000000UL, 4UL,
+                                 7UL, fallback, 4UL, {off}, 32767UL, 32767UL, 2UL, 2UL, false,
+                                 "", true, 0UL, max_score, 100UL, 0UL, 4294967295UL, "exhaustive").get();
+
+    ASSERT_EQ(2000, results["found"].get<size_t>());
+    ASSERT_EQ(2, results["facet_counts"].size());
+
+    ASSERT_EQ("brands", results["facet_counts"][0]["field_name"]);
+    ASSERT_EQ(5, results["facet_counts"][0]["counts"].size());
+
+    // distinct values are counted beyond the top values that are returned
+    ASSERT_EQ(brand_counts.size(), results["facet_counts"][0]["stats"]["total_values"].get<size_t>());
+
+    for(size_t i = 0; i < 5; i++) {
+        const auto& facet_count = results["facet_counts"][0]["counts"][i];
+        ASSERT_EQ(expected_counts[i], facet_count["count"].get<size_t>());
+        ASSERT_EQ(brand_counts[facet_count["value"].get<std::string>()], facet_count["count"].get<size_t>());
+    }
+
+    ASSERT_EQ("price", results["facet_counts"][1]["field_name"]);
+    ASSERT_EQ(5, results["facet_counts"][1]["counts"].size());
+    ASSERT_EQ(100, results["facet_counts"][1]["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ(20, results["facet_counts"][1]["stats"]["total_values"].get<size_t>());
+    ASSERT_EQ(0, results["facet_counts"][1]["stats"]["min"].get<int64_t>());
+    ASSERT_EQ(19000000000LL, results["facet_counts"][1]["stats"]["max"].get<int64_t>());
+    ASSERT_DOUBLE_EQ(price_sum, results["facet_counts"][1]["stats"]["sum"].get<double>());
+
+    // filtered result set
+    results = coll1->search("*", {}, "in_stock: true", {"brands"}, {}, {0}, 10, 1,
+                            token_ordering::FREQUENCY, {true}, 10, spp::sparse_hash_set<std::string>(),
+                            spp::sparse_hash_set<std::string>(), 5, "", 30UL, 4UL,
+                            "", 1UL, "", "", {}, 3UL, "<mark>", "</mark>", {},
+                            4294967295UL, true, false, true, "", false, 6000000UL, 4UL,
+                            7UL, fallback, 4UL, {off}, 32767UL, 32767UL, 2UL, 2UL, false,
+                            "", true, 0UL, max_score, 100UL, 0UL, 4294967295UL, "exhaustive").get();
+
+    ASSERT_EQ(667, results["found"].get<size_t>());
+    ASSERT_EQ(5, results["facet_counts"][0]["counts"].size());
+    ASSERT_EQ(in_stock_brand_counts.size(), results["facet_counts"][0]["stats"]["total_values"].get<size_t>());
+
+    for(size_t i = 0; i < 5; i++) {
+        const auto& facet_count = results["facet_counts"][0]["counts"][i];
+        ASSERT_EQ(in_stock_brand_counts[facet_count["value"].get<std::string>()],
+                  facet_count["count"].get<size_t>());
+    }
+}
+
+TEST_F(CollectionFacetingTest, DenseFacetCountsWithPinnedHits) {
+    nlohmann::json schema = R"({
+            "name": "coll1",
+            "fields": [
+                {"name": "category", "type": "string", "facet": true}
+            ]
+        })"_json;
+
+    Collection* coll1 = collectionManager.create_collection(schema).get();
+
+    // a: 700, b: 600, c: 602, d: 98
+    for(size_t i = 0; i < 2000; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["category"] = (i < 700) ? "a" : (i < 1300) ? "b" : (i < 1902) ? "c" : "d";
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    // without the pinned hits, `c` falls below `b` and out of the top 2 values, but the pinned hits are counted
+    // afterwards and must be added to its full count
+    auto results = coll1->search("*", {}, "", {"category"}, {}, {0}, 10, 1,
+                                 token_ordering::FREQUENCY, {true}, 10, spp::sparse_hash_set<std::string>(),
+                                 spp::sparse_hash_set<std::string>(), 2, "", 30UL, 4UL,
+                                 "", 1UL, "1300:1,1301:2,1302:3", "", {}, 3UL, "<mark>", "</mark>", {},
+                                 4294967295UL, true, false, true, "", false, 6000000UL, 4UL,
+                                 7UL, fallback, 4UL, {off}, 32767UL, 32767UL, 2UL, 2UL, false,
+                                 "", true, 0UL, max_score, 100UL, 0UL, 4294967295UL, "exhaustive").get();
+
+    ASSERT_EQ(2000, results["found"].get<size_t>());
+    ASSERT_EQ("1300", results["hits"][0]["document"]["id"].get<std::string>());
+
+    ASSERT_EQ(2, results["facet_counts"][0]["counts"].size());
+    ASSERT_EQ("a", results["facet_counts"][0]["counts"][0]["value"].get<std::string>());
+    ASSERT_EQ(700, results["facet_counts"][0]["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ("c", results["facet_counts"][0]["counts"][1]["value"].get<std::string>());
+    ASSERT_EQ(602, results["facet_counts"][0]["counts"][1]["count"].get<size_t>());
+}
+
+TEST_F(CollectionFacetingTest, MaterializedFacetCountsFollowWrites) {
+    nlohmann::json schema = R"({
+            "name": "coll1",
+            "fields": [
+                {"name": "category", "type": "string", "facet": true},
+                {"name": "in_stock", "type": "bool"}
+            ]
+        })"_json;
+
+    Collection* coll1 = collectionManager.create_collection(schema).get();
+
+    for(size_t i = 0; i < 10; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["category"] = (i % 2 == 0) ? "shoes" : "shirts";
+        doc["in_stock"] = (i < 6);
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    auto get_counts = [&](const std::string& filter_by) {
+        auto res = coll1->search("*", {}, filter_by, {"category"}, {}, {0}, 10, 1, FREQUENCY, {true}).get();
+        std::map<std::string, size_t> counts;
+        for(const auto& facet_count: res["facet_counts"][0]["counts"]) {
+            counts[facet_count["value"].get<std::string>()] = facet_count["count"].get<size_t>();
+        }
+        return counts;
+    };
+
+    // repeated queries are served from the materialized counts
+    for(size_t i = 0; i < 2; i++) {
+        auto counts = get_counts("");
+        ASSERT_EQ(5, counts["shoes"]);
+        ASSERT_EQ(5, counts["shirts"]);
+
+        counts = get_counts("in_stock: true");
+        ASSERT_EQ(3, counts["shoes"]);
+        ASSERT_EQ(3, counts["shirts"]);
+    }
+
+    nlohmann::json doc;
+    doc["id"] = "10";
+    doc["category"] = "hats";
+    doc["in_stock"] = true;
+    ASSERT_TRUE(coll1->add(doc.dump()).ok());
+
+    ASSERT_TRUE(coll1->remove("0").ok());
+
+    // an update that only changes the filtered field must be reflected as well
+    ASSERT_TRUE(coll1->add(R"({"id": "1", "in_stock": false})", UPDATE).ok());
+
+    auto counts = get_counts("");
+    ASSERT_EQ(4, counts["shoes"]);
+    ASSERT_EQ(5, counts["shirts"]);
+    ASSERT_EQ(1, counts["hats"]);
+
+    counts = get_counts("in_stock: true");
+    ASSERT_EQ(2, counts["shoes"]);
+    ASSERT_EQ(2, counts["shirts"]);
+    ASSERT_EQ(1, counts["hats"]);
+}
+
+TEST_F(CollectionFacetingTest, SketchFacetCounts) {
+    nlohmann::json schema = R"({
+            "name": "coll1",
+            "fields": [
+                {"name": "brand", "type": "string", "facet": true},
+                {"name": "in_stock", "type": "bool"}
+            ]
+        })"_json;
+
+    Collection* coll1 = collectionManager.create_collection(schema).get();
+
+    std::map<std::string, size_t> in_stock_brand_counts;
+
+    for(size_t i = 0; i < 2000; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["brand"] = "brand_" + std::to_string(i % 2);
+        doc["in_stock"] = (i % 3 == 0);
+
+        if(i % 3 == 0) {
+            in_stock_brand_counts[doc["brand"].get<std::string>()]++;
+        }
+
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    // counts of an unfiltered wildcard query are exact
+    auto results = coll1->search("*", {}, "", {"brand"}, {}, {0}, 10, 1,
+                                 token_ordering::FREQUENCY, {true}, 10, spp::sparse_hash_set<std::string>(),
+                                 spp::sparse_hash_set<std::string>(), 10, "", 30UL, 4UL,
+                                 "", 1UL, "", "", {}, 3UL, "<mark>", "</mark>", {},
+                                 4294967295UL, true, false, true, "", false, 6000000UL, 4UL,
+                                 7UL, fallback, 4UL, {off}, 32767UL, 32767UL, 2UL, 2UL, false,
+                                 "", true, 0UL, max_score, 100UL, 0UL, 4294967295UL, "sketch").get();
+
+    ASSERT_EQ(1, results["facet_counts"].size());
+    ASSERT_TRUE(results["facet_counts"][0]["sampled"].get<bool>());
+    ASSERT_EQ(2, results["facet_counts"][0]["counts"].size());
+
+    for(const auto& facet_count: results["facet_counts"][0]["counts"]) {
+        ASSERT_EQ(1000, facet_count["count"].get<size_t>());
+        ASSERT_EQ(1000, facet_count["count_lower"].get<size_t>());
+        ASSERT_EQ(1000, facet_count["count_upper"].get<size_t>());
+    }
+
+    results = coll1->search("*", {}, "in_stock: true", {"brand"}, {}, {0}, 10, 1,
+                            token_ordering::FREQUENCY, {true}, 10, spp::sparse_hash_set<std::string>(),
+                            spp::sparse_hash_set<std::string>(), 10, "", 30UL, 4UL,
+                            "", 1UL, "", "", {}, 3UL, "<mark>", "</mark>", {},
+                            4294967295UL, true, false, true, "", false, 6000000UL, 4UL,
+                            7UL, fallback, 4UL, {off}, 32767UL, 32767UL, 2UL, 2UL, false,
+                            "", true, 0UL, max_score, 100UL, 0UL, 4294967295UL, "sketch").get();
+
+    ASSERT_EQ(667, results["found"].get<size_t>());
+    ASSERT_EQ(2, results["facet_counts"][0]["counts"].size());
+
+    for(const auto& facet_count: results["facet_counts"][0]["counts"]) {
+        const auto expected_count = in_stock_brand_counts[facet_count["value"].get<std::string>()];
+        ASSERT_LE(facet_count["count_lower"].get<size_t>(), expected_count);
+        ASSERT_GE(facet_count["count_upper"].get<size_t>(), expected_count);
+        ASSERT_LE(facet_count["count_lower"].get<size_t>(), facet_count["count"].get<size_t>());
+        ASSERT_GE(facet_count["count_upper"].get<size_t>(), facet_count["count"].get<size_t>());
+    }
+
+    // exhaustive counts don't carry bounds
+    results = coll1->search("*", {}, "in_stock: true", {"brand"}, {}, {0}, 10, 1,
+                            token_ordering::FREQUENCY, {true}, 10, spp::sparse_hash_set<std::string>(),
+                            spp::sparse_hash_set<std::string>(), 10, "", 30UL, 4UL,
+                            "", 1UL, "", "", {}, 3UL, "<mark>", "</mark>", {},
+                            4294967295UL, true, false, true, "", false, 6000000UL, 4UL,
+                            7UL, fallback, 4UL, {off}, 32767UL, 32767UL, 2UL, 2UL, false,
+                            "", true, 0UL, max_score, 100UL, 0UL, 4294967295UL, "exhaustive").get();
+
+    ASSERT_EQ(0, results["facet_counts"][0]["counts"][0].count("count_lower"));
+
+    collectionManager.drop_collection("coll1");
+}
+
+TEST_F(CollectionFacetingTest, DisjunctiveFacetCounts) {
+    nlohmann::json schema = R"({
+            "name": "coll1",
+            "fields": [
+                {"name": "brand", "type": "string", "facet": true},
+                {"name": "category", "type": "string", "facet": true}
+            ]
+        })"_json;
+
+    Collection* coll1 = collectionManager.create_collection(schema).get();
+
+    // brand_i x category_j, with brand_i appearing i+1 times in each category
+    size_t doc_id = 0;
+    for(size_t i = 0; i < 3; i++) {
+        for(const std::string category: {"shoes", "shirts"}) {
+            for(size_t j = 0; j <= i; j++) {
+                nlohmann::json doc;
+                doc["id"] = std::to_string(doc_id++);
+                doc["brand"] = "brand_" + std::to_string(i);
+                doc["category"] = category;
+                ASSERT_TRUE(coll1->add(doc.dump()).ok());
+            }
+        }
+    }
+
+    auto do_search = [&](const std::string& q, const std::string& filter_by, nlohmann::json& res_obj) {
+        std::map<std::string, std::string> req_params = {
+                {"collection", "coll1"},
+                {"q", q},
+                {"query_by", "brand"},
+                {"filter_by", filter_by},
+                {"facet_by", "brand,category"},
+                {"disjunctive_facets", "brand"}
+        };
+        nlohmann::json embedded_params;
+        std::string json_res;
+        auto now_ts = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+
+        auto search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+        if(search_op.ok()) {
+            res_obj = nlohmann::json::parse(json_res);
+        }
+        return search_op;
+    };
+
+    auto get_counts = [](const nlohmann::json& facet_counts) {
+        std::map<std::string, size_t> counts;
+        for(const auto& facet_count: facet_counts["counts"]) {
+            counts[facet_count["value"].get<std::string>()] = facet_count["count"].get<size_t>();
+        }
+        return counts;
+    };
+
+    nlohmann::json res_obj;
+    ASSERT_TRUE(do_search("*", "brand:= brand_1 && category:= shoes", res_obj).ok());
+    ASSERT_EQ(2, res_obj["found"].get<size_t>());
+
+    // brand counts ignore the clause on brand, while category counts respect it
+    auto brand_counts = get_counts(res_obj["facet_counts"][0]);
+    ASSERT_EQ(3, brand_counts.size());
+    ASSERT_EQ(1, brand_counts["brand_0"]);
+    ASSERT_EQ(2, brand_counts["brand_1"]);
+    ASSERT_EQ(3, brand_counts["brand_2"]);
+
+    auto category_counts = get_counts(res_obj["facet_counts"][1]);
+    ASSERT_EQ(2, category_counts.size());
+    ASSERT_EQ(2, category_counts["shoes"]);
+    ASSERT_EQ(2, category_counts["shirts"]);
+
+    // an OR of brands is also relaxed
+    ASSERT_TRUE(do_search("*", "(brand:= brand_0 || brand:= brand_2) && category:= shirts", res_obj).ok());
+    ASSERT_EQ(4, res_obj["found"].get<size_t>());
+    brand_counts = get_counts(res_obj["facet_counts"][0]);
+    ASSERT_EQ(3, brand_counts.size());
+    ASSERT_EQ(2, brand_counts["brand_1"]);
+
+    // counts are returned even when the whole filter matches nothing
+    ASSERT_TRUE(do_search("*", "brand:= brand_3 && category:= shoes", res_obj).ok());
+    ASSERT_EQ(0, res_obj["found"].get<size_t>());
+    brand_counts = get_counts(res_obj["facet_counts"][0]);
+    ASSERT_EQ(3, brand_counts.size());
+    ASSERT_EQ(3, brand_counts["brand_2"]);
+
+    auto search_op = do_search("brand_1", "category:= shoes", res_obj);
+    ASSERT_FALSE(search_op.ok());
+    ASSERT_EQ(400, search_op.code());
+    ASSERT_EQ("Disjunctive facets are supported only for wildcard queries.", search_op.error());
+
+    collectionManager.drop_collection("coll1");
+}
@@ -1487,4 +1487,50 @@ TEST_F(CollectionGroupingTest, GroupByPerPage) {
     ASSERT_EQ("1004", res["grouped_hits"][2]["group_key"][0]);
     ASSERT_EQ("1003", res["grouped_hits"][3]["group_key"][0]);
     ASSERT_EQ("1001", res["grouped_hits"][4]["group_key"][0]);
-}
\ No newline at end of file
+}
+
+TEST_F(CollectionGroupingTest, GroupingAcrossManyThreads) {
+    std::vector<field> fields = {
+            field("brand", field_types::STRING, true),
+            field("points", field_types::INT32, false),
+    };
+
+    Collection* coll1 = collectionManager.create_collection("coll1", 1, fields, "points").get();
+
+    for(size_t i = 0; i < 2000; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["brand"] = "brand_" + std::to_string(i % 97);
+        doc["points"] = i;
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    std::vector<sort_by> sort_fields = {sort_by("points", "DESC")};
+
+    // groups are spread across the documents scored by every thread
+    auto res = coll1->search("*", {}, "", {}, sort_fields, {0}, 10, 1, FREQUENCY,
+                             {false}, Index::DROP_TOKENS_THRESHOLD,
+                             spp::sparse_hash_set<std::string>(),
+                             spp::sparse_hash_set<std::string>(), 10, "", 30, 5,
+                             "", 10,
+                             {}, {}, {"brand"}, 3).get();
+
+    ASSERT_EQ(2000, res["found_docs"].get<size_t>());
+    ASSERT_EQ(97, res["found"].get<size_t>());
+    ASSERT_EQ(10, res["grouped_hits"].size());
+
+    for(size_t i = 0; i < 10; i++) {
+        const auto& group = res["grouped_hits"][i];
+        const size_t remainder = (1999 - i) % 97;
+
+        ASSERT_EQ("brand_" + std::to_string(remainder), group["group_key"][0].get<std::string>());
+        ASSERT_EQ(remainder <= 59 ? 21 : 20, group["found"].get<size_t>());
+        ASSERT_EQ(3, group["hits"].size());
+
+        for(size_t j = 0; j < 3; j++) {
+            ASSERT_EQ(1999 - i - (j * 97), group["hits"][j]["document"]["points"].get<size_t>());
+        }
+    }
+
+    collectionManager.drop_collection("coll1");
+}
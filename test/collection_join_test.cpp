@@ -9108,3 +9108,112 @@ TEST_F(CollectionJoinTest, NegateLeftJoinOneToMany) {
     ASSERT_EQ("comb", res_obj["hits"][0]["document"]["product_name"]);
     ASSERT_EQ(0, res_obj["hits"][0]["document"].count("User_Views"));
 }
+
+TEST_F(CollectionJoinTest, IncludeReferencesFromCache) {
+    Config::get_instance().set_reference_doc_cache_size(100);
+
+    auto schema_json =
+            R"({
+                "name": "Brands",
+                "fields": [
+                    {"name": "name", "type": "string"},
+                    {"name": "country", "type": "string"}
+                ]
+            })"_json;
+    std::vector<nlohmann::json> documents = {
+            R"({"id": "0", "name": "Nike", "country": "USA"})"_json,
+            R"({"id": "1", "name": "Adidas", "country": "Germany"})"_json
+    };
+    auto collection_create_op = collectionManager.create_collection(schema_json);
+    ASSERT_TRUE(collection_create_op.ok());
+    auto brands = collection_create_op.get();
+    for (auto const &json: documents) {
+        auto add_op = brands->add(json.dump());
+        ASSERT_TRUE(add_op.ok());
+    }
+
+    schema_json =
+            R"({
+                "name": "Products",
+                "fields": [
+                    {"name": "title", "type": "string"},
+                    {"name": "brand_id", "type": "string", "reference": "Brands.id"}
+                ]
+            })"_json;
+    documents = {
+            R"({"id": "0", "title": "Running shoes", "brand_id": "0"})"_json,
+            R"({"id": "1", "title": "Football", "brand_id": "1"})"_json,
+            R"({"id": "2", "title": "Socks", "brand_id": "0"})"_json,
+            R"({"id": "3", "title": "Jersey", "brand_id": "1"})"_json
+    };
+    collection_create_op = collectionManager.create_collection(schema_json);
+    ASSERT_TRUE(collection_create_op.ok());
+    for (auto const &json: documents) {
+        auto add_op = collection_create_op.get()->add(json.dump());
+        ASSERT_TRUE(add_op.ok());
+    }
+
+    std::map<std::string, std::string> req_params = {
+            {"collection", "Products"},
+            {"q", "*"},
+            {"filter_by", "$Brands(id: *)"},
+            {"include_fields", "title, $Brands(name)"},
+    };
+    nlohmann::json embedded_params;
+    std::string json_res;
+    auto now_ts = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+    auto search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+
+    auto res_obj = nlohmann::json::parse(json_res);
+    ASSERT_EQ(4, res_obj["found"]);
+    ASSERT_EQ("Jersey", res_obj["hits"][0]["document"]["title"]);
+    ASSERT_EQ("Adidas", res_obj["hits"][0]["document"]["name"]);
+    ASSERT_EQ(0, res_obj["hits"][0]["document"].count("country"));
+    ASSERT_EQ("Socks", res_obj["hits"][1]["document"]["title"]);
+    ASSERT_EQ("Nike", res_obj["hits"][1]["document"]["name"]);
+
+    // Every brand is fetched once per request, the repeated references are served from the request's documents.
+    auto& ref_doc_cache = brands->get_reference_doc_cache();
+    uint64_t hits, misses;
+    ref_doc_cache.get_stats(hits, misses);
+    ASSERT_EQ(2, ref_doc_cache.size());
+    ASSERT_EQ(0, hits);
+    ASSERT_EQ(2, misses);
+
+    search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+    ASSERT_EQ(res_obj["hits"], nlohmann::json::parse(json_res)["hits"]);
+
+    ref_doc_cache.get_stats(hits, misses);
+    ASSERT_EQ(2, hits);
+    ASSERT_EQ(2, misses);
+
+    // Different fields of the referenced documents are cached separately.
+    req_params["include_fields"] = "title, $Brands(country)";
+    search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+
+    res_obj = nlohmann::json::parse(json_res);
+    ASSERT_EQ("Germany", res_obj["hits"][0]["document"]["country"]);
+    ASSERT_EQ(0, res_obj["hits"][0]["document"].count("name"));
+    ASSERT_EQ(4, ref_doc_cache.size());
+
+    // An update drops the cached documents of the brand.
+    auto update_op = brands->add(R"({"id": "1", "name": "Adidas Originals"})"_json.dump(), UPDATE);
+    ASSERT_TRUE(update_op.ok());
+    ASSERT_EQ(2, ref_doc_cache.size());
+
+    req_params["include_fields"] = "title, $Brands(name)";
+    search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+
+    res_obj = nlohmann::json::parse(json_res);
+    ASSERT_EQ("Adidas Originals", res_obj["hits"][0]["document"]["name"]);
+    ASSERT_EQ("Nike", res_obj["hits"][1]["document"]["name"]);
+    ASSERT_EQ(3, ref_doc_cache.size());
+
+    Config::get_instance().set_reference_doc_cache_size(0);
+}
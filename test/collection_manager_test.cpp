@@ -1262,6 +1262,59 @@ TEST_F(CollectionManagerTest, LoadMultipleCollections) {
     delete new_store;
 }
 
+TEST_F(CollectionManagerTest, BuildCollectionsAndSwapThemIn) {
+    std::vector<Collection*> built_collections;
+
+    // `collection1` has a reference field, so it can't be built aside
+    auto build_op = collectionManager.build_collections(store, 8, 1000, built_collections);
+    ASSERT_FALSE(build_op.ok());
+    ASSERT_EQ(400, build_op.code());
+    ASSERT_TRUE(built_collections.empty());
+
+    collectionManager.drop_collection("collection1");
+
+    nlohmann::json coll_schema = R"({
+        "name": "coll1",
+        "fields": [
+            {"name": "title", "type": "string"},
+            {"name": "points", "type": "int32"}
+        ]
+    })"_json;
+
+    auto create_op = collectionManager.create_collection(coll_schema);
+    ASSERT_TRUE(create_op.ok());
+    Collection* live_coll = create_op.get();
+
+    for(size_t i = 0; i < 10; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["points"] = i;
+        ASSERT_TRUE(live_coll->add(doc.dump()).ok());
+    }
+
+    build_op = collectionManager.build_collections(store, 8, 1000, built_collections);
+    ASSERT_TRUE(build_op.ok());
+    ASSERT_EQ(1, built_collections.size());
+
+    // built collection is not visible until it is swapped in
+    Collection* built_coll = built_collections[0];
+    ASSERT_NE(live_coll, built_coll);
+    ASSERT_EQ(live_coll, collectionManager.get_collection("coll1").get());
+    ASSERT_EQ(10, built_coll->get_num_documents());
+
+    auto load_op = collectionManager.load(8, 1000, &built_collections);
+    ASSERT_TRUE(load_op.ok());
+    ASSERT_TRUE(built_collections.empty());
+    ASSERT_EQ(built_coll, collectionManager.get_collection("coll1").get());
+    ASSERT_EQ(1, collectionManager.get_collections().get().size());
+
+    auto results = built_coll->search("title", {"title"}, "", {}, {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    ASSERT_EQ(10, results["found"].get<size_t>());
+
+    collectionManager.drop_collection("coll1");
+}
+
 TEST_F(CollectionManagerTest, ParseSortByClause) {
     std::vector<sort_by> sort_fields;
     bool sort_by_parsed = CollectionManager::parse_sort_by_str("points:desc,loc(24.56,10.45):ASC", sort_fields);
@@ -3535,3 +3535,105 @@ TEST_F(CollectionSpecificMoreTest, ReloadStemmingDictionaryOnRestart) {
 
     collectionManager.drop_collection("coll1");
 }
+
+TEST_F(CollectionSpecificMoreTest, BM25TextMatchTypeShouldPreferRareTokens) {
+    nlohmann::json schema = R"({
+            "name": "coll1",
+            "fields": [
+                {"name": "title", "type": "string", "bm25": true},
+                {"name": "category", "type": "string", "optional": true}
+            ]
+        })"_json;
+
+    Collection *coll1 = collectionManager.create_collection(schema).get();
+
+    nlohmann::json doc;
+    doc["id"] = "0";
+    doc["title"] = "the the the fox";
+    ASSERT_TRUE(coll1->add(doc.dump()).ok());
+
+    doc["id"] = "1";
+    doc["title"] = "the fox fox fox";
+    ASSERT_TRUE(coll1->add(doc.dump()).ok());
+
+    for(size_t i = 2; i < 10; i++) {
+        doc["id"] = std::to_string(i);
+        doc["title"] = "the cat " + std::to_string(i);
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    auto res = coll1->search("the fox", {"title"}, "", {}, {}, {0}, 10, 1, FREQUENCY, {false}, 0,
+                             spp::sparse_hash_set<std::string>(),
+                             spp::sparse_hash_set<std::string>(), 10, "", 30, 4, "", 20, {}, {}, {}, 0,
+                             "<mark>", "</mark>", {}, 1000, true, false, true, "", false, 6000 * 1000, 4, 7, fallback,
+                             4, {off}, 0, 0, 0, 2, false, "", true, 0, bm25).get();
+
+    ASSERT_EQ(2, res["hits"].size());
+    ASSERT_EQ("1", res["hits"][0]["document"]["id"].get<std::string>());
+    ASSERT_EQ("0", res["hits"][1]["document"]["id"].get<std::string>());
+
+    ASSERT_EQ(2, res["hits"][0]["text_match_info"]["tokens_matched"].get<size_t>());
+    ASSERT_TRUE(res["hits"][0]["text_match_info"]["bm25_score"].get<float>() >
+                res["hits"][1]["text_match_info"]["bm25_score"].get<float>());
+
+    // field lengths are tracked for BM25 normalization and must be cleaned up on delete
+    auto field_lengths = coll1->_get_index()->_get_field_length_stats("title");
+    ASSERT_NE(nullptr, field_lengths);
+    ASSERT_EQ(10, field_lengths->num_docs());
+    ASSERT_EQ(4, field_lengths->get_length(1));
+
+    ASSERT_TRUE(coll1->remove("1").ok());
+    ASSERT_EQ(9, field_lengths->num_docs());
+    ASSERT_EQ(0, field_lengths->get_length(1));
+
+    // lengths are not tracked for fields without the `bm25` property
+    ASSERT_EQ(nullptr, coll1->_get_index()->_get_field_length_stats("category"));
+    ASSERT_TRUE(coll1->get_summary_json()["fields"][0]["bm25"].get<bool>());
+    ASSERT_EQ(0, coll1->get_summary_json()["fields"][1].count("bm25"));
+
+    schema = R"({
+            "name": "coll2",
+            "fields": [
+                {"name": "points", "type": "int32", "bm25": true}
+            ]
+        })"_json;
+
+    auto create_op = collectionManager.create_collection(schema);
+    ASSERT_FALSE(create_op.ok());
+    ASSERT_EQ("The `bm25` property is only allowed for string and string[] fields.", create_op.error());
+
+    collectionManager.drop_collection("coll1");
+}
+
+TEST_F(CollectionSpecificMoreTest, SnippetOfLongTextFromMatchedTokenOffsets) {
+    nlohmann::json schema = R"({
+            "name": "coll1",
+            "fields": [
+                {"name": "title", "type": "string"}
+            ]
+        })"_json;
+
+    Collection *coll1 = collectionManager.create_collection(schema).get();
+
+    std::string title;
+    for(size_t i = 0; i < 300; i++) {
+        if(i == 10) {
+            title += "-- ";
+        }
+
+        title += (i == 200) ? "quartz " : (i == 201) ? "crystal, " : "word" + std::to_string(i) + " ";
+    }
+
+    nlohmann::json doc;
+    doc["id"] = "0";
+    doc["title"] = title;
+    ASSERT_TRUE(coll1->add(doc.dump()).ok());
+
+    auto res = coll1->search("quartz crystal", {"title"}, "", {}, {}, {0}).get();
+
+    ASSERT_EQ(1, res["hits"].size());
+    ASSERT_EQ("word196 word197 word198 word199 <mark>quartz</mark> <mark>crystal</mark>, word202 word203 word204 word205",
+              res["hits"][0]["highlight"]["title"]["snippet"].get<std::string>());
+
+    collectionManager.drop_collection("coll1");
+}
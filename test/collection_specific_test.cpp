@@ -3,6 +3,7 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <thread>
 #include <collection_manager.h>
 #include "collection.h"
 
@@ -3107,4 +3108,162 @@ TEST_F(CollectionSpecificTest, ExactMatchWithoutClosingSymbol) {
     ASSERT_EQ("Taj Mahal", result["hits"][0]["document"]["title"]);
     ASSERT_EQ("1", result["hits"][1]["document"]["id"]);
     ASSERT_EQ("Mahabalipuram", result["hits"][1]["document"]["title"]);
-}
\ No newline at end of file
+}
+TEST_F(CollectionSpecificTest, ImportManyLinesWithBadAndRepeatedDocs) {
+    std::vector<field> fields = {field("title", field_types::STRING, false),
+                                 field("points", field_types::INT32, false),};
+
+    Collection* coll1 = collectionManager.create_collection("coll1", 1, fields, "points").get();
+
+    // spans multiple parse windows, so that lines are parsed ahead on multiple threads
+    std::vector<std::string> import_records;
+    for(size_t i = 0; i < 2500; i++) {
+        nlohmann::json doc;
+        doc["id"] = (i == 1500) ? "1499" : std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["points"] = i;
+        import_records.push_back(doc.dump());
+    }
+
+    import_records[10] = R"({"id": "10", "title": )";
+
+    nlohmann::json document;
+    nlohmann::json import_response = coll1->add_many(import_records, document);
+
+    ASSERT_FALSE(import_response["success"].get<bool>());
+    ASSERT_EQ(2498, import_response["num_imported"].get<int>());
+    ASSERT_EQ(2498, coll1->get_num_documents());
+
+    ASSERT_TRUE(nlohmann::json::parse(import_records[9])["success"].get<bool>());
+    ASSERT_FALSE(nlohmann::json::parse(import_records[10])["success"].get<bool>());
+    ASSERT_EQ(0, nlohmann::json::parse(import_records[10])["error"].get<std::string>().find("Bad JSON"));
+
+    ASSERT_TRUE(nlohmann::json::parse(import_records[1499])["success"].get<bool>());
+    ASSERT_FALSE(nlohmann::json::parse(import_records[1500])["success"].get<bool>());
+    ASSERT_EQ("A document with id 1499 already exists.",
+              nlohmann::json::parse(import_records[1500])["error"].get<std::string>());
+    ASSERT_TRUE(nlohmann::json::parse(import_records[2499])["success"].get<bool>());
+
+    auto doc_op = coll1->get("2499");
+    ASSERT_TRUE(doc_op.ok());
+    ASSERT_EQ("Title 2499", doc_op.get()["title"].get<std::string>());
+
+    collectionManager.drop_collection("coll1");
+}
+
+TEST_F(CollectionSpecificTest, UpsertLargeBatch) {
+    std::vector<field> fields = {field("title", field_types::STRING, false),
+                                 field("category", field_types::STRING, true),
+                                 field("points", field_types::INT32, false),};
+
+    Collection* coll1 = collectionManager.create_collection("coll1", 1, fields, "points").get();
+
+    std::vector<std::string> import_records;
+    for(size_t i = 0; i < 800; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["category"] = (i % 2 == 0) ? "even" : "odd";
+        doc["points"] = i;
+        import_records.push_back(doc.dump());
+    }
+
+    const size_t num_records = import_records.size();
+
+    nlohmann::json document;
+    nlohmann::json import_response = coll1->add_many(import_records, document, UPSERT);
+    ASSERT_TRUE(import_response["success"].get<bool>());
+    ASSERT_EQ(num_records, coll1->get_num_documents());
+
+    // upsert every document again, changing its category
+    import_records.clear();
+    for(size_t i = 0; i < num_records; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["category"] = "all";
+        doc["points"] = i;
+        import_records.push_back(doc.dump());
+    }
+
+    import_response = coll1->add_many(import_records, document, UPSERT);
+    ASSERT_TRUE(import_response["success"].get<bool>());
+    ASSERT_EQ(num_records, coll1->get_num_documents());
+
+    auto results = coll1->search("title", {"title"}, "", {"category"}, {}, {0}, 10, 1, FREQUENCY, {true}).get();
+    ASSERT_EQ(num_records, results["found"].get<size_t>());
+    ASSERT_EQ(1, results["facet_counts"][0]["counts"].size());
+    ASSERT_EQ("all", results["facet_counts"][0]["counts"][0]["value"]);
+    ASSERT_EQ(num_records, results["facet_counts"][0]["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ(std::to_string(num_records - 1), results["hits"][0]["document"]["id"]);
+
+    collectionManager.drop_collection("coll1");
+}
+
+TEST_F(CollectionSpecificTest, SearchWhileImportingFromManyThreads) {
+    std::vector<field> fields = {field("title", field_types::STRING, false),
+                                 field("points", field_types::INT32, false),};
+
+    Collection* coll1 = collectionManager.create_collection("coll1", 1, fields, "points").get();
+
+    const size_t num_threads = 4;
+    const size_t num_batches = 5;
+    const size_t batch_size = 100;
+
+    // imports are serialized on the collection lock, and searches in between never see fewer documents
+    std::vector<std::thread> import_threads;
+    std::atomic<size_t> num_failed_imports = 0;
+    std::atomic<size_t> num_finished_threads = 0;
+
+    for(size_t thread_id = 0; thread_id < num_threads; thread_id++) {
+        import_threads.emplace_back([&, thread_id]() {
+            for(size_t batch = 0; batch < num_batches; batch++) {
+                std::vector<std::string> import_records;
+                for(size_t i = 0; i < batch_size; i++) {
+                    const size_t id = (thread_id * num_batches + batch) * batch_size + i;
+                    nlohmann::json doc;
+                    doc["id"] = std::to_string(id);
+                    doc["title"] = "Title " + std::to_string(id);
+                    doc["points"] = id;
+                    import_records.push_back(doc.dump());
+                }
+
+                nlohmann::json document;
+                nlohmann::json import_response = coll1->add_many(import_records, document, UPSERT);
+                if(!import_response["success"].get<bool>()) {
+                    num_failed_imports++;
+                }
+            }
+
+            num_finished_threads++;
+        });
+    }
+
+    size_t num_searches = 0;
+    size_t prev_found = 0;
+    bool found_decreased = false;
+
+    while(num_searches < 50 || num_finished_threads < num_threads) {
+        auto results = coll1->search("title", {"title"}, "", {}, {}, {0}, 10, 1, FREQUENCY, {true}).get();
+        const size_t found = results["found"].get<size_t>();
+        found_decreased = found_decreased || (found < prev_found);
+        prev_found = found;
+        num_searches++;
+    }
+
+    for(auto& import_thread: import_threads) {
+        import_thread.join();
+    }
+
+    ASSERT_EQ(0, num_failed_imports.load());
+    ASSERT_FALSE(found_decreased);
+
+    const size_t num_records = num_threads * num_batches * batch_size;
+    ASSERT_EQ(num_records, coll1->get_num_documents());
+
+    auto results = coll1->search("title", {"title"}, "", {}, {}, {0}, 10, 1, FREQUENCY, {true}).get();
+    ASSERT_EQ(num_records, results["found"].get<size_t>());
+    ASSERT_EQ(std::to_string(num_records - 1), results["hits"][0]["document"]["id"]);
+
+    collectionManager.drop_collection("coll1");
+}
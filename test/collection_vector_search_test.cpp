@@ -5,6 +5,7 @@
 #include "collection.h"
 #include <cstdlib>
 #include <ctime>
+#include <thread>
 #include "conversation_manager.h"
 #include "conversation_model_manager.h"
 #include "index.h"
@@ -68,6 +69,7 @@ protected:
     virtual void TearDown() {
         collectionManager.dispose();
         EmbedderManager::get_instance().delete_all_text_embedders();
+        EmbedderManager::set_model_concurrency(1);
         delete store;
     }
 };
@@ -5416,4 +5418,219 @@ TEST_F(CollectionVectorTest, UpdateEmbeddings) {
     for (size_t i = 0; i < add_values.size(); ++i) {
         ASSERT_NEAR(add_values[i], update_values[i], 0.0001);
     }
-}
\ No newline at end of file
+}
+
+TEST_F(CollectionVectorTest, ConcurrentQueryEmbeddingsAreBatched) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "text", "type": "string"},
+                    {"name": "embedding", "type": "float[]", "embed": {"from": ["text"], "model_config": {"model_name": "ts/e5-small"}}}
+                ]
+                })"_json;
+
+    EmbedderManager::set_model_dir("/tmp/typesense_test/models");
+    EmbedderManager::set_model_concurrency(2);
+
+    auto collection_create_op = collectionManager.create_collection(schema);
+    ASSERT_TRUE(collection_create_op.ok());
+
+    nlohmann::json model_config = R"({
+        "model_name": "ts/e5-small"
+    })"_json;
+
+    auto embedder = EmbedderManager::get_instance().get_text_embedder(model_config).get();
+
+    std::vector<std::string> texts = {"butter", "butterfly", "a slice of bread", "peanut butter and jelly"};
+    std::vector<std::vector<float>> expected_embeddings;
+    for(const auto& text: texts) {
+        auto embedding_res = embedder->Embed(text);
+        ASSERT_TRUE(embedding_res.success);
+        expected_embeddings.push_back(embedding_res.embedding);
+    }
+
+    // concurrent calls are coalesced into batches, and must get back the same embeddings as when run alone
+    const size_t num_threads = 16;
+    std::vector<embedding_res_t> embedding_results(num_threads);
+    std::vector<std::thread> threads;
+
+    for(size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&, i]() {
+            embedding_results[i] = embedder->Embed(texts[i % texts.size()]);
+        });
+    }
+
+    for(auto& thread: threads) {
+        thread.join();
+    }
+
+    for(size_t i = 0; i < num_threads; i++) {
+        ASSERT_TRUE(embedding_results[i].success);
+        const auto& expected_embedding = expected_embeddings[i % texts.size()];
+        ASSERT_EQ(expected_embedding.size(), embedding_results[i].embedding.size());
+        for(size_t j = 0; j < expected_embedding.size(); j++) {
+            ASSERT_NEAR(expected_embedding[j], embedding_results[i].embedding[j], 0.001);
+        }
+    }
+}
+
+TEST_F(CollectionVectorTest, FilteredVectorSearchAdaptsToSelectivity) {
+    nlohmann::json schema = R"({
+        "name": "coll1",
+        "fields": [
+            {"name": "bucket", "type": "int32"},
+            {"name": "even", "type": "bool"},
+            {"name": "vec", "type": "float[]", "num_dim": 8}
+        ]
+    })"_json;
+
+    Collection* coll1 = collectionManager.create_collection(schema).get();
+
+    std::mt19937 rng;
+    rng.seed(47);
+    std::uniform_real_distribution<> distrib;
+
+    std::vector<std::string> json_lines;
+    for (size_t i = 0; i < 2000; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["bucket"] = i % 100;
+        doc["even"] = (i % 2 == 0);
+
+        std::vector<float> values;
+        for(size_t j = 0; j < 8; j++) {
+            values.push_back(distrib(rng));
+        }
+        doc["vec"] = values;
+
+        json_lines.push_back(doc.dump());
+    }
+
+    nlohmann::json insert_doc;
+    auto res = coll1->add_many(json_lines, insert_doc, UPSERT);
+    ASSERT_TRUE(res["success"].get<bool>());
+
+    auto vector_search = [&](const std::string& filter_by, const std::string& vector_query) {
+        return coll1->search("*", {}, filter_by, {}, {}, {0}, 10, 1, FREQUENCY, {true}, Index::DROP_TOKENS_THRESHOLD,
+                             spp::sparse_hash_set<std::string>(),
+                             spp::sparse_hash_set<std::string>(), 10, "", 30, 5,
+                             "", 10, {}, {}, {}, 0,
+                             "<mark>", "</mark>", {}, 1000, true, false, true, "", false, 6000 * 1000, 4, 7,
+                             fallback,
+                             4, {off}, 32767, 32767, 2,
+                             false, true, vector_query).get();
+    };
+
+    const std::string query_vec = "[0.96826, 0.94, 0.39557, 0.306488, 0.1, 0.2, 0.3, 0.4]";
+
+    // a selective filter is scanned, so the nearest hits are exact
+    auto results = vector_search("bucket: 7", "vec:(" + query_vec + ")");
+    auto flat_results = vector_search("bucket: 7", "vec:(" + query_vec + ", flat_search_cutoff: 1000000)");
+
+    ASSERT_EQ(10, results["found"].get<size_t>());
+    ASSERT_EQ(20, flat_results["found"].get<size_t>());
+    ASSERT_EQ(10, results["hits"].size());
+
+    for(size_t i = 0; i < results["hits"].size(); i++) {
+        ASSERT_EQ(flat_results["hits"][i]["document"]["id"], results["hits"][i]["document"]["id"]);
+        ASSERT_FLOAT_EQ(flat_results["hits"][i]["vector_distance"].get<float>(),
+                        results["hits"][i]["vector_distance"].get<float>());
+    }
+
+    // a broad filter goes through the graph
+    results = vector_search("even: true", "vec:(" + query_vec + ")");
+    ASSERT_EQ(10, results["found"].get<size_t>());
+    for(const auto& hit: results["hits"]) {
+        ASSERT_TRUE(hit["document"]["even"].get<bool>());
+    }
+
+    flat_results = vector_search("even: true", "vec:(" + query_vec + ", flat_search_cutoff: 1000000)");
+    ASSERT_EQ(1000, flat_results["found"].get<size_t>());
+    ASSERT_EQ(flat_results["hits"][0]["document"]["id"], results["hits"][0]["document"]["id"]);
+}
+
+TEST_F(CollectionVectorTest, MultiVectorFieldScoredByMaxSim) {
+    nlohmann::json schema = R"({
+        "name": "coll1",
+        "fields": [
+            {"name": "title", "type": "string", "multi_vector": true}
+        ]
+    })"_json;
+
+    auto coll_op = collectionManager.create_collection(schema);
+    ASSERT_FALSE(coll_op.ok());
+    ASSERT_EQ("Property `multi_vector` is only allowed on a vector field.", coll_op.error());
+
+    schema = R"({
+        "name": "coll1",
+        "fields": [
+            {"name": "points", "type": "int32"},
+            {"name": "passages", "type": "float[]", "num_dim": 2, "multi_vector": true}
+        ]
+    })"_json;
+
+    coll_op = collectionManager.create_collection(schema);
+    ASSERT_TRUE(coll_op.ok());
+    Collection* coll1 = coll_op.get();
+
+    ASSERT_TRUE(coll1->get_summary_json()["fields"][1]["multi_vector"].get<bool>());
+
+    auto add_op = coll1->add(R"({"id": "0", "points": 1, "passages": [1, 0]})"_json.dump());
+    ASSERT_FALSE(add_op.ok());
+    ASSERT_EQ("Field `passages` must be an array of vectors of 2 dimensions.", add_op.error());
+
+    ASSERT_TRUE(coll1->add(R"({"id": "0", "points": 1, "passages": [[1, 0], [0, 1]]})"_json.dump()).ok());
+    ASSERT_TRUE(coll1->add(R"({"id": "1", "points": 2, "passages": [[0.6, 0.8]]})"_json.dump()).ok());
+    ASSERT_TRUE(coll1->add(R"({"id": "2", "points": 3, "passages": [[-1, 0], [0, -1]]})"_json.dump()).ok());
+
+    auto vector_search = [&](const std::string& filter_by, const std::string& vector_query) {
+        return coll1->search("*", {}, filter_by, {}, {}, {0}, 10, 1, FREQUENCY, {true}, Index::DROP_TOKENS_THRESHOLD,
+                             spp::sparse_hash_set<std::string>(),
+                             spp::sparse_hash_set<std::string>(), 10, "", 30, 5,
+                             "", 10, {}, {}, {}, 0,
+                             "<mark>", "</mark>", {}, 1000, true, false, true, "", false, 6000 * 1000, 4, 7,
+                             fallback,
+                             4, {off}, 32767, 32767, 2,
+                             false, true, vector_query);
+    };
+
+    auto assert_hits = [&](const nlohmann::json& results, const std::vector<std::pair<std::string, float>>& hits) {
+        ASSERT_EQ(hits.size(), results["hits"].size());
+        for(size_t i = 0; i < hits.size(); i++) {
+            ASSERT_EQ(hits[i].first, results["hits"][i]["document"]["id"].get<std::string>());
+            ASSERT_NEAR(hits[i].second, results["hits"][i]["vector_distance"].get<float>(), 1e-5);
+        }
+    };
+
+    // a document is as near as its nearest vector
+    auto results = vector_search("", "passages:([1, 0])").get();
+    assert_hits(results, {{"0", 0}, {"1", 0.4}, {"2", 1}});
+
+    // every query vector is matched to its nearest vector of the document, and their distances are averaged
+    results = vector_search("", "passages:([1, 0, 0, 1])").get();
+    assert_hits(results, {{"0", 0}, {"1", 0.3}, {"2", 1}});
+
+    // filtered documents are scanned
+    results = vector_search("points: >1", "passages:([1, 0, 0, 1])").get();
+    assert_hits(results, {{"1", 0.3}, {"2", 1}});
+
+    // all the vectors of a document make up the query of a document id
+    results = vector_search("", "passages:([], id: 0)").get();
+    assert_hits(results, {{"1", 0.3}, {"2", 1}});
+
+    auto search_op = vector_search("", "passages:([1, 0, 0])");
+    ASSERT_FALSE(search_op.ok());
+    ASSERT_EQ("Query field `passages` must have a multiple of 2 dimensions.", search_op.error());
+
+    // vectors that are dropped by an update no longer match
+    ASSERT_TRUE(coll1->add(R"({"id": "0", "points": 1, "passages": [[0, 1]]})"_json.dump(), UPSERT).ok());
+    results = vector_search("", "passages:([1, 0])").get();
+    ASSERT_EQ(3, results["found"].get<size_t>());
+    ASSERT_EQ("1", results["hits"][0]["document"]["id"].get<std::string>());
+    ASSERT_NEAR(1, results["hits"][1]["vector_distance"].get<float>(), 1e-5);
+    ASSERT_NEAR(1, results["hits"][2]["vector_distance"].get<float>(), 1e-5);
+
+    ASSERT_TRUE(coll1->remove("1").ok());
+    results = vector_search("", "passages:([1, 0])").get();
+    ASSERT_EQ(2, results["found"].get<size_t>());
+}
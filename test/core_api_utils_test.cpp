@@ -299,6 +299,66 @@ TEST_F(CoreAPIUtilsTest, MultiSearchEmbeddedKeys) {
 
 }
 
+TEST_F(CoreAPIUtilsTest, MultiSearchConcurrently) {
+    nlohmann::json schema = R"({
+        "name": "coll1",
+        "fields": [
+          {"name": "title", "type": "string" },
+          {"name": "points", "type": "int32", "facet": true }
+        ]
+    })"_json;
+
+    auto op = collectionManager.create_collection(schema);
+    ASSERT_TRUE(op.ok());
+    Collection* coll1 = op.get();
+
+    for(size_t i = 0; i < 100; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["points"] = i;
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    ThreadPool search_thread_pool(4);
+    collectionManager.set_search_thread_pool(&search_thread_pool);
+
+    std::shared_ptr<http_req> req = std::make_shared<http_req>();
+    std::shared_ptr<http_res> res = std::make_shared<http_res>(nullptr);
+
+    nlohmann::json body;
+    body["searches"] = nlohmann::json::array();
+
+    for(size_t i = 0; i < 8; i++) {
+        nlohmann::json search;
+        search["collection"] = (i == 5) ? "unknown" : "coll1";
+        search["q"] = "*";
+        search["filter_by"] = "points:<" + std::to_string((i % 4 + 1) * 10);
+        body["searches"].push_back(search);
+        req->embedded_params_vec.emplace_back(nlohmann::json::object());
+    }
+
+    req->body = body.dump();
+    ASSERT_TRUE(post_multi_search(req, res));
+
+    auto results = nlohmann::json::parse(res->body)["results"];
+    ASSERT_EQ(8, results.size());
+
+    // results are in the order of the searches, including identical searches and errors
+    for(size_t i = 0; i < 8; i++) {
+        if(i == 5) {
+            ASSERT_EQ(404, results[i]["code"].get<size_t>());
+            continue;
+        }
+
+        ASSERT_EQ((i % 4 + 1) * 10, results[i]["found"].get<size_t>());
+    }
+
+    collectionManager.set_search_thread_pool(nullptr);
+    search_thread_pool.shutdown();
+    collectionManager.drop_collection("coll1");
+}
+
 TEST_F(CoreAPIUtilsTest, SearchEmbeddedPresetKey) {
     nlohmann::json preset_value = R"(
         {"per_page": 100}
@@ -1305,6 +1365,95 @@ TEST_F(CoreAPIUtilsTest, ExportIncludeExcludeFieldsWithFilter) {
     collectionManager.drop_collection("coll1");
 }
 
+TEST_F(CoreAPIUtilsTest, ExportLargeBatchesInOrder) {
+    nlohmann::json schema = R"({
+        "name": "coll1",
+        "fields": [
+          {"name": "title", "type": "string" },
+          {"name": "points", "type": "int32" }
+        ]
+    })"_json;
+
+    auto op = collectionManager.create_collection(schema);
+    ASSERT_TRUE(op.ok());
+    Collection* coll1 = op.get();
+
+    for(size_t i = 0; i < 300; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["points"] = i;
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    std::shared_ptr<http_req> req = std::make_shared<http_req>();
+    std::shared_ptr<http_res> res = std::make_shared<http_res>(nullptr);
+    req->params["collection"] = "coll1";
+    req->params["batch_size"] = "200";
+
+    // without any projection, stored documents are streamed as they are
+
+    std::vector<std::string> res_strs;
+    ASSERT_TRUE(get_export_documents(req, res));
+    ASSERT_FALSE(res->final.load());
+    ASSERT_EQ('\n', res->body.back());
+    StringUtils::split(res->body, res_strs, "\n");
+
+    ASSERT_TRUE(get_export_documents(req, res));
+    ASSERT_TRUE(res->final.load());
+    ASSERT_EQ('}', res->body.back());
+    StringUtils::split(res->body, res_strs, "\n");
+
+    ASSERT_EQ(300, res_strs.size());
+    for(size_t i = 0; i < res_strs.size(); i++) {
+        auto doc = nlohmann::json::parse(res_strs[i]);
+        ASSERT_EQ(3, doc.size());
+        ASSERT_EQ(std::to_string(i), doc["id"]);
+        ASSERT_EQ(i, doc["points"]);
+    }
+
+    // with include fields
+
+    delete dynamic_cast<export_state_t*>(req->data);
+    req->data = nullptr;
+    res_strs.clear();
+    req->params["include_fields"] = "points";
+    req->params["batch_size"] = "300";
+
+    ASSERT_TRUE(get_export_documents(req, res));
+    ASSERT_TRUE(res->final.load());
+    StringUtils::split(res->body, res_strs, "\n");
+
+    ASSERT_EQ(300, res_strs.size());
+    for(size_t i = 0; i < res_strs.size(); i++) {
+        auto doc = nlohmann::json::parse(res_strs[i]);
+        ASSERT_EQ(1, doc.size());
+        ASSERT_EQ(i, doc["points"]);
+    }
+
+    // with a filter and exclude fields
+
+    delete dynamic_cast<export_state_t*>(req->data);
+    req->data = nullptr;
+    res_strs.clear();
+    req->params.erase("include_fields");
+    req->params["exclude_fields"] = "title";
+    req->params["filter_by"] = "points:>=100";
+
+    ASSERT_TRUE(get_export_documents(req, res));
+    ASSERT_TRUE(res->final.load());
+    StringUtils::split(res->body, res_strs, "\n");
+
+    ASSERT_EQ(200, res_strs.size());
+    for(size_t i = 0; i < res_strs.size(); i++) {
+        auto doc = nlohmann::json::parse(res_strs[i]);
+        ASSERT_EQ(2, doc.size());
+        ASSERT_EQ(std::to_string(i + 100), doc["id"]);
+    }
+
+    collectionManager.drop_collection("coll1");
+}
+
 TEST_F(CoreAPIUtilsTest, TestProxy) {
     std::string res;
     std::unordered_map<std::string, std::string> headers;
@@ -1596,6 +1745,39 @@ TEST_F(CoreAPIUtilsTest, SampleGzipIndexTest) {
     infile.close();
 }
 
+TEST_F(CoreAPIUtilsTest, GzipWithHighCompressionRatio) {
+    // repetitive JSONL inflates to well over 10x of its compressed size
+    std::string jsonl;
+    for(size_t i = 0; i < 20000; i++) {
+        jsonl += R"({"points":1,"title":"DuckDuckGo Settings"})";
+        jsonl += "\n";
+    }
+
+    z_stream zs{};
+    ASSERT_EQ(Z_OK, deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+
+    std::string compressed(deflateBound(&zs, jsonl.size()), '\0');
+    zs.next_in = (Bytef *) jsonl.data();
+    zs.avail_in = jsonl.size();
+    zs.next_out = (Bytef *) &compressed[0];
+    zs.avail_out = compressed.size();
+    ASSERT_EQ(Z_STREAM_END, deflate(&zs, Z_FINISH));
+    compressed.resize(zs.total_out);
+    deflateEnd(&zs);
+
+    ASSERT_GT(jsonl.size(), 10 * compressed.size());
+
+    auto req = std::make_shared<http_req>();
+    req->body = compressed;
+
+    auto res = ReplicationState::handle_gzip(req);
+    ASSERT_TRUE(res.ok());
+    ASSERT_EQ(jsonl.size(), req->body.size());
+    ASSERT_EQ(jsonl, req->body);
+    ASSERT_EQ(jsonl.size(), req->chunk_len);
+    ASSERT_FALSE(req->zstream_initialized);
+}
+
 TEST_F(CoreAPIUtilsTest, TestConversationModels) {
     nlohmann::json model_config = R"({
         "model_name": "openai/gpt-3.5-turbo",
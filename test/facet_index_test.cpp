@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "facet_index.h"
+#include <set>
 
 TEST(FacetIndexTest, FacetValueDeletionString) {
     facet_index_t findex;
@@ -118,3 +119,214 @@ TEST(FacetIndexTest, FacetValueDeletionFloat) {
     findex.remove(doc, pricef, 2);
     ASSERT_FALSE(findex.facet_value_exists("price", "99.95"));
 }
+
+TEST(FacetIndexTest, FacetIdRange) {
+    facet_index_t findex;
+    findex.initialize("brand");
+
+    uint32_t min_facet_id = 0, max_facet_id = 0;
+    ASSERT_FALSE(findex.get_facet_id_range("brand", min_facet_id, max_facet_id));
+    ASSERT_FALSE(findex.get_facet_id_range("unknown", min_facet_id, max_facet_id));
+
+    std::unordered_map<facet_value_id_t, std::vector<uint32_t>, facet_value_id_t::Hash> fvalue_to_seq_ids;
+    std::unordered_map<uint32_t, std::vector<facet_value_id_t>> seq_id_to_fvalues;
+
+    facet_value_id_t nike("nike");
+    facet_value_id_t adidas("adidas");
+    facet_value_id_t puma("puma");
+
+    fvalue_to_seq_ids[nike] = {0, 1};
+    fvalue_to_seq_ids[adidas] = {1};
+    fvalue_to_seq_ids[puma] = {2};
+    seq_id_to_fvalues[0] = {nike};
+    seq_id_to_fvalues[1] = {nike, adidas};
+    seq_id_to_fvalues[2] = {puma};
+
+    findex.insert("brand", fvalue_to_seq_ids, seq_id_to_fvalues, true);
+
+    // facet ids of strings are assigned sequentially
+    ASSERT_TRUE(findex.get_facet_id_range("brand", min_facet_id, max_facet_id));
+    ASSERT_EQ(2, max_facet_id - min_facet_id);
+}
+
+TEST(FacetIndexTest, MaterializedFacetCounts) {
+    facet_index_t findex;
+    findex.initialize("brand");
+
+    std::unordered_map<facet_value_id_t, std::vector<uint32_t>, facet_value_id_t::Hash> fvalue_to_seq_ids;
+    std::unordered_map<uint32_t, std::vector<facet_value_id_t>> seq_id_to_fvalues;
+
+    facet_value_id_t nike("nike");
+    fvalue_to_seq_ids[nike] = {0, 1};
+    seq_id_to_fvalues[0] = {nike};
+    seq_id_to_fvalues[1] = {nike};
+    findex.insert("brand", fvalue_to_seq_ids, seq_id_to_fvalues, true);
+
+    ASSERT_EQ(nullptr, findex.get_facet_counts("brand", "", 2));
+    ASSERT_EQ(nullptr, findex.get_facet_counts("brand", "in_stock: true", 1));
+
+    uint32_t min_facet_id = 0, max_facet_id = 0;
+    ASSERT_TRUE(findex.get_facet_id_range("brand", min_facet_id, max_facet_id));
+    const uint32_t nike_id = min_facet_id;
+
+    auto unfiltered_counts = std::make_shared<facet_counts_t>();
+    unfiltered_counts->counts[nike_id] = 2;
+    findex.set_facet_counts("brand", "", unfiltered_counts);
+
+    auto filtered_counts = std::make_shared<facet_counts_t>();
+    filtered_counts->counts[nike_id] = 1;
+    filtered_counts->num_docs = 1;
+    findex.set_facet_counts("brand", "in_stock: true", filtered_counts);
+
+    ASSERT_EQ(1, findex.get_facet_counts("brand", "in_stock: true", 1)->counts.at(nike_id));
+    // mismatching result set size
+    ASSERT_EQ(nullptr, findex.get_facet_counts("brand", "in_stock: true", 2));
+
+    findex.set_facet_counts("brand", "in_stock: true", filtered_counts);
+    findex.invalidate_filtered_facet_counts();
+    ASSERT_EQ(nullptr, findex.get_facet_counts("brand", "in_stock: true", 1));
+
+    // unfiltered counts are maintained as documents are inserted and removed
+    fvalue_to_seq_ids.clear();
+    seq_id_to_fvalues.clear();
+
+    facet_value_id_t adidas("adidas");
+    fvalue_to_seq_ids[nike] = {2};
+    fvalue_to_seq_ids[adidas] = {2};
+    seq_id_to_fvalues[2] = {nike, adidas, nike};
+    findex.insert("brand", fvalue_to_seq_ids, seq_id_to_fvalues, true);
+
+    auto counts = findex.get_facet_counts("brand", "", 0);
+    ASSERT_NE(nullptr, counts);
+    ASSERT_EQ(2, counts->counts.size());
+    ASSERT_EQ(3, counts->counts.at(nike_id));
+
+    field brandf("brand", field_types::STRING_ARRAY, true);
+    nlohmann::json doc;
+    doc["brand"] = {"nike", "adidas", "nike"};
+    findex.remove(doc, brandf, 2);
+
+    ASSERT_EQ(1, counts->counts.size());
+    ASSERT_EQ(2, counts->counts.at(nike_id));
+}
+
+TEST(FacetIndexTest, EstimateCount) {
+    uint32_t count = 0, count_lower = 0, count_upper = 0;
+
+    // exact when the whole population is sampled
+    facet_index_t::estimate_count(40, 100, 100, count, count_lower, count_upper);
+    ASSERT_EQ(40, count);
+    ASSERT_EQ(40, count_lower);
+    ASSERT_EQ(40, count_upper);
+
+    facet_index_t::estimate_count(128, 256, 1000, count, count_lower, count_upper);
+    ASSERT_EQ(500, count);
+    ASSERT_TRUE(count_lower < 500 && count_lower > 400);
+    ASSERT_TRUE(count_upper > 500 && count_upper < 600);
+
+    // sampled hits and misses are certain
+    facet_index_t::estimate_count(0, 256, 300, count, count_lower, count_upper);
+    ASSERT_EQ(0, count);
+    ASSERT_EQ(0, count_lower);
+    ASSERT_LE(count_upper, 300 - 256);
+}
+
+TEST(FacetIndexTest, SketchStaysUniformAfterRemovals) {
+    facet_index_t::facet_sketch_t sketch;
+    std::set<uint32_t> value_ids;
+
+    for(uint32_t seq_id = 0; seq_id < 1000; seq_id++) {
+        value_ids.insert(seq_id);
+        facet_index_t::add_to_sketch(sketch, seq_id);
+    }
+
+    ASSERT_EQ(facet_index_t::SKETCH_SIZE, sketch.ids.size());
+
+    // leave the sketch below its full size
+    std::vector<uint32_t> removed_ids(sketch.ids.begin(), sketch.ids.begin() + 10);
+    for(const auto seq_id: removed_ids) {
+        value_ids.erase(seq_id);
+        facet_index_t::remove_from_sketch(sketch, seq_id);
+    }
+
+    ASSERT_EQ(facet_index_t::SKETCH_SIZE - 10, sketch.ids.size());
+
+    // newly inserted ids must not be admitted regardless of their hash
+    for(uint32_t seq_id = 1000; seq_id < 5000; seq_id++) {
+        value_ids.insert(seq_id);
+        facet_index_t::add_to_sketch(sketch, seq_id);
+    }
+
+    // the sketch holds exactly the ids of the value with a hash up to its threshold
+    std::set<uint32_t> expected_ids;
+    for(const auto seq_id: value_ids) {
+        if(facet_index_t::sketch_hash(seq_id) <= sketch.max_hash) {
+            expected_ids.insert(seq_id);
+        }
+    }
+
+    ASSERT_EQ(expected_ids, std::set<uint32_t>(sketch.ids.begin(), sketch.ids.end()));
+    ASSERT_LE(sketch.ids.size(), facet_index_t::SKETCH_SIZE);
+}
+
+TEST(FacetIndexTest, EstimateFacetCountsFromSketches) {
+    facet_index_t findex;
+    findex.initialize("brand");
+
+    std::unordered_map<facet_value_id_t, std::vector<uint32_t>, facet_value_id_t::Hash> fvalue_to_seq_ids;
+    std::unordered_map<uint32_t, std::vector<facet_value_id_t>> seq_id_to_fvalues;
+
+    facet_value_id_t nike("nike");
+    facet_value_id_t adidas("adidas");
+
+    for(uint32_t seq_id = 0; seq_id < 5000; seq_id++) {
+        fvalue_to_seq_ids[nike].push_back(seq_id);
+        seq_id_to_fvalues[seq_id] = {nike};
+    }
+
+    for(uint32_t seq_id = 5000; seq_id < 5010; seq_id++) {
+        fvalue_to_seq_ids[adidas].push_back(seq_id);
+        seq_id_to_fvalues[seq_id] = {adidas};
+    }
+
+    findex.insert("brand", fvalue_to_seq_ids, seq_id_to_fvalues, true);
+
+    // every even id is a result
+    std::vector<uint32_t> result_ids;
+    for(uint32_t seq_id = 0; seq_id < 5010; seq_id += 2) {
+        result_ids.push_back(seq_id);
+    }
+
+    facet a_facet("brand", 0);
+    std::map<std::string, docid_count_t> found;
+    ASSERT_EQ(2, findex.estimate(a_facet, result_ids.data(), result_ids.size(), 10, found, false));
+
+    // large values are estimated
+    const auto& nike_count = found.at("nike");
+    ASSERT_LE(nike_count.count_lower, 2500);
+    ASSERT_GE(nike_count.count_upper, 2500);
+    ASSERT_LT(nike_count.count_lower, nike_count.count_upper);
+
+    // small values are counted exactly
+    ASSERT_EQ(5, found.at("adidas").count);
+    ASSERT_EQ(5, found.at("adidas").count_lower);
+    ASSERT_EQ(5, found.at("adidas").count_upper);
+
+    // only the top values are estimated
+    found.clear();
+    ASSERT_EQ(1, findex.estimate(a_facet, result_ids.data(), result_ids.size(), 1, found, false));
+    ASSERT_EQ(1, found.count("nike"));
+
+    // sketches follow removals
+    field brandf("brand", field_types::STRING, true);
+    nlohmann::json doc;
+    doc["brand"] = "nike";
+    for(uint32_t seq_id = 0; seq_id < 4900; seq_id++) {
+        findex.remove(doc, brandf, seq_id);
+    }
+
+    found.clear();
+    findex.estimate(a_facet, result_ids.data(), result_ids.size(), 10, found, false);
+    ASSERT_EQ(50, found.at("nike").count);
+    ASSERT_EQ(50, found.at("nike").count_upper);
+}
@@ -771,6 +771,27 @@ TEST_F(PostingListTest, ResultsAndOffsetsBasics) {
     */
 }
 
+TEST_F(PostingListTest, NumTokenPositions) {
+    // plain field: token at positions 1 and 4, and is also the last token of the field
+    std::vector<uint32_t> offsets1 = {1, 4, 0};
+    ASSERT_EQ(2, posting_list_t::count_token_positions(offsets1.data(), offsets1.size(), false));
+
+    // array field: [1, 3] on array index 0, [2] on array index 2 where it is the last token
+    std::vector<uint32_t> offsets2 = {1, 3, 3, 0, 2, 2, 2, 0};
+    ASSERT_EQ(3, posting_list_t::count_token_positions(offsets2.data(), offsets2.size(), true));
+
+    ASSERT_EQ(0, posting_list_t::count_token_positions(nullptr, 0, true));
+
+    posting_list_t list(2);
+    list.upsert(0, offsets1);
+    list.upsert(5, offsets2);
+
+    auto it = list.new_iterator();
+    ASSERT_EQ(2, posting_list_t::get_num_positions(it, false));
+    it.next();
+    ASSERT_EQ(3, posting_list_t::get_num_positions(it, true));
+}
+
 TEST_F(PostingListTest, IntersectionSkipBlocks) {
     std::vector<uint32_t> offsets = {0, 1, 3};
     std::vector<posting_list_t*> lists;
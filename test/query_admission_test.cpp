@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include "query_admission.h"
+
+class QueryAdmissionTest : public ::testing::Test {
+protected:
+    virtual void TearDown() {
+        QueryAdmission::get_instance().init(0);
+    }
+};
+
+TEST_F(QueryAdmissionTest, EstimateCost) {
+    ASSERT_EQ(1000 + 10 * QueryAdmission::HIT_COST, QueryAdmission::estimate_cost(1000, 0, false, 10));
+
+    // every facet and the grouping add a pass over the candidates
+    ASSERT_EQ(4000 + 250 * QueryAdmission::HIT_COST, QueryAdmission::estimate_cost(1000, 2, true, 250));
+}
+
+TEST_F(QueryAdmissionTest, AdmitWithinBudgetAndShed) {
+    auto& admission = QueryAdmission::get_instance();
+
+    // disabled
+    auto admit_op = admission.admit("key1", 1000);
+    ASSERT_TRUE(admit_op.ok());
+    ASSERT_EQ(0, admit_op.get());
+    ASSERT_EQ(0, admission.get_inflight_cost());
+
+    admission.init(100, 100);
+
+    nlohmann::json metrics;
+    admission.get_metrics(metrics);
+    const auto num_shed = std::stoull(metrics["typesense_query_admission_shed_searches"].get<std::string>());
+
+    admit_op = admission.admit("key1", 60);
+    ASSERT_TRUE(admit_op.ok());
+    ASSERT_EQ(60, admit_op.get());
+
+    // does not fit in the budget before the queue timeout
+    admit_op = admission.admit("key2", 60);
+    ASSERT_FALSE(admit_op.ok());
+    ASSERT_EQ(503, admit_op.code());
+    ASSERT_EQ(60, admission.get_inflight_cost());
+
+    // shed searches are counted in the metrics instead of being logged
+    admission.get_metrics(metrics);
+    ASSERT_EQ(num_shed + 1, std::stoull(metrics["typesense_query_admission_shed_searches"].get<std::string>()));
+    ASSERT_EQ("60", metrics["typesense_query_admission_inflight_cost"].get<std::string>());
+
+    admission.release("key1", 60);
+    ASSERT_EQ(0, admission.get_inflight_cost());
+
+    // a search costlier than the budget runs alone
+    admit_op = admission.admit("key2", 500);
+    ASSERT_TRUE(admit_op.ok());
+    ASSERT_EQ(100, admit_op.get());
+
+    admission.release("key2", 100);
+    ASSERT_EQ(0, admission.get_inflight_cost());
+}
+
+TEST_F(QueryAdmissionTest, QueuedSearchesAreAdmittedFairly) {
+    auto& admission = QueryAdmission::get_instance();
+    admission.init(100, 5000);
+
+    ASSERT_TRUE(admission.admit("heavy", 30).ok());
+    ASSERT_TRUE(admission.admit("heavy", 30).ok());
+
+    std::atomic<bool> heavy_admitted = false;
+    std::atomic<bool> light_admitted = false;
+
+    std::thread heavy_thread([&]() {
+        heavy_admitted = admission.admit("heavy", 50).ok();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::thread light_thread([&]() {
+        light_admitted = admission.admit("light", 50).ok();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // an API key can't queue more than the whole budget
+    auto admit_op = admission.admit("heavy", 60);
+    ASSERT_FALSE(admit_op.ok());
+    ASSERT_EQ(429, admit_op.code());
+
+    // the light key has nothing in flight, so it goes ahead of the heavy search that arrived earlier
+    admission.release("heavy", 30);
+    light_thread.join();
+
+    ASSERT_TRUE(light_admitted);
+    ASSERT_FALSE(heavy_admitted);
+    ASSERT_EQ(80, admission.get_inflight_cost());
+
+    admission.release("heavy", 30);
+    heavy_thread.join();
+
+    ASSERT_TRUE(heavy_admitted);
+    ASSERT_EQ(100, admission.get_inflight_cost());
+
+    admission.release("light", 50);
+    admission.release("heavy", 50);
+    ASSERT_EQ(0, admission.get_inflight_cost());
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "query_embedding_cache.h"
+
+class QueryEmbeddingCacheTest : public ::testing::Test {
+protected:
+    virtual void TearDown() {
+        QueryEmbeddingCache::get_instance().clear();
+        QueryEmbeddingCache::get_instance().init(0);
+    }
+};
+
+TEST_F(QueryEmbeddingCacheTest, KeyNormalizesWhitespace) {
+    ASSERT_EQ(QueryEmbeddingCache::get_key("ts/e5-small", "query: red shoes"),
+              QueryEmbeddingCache::get_key("ts/e5-small", "  query:  red \t shoes \n"));
+
+    ASSERT_NE(QueryEmbeddingCache::get_key("ts/e5-small", "red shoes"),
+              QueryEmbeddingCache::get_key("ts/e5-small", "Red shoes"));
+
+    ASSERT_NE(QueryEmbeddingCache::get_key("ts/e5-small", "red shoes"),
+              QueryEmbeddingCache::get_key("ts/all-MiniLM-L12-v2", "red shoes"));
+}
+
+TEST_F(QueryEmbeddingCacheTest, EvictsLeastRecentlyUsedByBytes) {
+    auto& cache = QueryEmbeddingCache::get_instance();
+    std::vector<float> embedding(256, 0.5);
+    std::vector<float> cached_embedding;
+
+    // disabled
+    cache.put("model\x1f" "a", embedding);
+    ASSERT_FALSE(cache.get("model\x1f" "a", cached_embedding));
+
+    // room for 2 entries, but not 3
+    cache.init(2 * (embedding.size() * sizeof(float) + 200));
+
+    nlohmann::json metrics;
+    cache.get_metrics(metrics);
+    const size_t prev_hits = std::stoul(metrics["typesense_query_embedding_cache_hits"].get<std::string>());
+    const size_t prev_misses = std::stoul(metrics["typesense_query_embedding_cache_misses"].get<std::string>());
+
+    cache.put("model\x1f" "a", embedding);
+    cache.put("model\x1f" "b", embedding);
+    ASSERT_TRUE(cache.get("model\x1f" "a", cached_embedding));
+    ASSERT_EQ(embedding, cached_embedding);
+
+    cache.put("model\x1f" "c", embedding);
+
+    // `b` was the least recently used
+    ASSERT_FALSE(cache.get("model\x1f" "b", cached_embedding));
+    ASSERT_TRUE(cache.get("model\x1f" "a", cached_embedding));
+    ASSERT_TRUE(cache.get("model\x1f" "c", cached_embedding));
+    ASSERT_LE(cache.get_size_bytes(), 2 * (embedding.size() * sizeof(float) + 200));
+
+    cache.get_metrics(metrics);
+    ASSERT_EQ("2", metrics["typesense_query_embedding_cache_entries"].get<std::string>());
+    ASSERT_EQ(prev_hits + 3, std::stoul(metrics["typesense_query_embedding_cache_hits"].get<std::string>()));
+    ASSERT_EQ(prev_misses + 1, std::stoul(metrics["typesense_query_embedding_cache_misses"].get<std::string>()));
+}
+
+TEST_F(QueryEmbeddingCacheTest, RemoveModel) {
+    auto& cache = QueryEmbeddingCache::get_instance();
+    cache.init(1024 * 1024);
+
+    std::vector<float> embedding(8, 0.5);
+    std::vector<float> cached_embedding;
+
+    cache.put(QueryEmbeddingCache::get_key("model", "a"), embedding);
+    cache.put(QueryEmbeddingCache::get_key("model2", "a"), embedding);
+
+    cache.remove_model("model");
+
+    ASSERT_FALSE(cache.get(QueryEmbeddingCache::get_key("model", "a"), cached_embedding));
+    ASSERT_TRUE(cache.get(QueryEmbeddingCache::get_key("model2", "a"), cached_embedding));
+}
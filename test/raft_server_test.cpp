@@ -16,4 +16,41 @@ TEST(RaftServerTest, ResolveNodesConfigWithHostNames) {
     ASSERT_EQ("",
               ReplicationState::resolve_node_hosts("typesense-node-2.typesense-service.typesense-"
                                                    "namespace.svc.cluster.local:6107:6108"));
-}
\ No newline at end of file
+}
+
+TEST(RaftServerTest, BoundedStalenessReadParams) {
+    ASSERT_FALSE(ReplicationState::is_bounded_staleness_read({}));
+    ASSERT_FALSE(ReplicationState::is_bounded_staleness_read({{"q", "*"}, {ReplicationState::READ_WAIT_MS, "100"}}));
+    ASSERT_TRUE(ReplicationState::is_bounded_staleness_read({{ReplicationState::READ_MIN_INDEX, "42"}}));
+    ASSERT_TRUE(ReplicationState::is_bounded_staleness_read({{ReplicationState::READ_MAX_LAG, "0"}}));
+}
+
+TEST(RaftServerTest, SerializeWriteBatch) {
+    req_res_batch_t req_res_batch;
+
+    for(size_t i = 0; i < 3; i++) {
+        auto req = std::make_shared<http_req>();
+        req->route_hash = 100;
+        req->start_ts = 1000 + i;
+        req->params["collection"] = "coll1";
+        req->body = R"({"id": ")" + std::to_string(i) + R"(", "title": "Title\nwith \"quotes\""})";
+        req->last_chunk_aggregate = true;
+        req_res_batch.emplace_back(req, std::make_shared<http_res>(nullptr));
+    }
+
+    const std::string& log_data = ReplicationState::serialize_write_batch(req_res_batch);
+    ASSERT_TRUE(ReplicationState::is_write_batch(log_data));
+    ASSERT_FALSE(ReplicationState::is_write_batch(req_res_batch[0].first->to_json()));
+    ASSERT_FALSE(ReplicationState::is_write_batch(""));
+
+    auto requests = ReplicationState::deserialize_write_batch(log_data);
+    ASSERT_EQ(3, requests.size());
+
+    for(size_t i = 0; i < 3; i++) {
+        ASSERT_EQ(100, requests[i]->route_hash);
+        ASSERT_EQ(1000 + i, requests[i]->start_ts);
+        ASSERT_EQ("coll1", requests[i]->params["collection"]);
+        ASSERT_EQ(req_res_batch[i].first->body, requests[i]->body);
+        ASSERT_TRUE(requests[i]->last_chunk_aggregate);
+    }
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+#include "reference_join.h"
+
+TEST(ReferenceJoinTest, GroupingStrategiesProduceTheSameResult) {
+    std::mt19937 gen(137723);
+
+    for (uint32_t max_doc_id: {10u, 1000u, 1000000u}) {
+        ReferenceJoin counting_join, comparison_join;
+        std::map<uint32_t, std::vector<uint32_t>> expected_references;
+
+        for (uint32_t reference_doc_id = 0; reference_doc_id < 500; reference_doc_id++) {
+            auto const num_docs = gen() % 3;
+            for (uint32_t i = 0; i < num_docs; i++) {
+                auto const doc_id = gen() % max_doc_id;
+                counting_join.add(doc_id, reference_doc_id);
+                comparison_join.add(doc_id, reference_doc_id);
+                expected_references[doc_id].push_back(reference_doc_id);
+            }
+        }
+
+        counting_join.group_by_doc(ReferenceJoin::counting_sort);
+        comparison_join.group_by_doc(ReferenceJoin::comparison_sort);
+
+        for (auto join: {&counting_join, &comparison_join}) {
+            filter_result_t filter_result;
+            join->to_filter_result("Products", false, filter_result);
+
+            ASSERT_EQ(expected_references.size(), filter_result.count);
+
+            uint32_t result_index = 0;
+            for (auto const& expected: expected_references) {
+                ASSERT_EQ(expected.first, filter_result.docs[result_index]);
+
+                std::map<std::string, reference_filter_result_t> coll_to_references;
+                filter_result.get_references(result_index, coll_to_references);
+                auto const& references = coll_to_references.at("Products");
+                ASSERT_FALSE(references.is_reference_array_field);
+                ASSERT_EQ(expected.second, std::vector<uint32_t>(references.docs, references.docs + references.count));
+                result_index++;
+            }
+        }
+    }
+}
+
+TEST(ReferenceJoinTest, JoinedDocIds) {
+    ReferenceJoin join;
+    join.add(7, 0);
+    join.add(3, 1);
+    join.add(7, 2);
+    join.add(5, 3);
+
+    std::vector<uint32_t> doc_ids;
+    join.get_doc_ids(doc_ids);
+    ASSERT_EQ(std::vector<uint32_t>({3, 5, 7}), doc_ids);
+
+    filter_result_t filter_result;
+    join.to_filter_result("Users", true, filter_result);
+    ASSERT_EQ(3, filter_result.count);
+
+    std::map<std::string, reference_filter_result_t> coll_to_references;
+    filter_result.get_references(2, coll_to_references);
+    auto const& references = coll_to_references.at("Users");
+    ASSERT_TRUE(references.is_reference_array_field);
+    ASSERT_EQ(2, references.count);
+    ASSERT_EQ(0, references.docs[0]);
+    ASSERT_EQ(2, references.docs[1]);
+}
+
+TEST(ReferenceJoinTest, ReferencesAreAttachedOnlyWhenRead) {
+    ReferenceJoin join;
+    join.add(3, 0);
+    join.add(5, 1);
+    join.add(3, 2);
+    join.add(8, 3);
+
+    filter_result_t filter_result;
+    join.to_filter_result("Users", false, filter_result);
+    ASSERT_EQ(3, filter_result.count);
+    ASSERT_EQ(nullptr, filter_result.coll_to_references);
+    ASSERT_TRUE(filter_result.has_references());
+    ASSERT_EQ(std::vector<uint32_t>({0, 2, 3, 4}), filter_result.reference_offsets);
+    ASSERT_EQ(std::vector<uint32_t>({0, 2, 1, 3}), filter_result.reference_docs);
+
+    // a slice of the result keeps the references flat
+    filter_result_t slice;
+    slice.append_references(filter_result, 2);
+    slice.append_references(filter_result, 0);
+    ASSERT_EQ(nullptr, slice.coll_to_references);
+    ASSERT_EQ(std::vector<uint32_t>({0, 1, 3}), slice.reference_offsets);
+    ASSERT_EQ(std::vector<uint32_t>({3, 0, 2}), slice.reference_docs);
+
+    // the references of the docs that are combined with another result are attached to them
+    uint32_t* ids = new uint32_t[2]{3, 8};
+    filter_result_t other(2, ids);
+    filter_result_t result;
+    filter_result_t::and_filter_results(filter_result, other, result);
+    ASSERT_EQ(2, result.count);
+    ASSERT_NE(nullptr, result.coll_to_references);
+    ASSERT_EQ(2, result.coll_to_references[0].at("Users").count);
+    ASSERT_EQ(1, result.coll_to_references[1].at("Users").count);
+    ASSERT_EQ(3, result.coll_to_references[1].at("Users").docs[0]);
+
+    // a copy keeps them flat
+    filter_result_t copy(filter_result);
+    ASSERT_EQ(nullptr, copy.coll_to_references);
+    ASSERT_EQ(filter_result.reference_docs, copy.reference_docs);
+
+    std::map<std::string, reference_filter_result_t> coll_to_references;
+    copy.get_references(1, coll_to_references);
+    ASSERT_EQ(1, coll_to_references.at("Users").count);
+    ASSERT_EQ(1, coll_to_references.at("Users").docs[0]);
+}
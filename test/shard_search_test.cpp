@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include "collection_manager.h"
+#include "shard_search.h"
+
+static nlohmann::json make_hit(const std::string& id, int32_t points, uint64_t text_match) {
+    nlohmann::json hit;
+    hit["document"]["id"] = id;
+    hit["document"]["points"] = points;
+    hit["text_match"] = text_match;
+    return hit;
+}
+
+TEST(ShardSearchTest, MergeHitsInSortOrder) {
+    std::vector<nlohmann::json> shard_results(2);
+
+    shard_results[0]["found"] = 3;
+    shard_results[0]["out_of"] = 10;
+    shard_results[0]["hits"].push_back(make_hit("a", 100, 578730123365187705));
+    shard_results[0]["hits"].push_back(make_hit("b", 50, 578730123365187704));
+    shard_results[0]["hits"].push_back(make_hit("c", 10, 100));
+
+    shard_results[1]["found"] = 2;
+    shard_results[1]["out_of"] = 20;
+    shard_results[1]["hits"].push_back(make_hit("d", 70, 578730123365187705));
+    shard_results[1]["hits"].push_back(make_hit("e", 60, 100));
+
+    // text match scores that differ only beyond the precision of a double must still be ordered
+    std::vector<sort_by> sort_fields = {sort_by(sort_field_const::text_match, sort_field_const::desc),
+                                        sort_by("points", sort_field_const::desc)};
+
+    nlohmann::json merged;
+    ShardSearch::merge_results(shard_results, sort_fields, 0, 10, 10, merged);
+
+    ASSERT_EQ(5, merged["found"].get<size_t>());
+    ASSERT_EQ(30, merged["out_of"].get<size_t>());
+    ASSERT_EQ(5, merged["hits"].size());
+
+    std::vector<std::string> ids;
+    for(const auto& hit: merged["hits"]) {
+        ids.push_back(hit["document"]["id"]);
+    }
+
+    ASSERT_EQ(std::vector<std::string>({"a", "d", "b", "e", "c"}), ids);
+
+    // global pagination
+    sort_fields = {sort_by("points", sort_field_const::asc)};
+    ShardSearch::merge_results(shard_results, sort_fields, 2, 2, 10, merged);
+
+    ASSERT_EQ(2, merged["hits"].size());
+    ASSERT_EQ("e", merged["hits"][0]["document"]["id"]);
+    ASSERT_EQ("d", merged["hits"][1]["document"]["id"]);
+
+    ShardSearch::merge_results(shard_results, sort_fields, 6, 2, 10, merged);
+    ASSERT_EQ(0, merged["hits"].size());
+}
+
+TEST(ShardSearchTest, MergeFacetCounts) {
+    std::vector<nlohmann::json> shard_results(2);
+
+    shard_results[0]["found"] = 5;
+    shard_results[0]["facet_counts"] = R"([{
+        "field_name": "brand",
+        "counts": [{"value": "acme", "count": 3}, {"value": "zeta", "count": 2}],
+        "stats": {"total_values": 2}
+    }, {
+        "field_name": "price",
+        "counts": [{"value": "10", "count": 5}],
+        "stats": {"min": 10, "max": 10, "sum": 50, "avg": 10}
+    }])"_json;
+
+    shard_results[1]["found"] = 6;
+    shard_results[1]["facet_counts"] = R"([{
+        "field_name": "price",
+        "counts": [{"value": "10", "count": 1}, {"value": "30", "count": 5}],
+        "stats": {"min": 10, "max": 30, "sum": 160, "avg": 26.67}
+    }, {
+        "field_name": "brand",
+        "counts": [{"value": "zeta", "count": 4}, {"value": "omega", "count": 2}],
+        "stats": {"total_values": 2}
+    }])"_json;
+
+    nlohmann::json merged;
+    ShardSearch::merge_results(shard_results, {}, 0, 10, 2, merged);
+
+    ASSERT_EQ(11, merged["found"].get<size_t>());
+    ASSERT_EQ(2, merged["facet_counts"].size());
+
+    // facets keep the order of the first shard, and values are truncated to `max_facet_values`
+    const auto& brand = merged["facet_counts"][0];
+    ASSERT_EQ("brand", brand["field_name"]);
+    ASSERT_EQ(2, brand["counts"].size());
+    ASSERT_EQ("zeta", brand["counts"][0]["value"]);
+    ASSERT_EQ(6, brand["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ("acme", brand["counts"][1]["value"]);
+    ASSERT_EQ(3, brand["counts"][1]["count"].get<size_t>());
+    ASSERT_EQ(0, brand["stats"].count("total_values"));
+
+    const auto& price = merged["facet_counts"][1];
+    ASSERT_EQ("10", price["counts"][0]["value"]);
+    ASSERT_EQ(6, price["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ(10, price["stats"]["min"].get<double>());
+    ASSERT_EQ(30, price["stats"]["max"].get<double>());
+    ASSERT_EQ(210, price["stats"]["sum"].get<double>());
+    ASSERT_EQ(0, price["stats"].count("avg"));
+}
+
+TEST(ShardSearchTest, FetchDeepHitsOverSeveralPages) {
+    std::map<std::string, std::string> shard_params = {{"collection", "coll1"}, {"q", "*"}};
+    std::vector<std::pair<size_t, size_t>> requested_pages;
+    const size_t num_shard_hits = 600;
+
+    auto search_page = [&](std::map<std::string, std::string>& page_params, nlohmann::json& page_result) {
+        const size_t page = std::stoul(page_params["page"]);
+        const size_t per_page = std::stoul(page_params["per_page"]);
+        requested_pages.emplace_back(page, per_page);
+
+        page_result["found"] = num_shard_hits;
+        page_result["hits"] = nlohmann::json::array();
+        for(size_t i = (page - 1) * per_page; i < page * per_page && i < num_shard_hits; i++) {
+            page_result["hits"].push_back(make_hit(std::to_string(i), i, 0));
+        }
+
+        return Option<bool>(true);
+    };
+
+    nlohmann::json result;
+    ASSERT_TRUE(ShardSearch::fetch_shard_hits(shard_params, 520, search_page, result).ok());
+
+    // no page is larger than `max-per-page`
+    ASSERT_EQ(std::vector<std::pair<size_t, size_t>>({{1, 250}, {2, 250}, {3, 250}}), requested_pages);
+    ASSERT_EQ(600, result["found"].get<size_t>());
+    ASSERT_EQ(600, result["hits"].size());
+    for(size_t i = 0; i < result["hits"].size(); i++) {
+        ASSERT_EQ(std::to_string(i), result["hits"][i]["document"]["id"]);
+    }
+
+    // stops once the shard runs out of hits
+    requested_pages.clear();
+    ASSERT_TRUE(ShardSearch::fetch_shard_hits(shard_params, 2000, search_page, result).ok());
+    ASSERT_EQ(3, requested_pages.size());
+    ASSERT_EQ(600, result["hits"].size());
+
+    requested_pages.clear();
+    ASSERT_TRUE(ShardSearch::fetch_shard_hits(shard_params, 30, search_page, result).ok());
+    ASSERT_EQ(std::vector<std::pair<size_t, size_t>>({{1, 30}}), requested_pages);
+    ASSERT_EQ(30, result["hits"].size());
+}
+
+TEST(ShardSearchTest, FetchDepthIsCapped) {
+    ASSERT_EQ(10, ShardSearch::get_fetch_depth(0, 10, 1000000).get());
+
+    // no shard is asked for more than `limit_hits`
+    ASSERT_EQ(100, ShardSearch::get_fetch_depth(520, 50, 100).get());
+
+    // deeper than `shard-search-max-hits`
+    auto depth_op = ShardSearch::get_fetch_depth(9990, 20, 1000000);
+    ASSERT_FALSE(depth_op.ok());
+    ASSERT_EQ(422, depth_op.code());
+    ASSERT_EQ("Only upto 10000 hits can be fetched in a search across shards.", depth_op.error());
+}
+
+class ShardSearchRequestTest : public ::testing::Test {
+protected:
+    Store *store;
+    CollectionManager & collectionManager = CollectionManager::get_instance();
+    std::atomic<bool> quit = false;
+
+    virtual void SetUp() {
+        std::string state_dir_path = "/tmp/typesense_test/shard_search";
+        LOG(INFO) << "Truncating and creating: " << state_dir_path;
+        system(("rm -rf "+state_dir_path+" && mkdir -p "+state_dir_path).c_str());
+
+        store = new Store(state_dir_path);
+        collectionManager.init(store, 1.0, "auth_key", quit);
+        collectionManager.load(8, 1000);
+    }
+
+    virtual void TearDown() {
+        collectionManager.dispose();
+        delete store;
+    }
+};
+
+TEST_F(ShardSearchRequestTest, DeepPageOfLocalShard) {
+    std::vector<field> fields = {
+        field("title", field_types::STRING, false),
+        field("points", field_types::INT32, false)
+    };
+
+    Collection* coll1 = collectionManager.create_collection("coll1", 1, fields, "points").get();
+
+    for(size_t i = 0; i < 600; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["points"] = i;
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    // hits 300 to 399 need a depth beyond `max-per-page` from the shard
+    std::map<std::string, std::string> req_params = {
+        {"collection", "coll1"},
+        {"q", "*"},
+        {"per_page", "100"},
+        {"page", "4"}
+    };
+
+    nlohmann::json embedded_params;
+    std::string json_res;
+    auto now_ts = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+    auto search_op = ShardSearch::search(req_params, embedded_params, "auth_key", json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+
+    nlohmann::json res = nlohmann::json::parse(json_res);
+    ASSERT_EQ(600, res["found"].get<size_t>());
+    ASSERT_EQ(4, res["page"].get<size_t>());
+    ASSERT_EQ(100, res["hits"].size());
+    ASSERT_EQ("299", res["hits"][0]["document"]["id"]);
+    ASSERT_EQ("200", res["hits"][99]["document"]["id"]);
+
+    // the same page through an offset
+    req_params = {
+        {"collection", "coll1"},
+        {"q", "*"},
+        {"offset", "520"},
+        {"limit", "50"}
+    };
+
+    search_op = ShardSearch::search(req_params, embedded_params, "auth_key", json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+
+    res = nlohmann::json::parse(json_res);
+    ASSERT_EQ(520, res["offset"].get<size_t>());
+    ASSERT_EQ(50, res["hits"].size());
+    ASSERT_EQ("79", res["hits"][0]["document"]["id"]);
+    ASSERT_EQ("30", res["hits"][49]["document"]["id"]);
+}
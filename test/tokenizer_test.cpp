@@ -414,3 +414,46 @@ TEST(TokenizerTest, ShouldTokenizeWithDifferentSymbolConfigs) {
     ASSERT_EQ(1, tokens.size());
     ASSERT_EQ("ความเห", tokens[0]);
 }
+
+TEST(TokenizerTest, ShouldSkipTokens) {
+    const std::string text = "The quick -- brown, fox “jumps” over the lazy dog";
+
+    std::vector<std::string> tokens;
+    std::vector<size_t> start_indices;
+    std::string token;
+    size_t token_index, start_index, end_index;
+
+    Tokenizer tokenizer(text, true, false, "", {}, {','});
+    while(tokenizer.next(token, token_index, start_index, end_index)) {
+        tokens.push_back(token);
+        start_indices.push_back(start_index);
+    }
+
+    ASSERT_EQ(9, tokens.size());
+
+    for(size_t num_tokens = 0; num_tokens <= tokens.size(); num_tokens++) {
+        Tokenizer skip_tokenizer(text, true, false, "", {}, {','});
+        size_t num_skipped = skip_tokenizer.skip_tokens(num_tokens);
+        ASSERT_LE(num_skipped, num_tokens);
+
+        for(size_t i = num_skipped; i < tokens.size(); i++) {
+            ASSERT_TRUE(skip_tokenizer.next(token, token_index, start_index, end_index));
+            ASSERT_EQ(tokens[i], token);
+            ASSERT_EQ(i, token_index);
+            ASSERT_EQ(start_indices[i], start_index);
+        }
+
+        ASSERT_FALSE(skip_tokenizer.next(token, token_index, start_index, end_index));
+    }
+
+    // stops at a segment of unicode symbols that can't be told to be a token without normalizing them
+    Tokenizer skip_tokenizer("foo — bar baz", true, false, "", {}, {});
+    ASSERT_EQ(1, skip_tokenizer.skip_tokens(2));
+    ASSERT_TRUE(skip_tokenizer.next(token, token_index, start_index, end_index));
+    ASSERT_EQ("bar", token);
+    ASSERT_EQ(1, token_index);
+
+    // not supported with a locale specific segmenter
+    Tokenizer locale_tokenizer("foo bar baz", true, false, "th", {}, {});
+    ASSERT_EQ(0, locale_tokenizer.skip_tokens(2));
+}
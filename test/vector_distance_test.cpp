@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "hnswlib/hnswlib.h"
+#include "vector_distance.h"
+
+TEST(VectorDistanceTest, BlockDistancesMatchIndexDistances) {
+    std::mt19937 gen(137723);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+
+    std::vector<size_t> dims = {384, 768};
+    for(size_t dim = 1; dim <= 40; dim++) {
+        dims.push_back(dim);
+    }
+
+    for(size_t dim: dims) {
+        hnswlib::InnerProductSpace space(dim);
+        auto dist_func = space.get_dist_func();
+
+        std::vector<float> query(dim);
+        for(auto& value: query) {
+            value = dis(gen);
+        }
+
+        std::vector<std::vector<float>> vectors(VectorDistance::BLOCK_SIZE, std::vector<float>(dim));
+        std::vector<float> block(dim * VectorDistance::BLOCK_SIZE);
+
+        for(size_t lane = 0; lane < VectorDistance::BLOCK_SIZE; lane++) {
+            for(auto& value: vectors[lane]) {
+                value = dis(gen);
+            }
+            VectorDistance::set_block_vector(block.data(), dim, lane, vectors[lane].data());
+        }
+
+        for(int kernel = VectorDistance::scalar; kernel <= VectorDistance::get_supported_kernel(); kernel++) {
+            float distances[VectorDistance::BLOCK_SIZE];
+            VectorDistance::inner_product_distances(VectorDistance::kernel_t(kernel), query.data(), block.data(),
+                                                    dim, distances);
+
+            for(size_t lane = 0; lane < VectorDistance::BLOCK_SIZE; lane++) {
+                // must be bit-identical, so that a scan and a graph search agree on the distances
+                ASSERT_EQ(dist_func(query.data(), vectors[lane].data(), &dim), distances[lane])
+                                            << "dim: " << dim << ", kernel: " << kernel << ", lane: " << lane;
+            }
+        }
+    }
+}